@@ -0,0 +1,152 @@
+/**
+ * @file bench_batch.c
+ * @author Mohamed ashraf (wx@wx.com)
+ * @brief multi-buffer encryption micro benchmark
+ * @version 0.1
+ * @date 2023-01-01
+ * 
+ * @copyright Copyright (c) Wx 2023
+ * 
+ * @attention
+ *      Reports the public key operations per second of a batch of messages,
+ *      one exponentiation per message with e = 65537, through the scalar
+ *      engine and through the multi-buffer lanes.
+ * 
+ */
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "rsa_cfg.h"
+#include "rsa_prv.h"
+#include "rsa_bn.h"
+#include "rsa_mb.h"
+
+/*
+*--------------------------------------------------------------------------------------
+*- Macros
+*--------------------------------------------------------------------------------------
+**/
+
+#define BENCH_NUM_OF_SIZES 				(0x03u)
+#define BENCH_NUM_OF_BATCHES 			(0x06u)
+#define BENCH_MAX_BATCH 					(0x100u)
+#define BENCH_MIN_MESSAGES 				(0x400u)
+
+/*
+*--------------------------------------------------------------------------------------
+*- Data types
+*--------------------------------------------------------------------------------------
+**/
+
+static st_rsa_bn_t messages[BENCH_MAX_BATCH];
+static st_rsa_bn_t ciphers[BENCH_MAX_BATCH + RSA_MB_LANES];
+
+/*
+*--------------------------------------------------------------------------------------
+*- Private Functions Implementation
+*--------------------------------------------------------------------------------------
+**/
+
+static double
+getTimeSeconds(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (double) ts.tv_sec + ((double) ts.tv_nsec * 1e-9);
+}/* getTimeSeconds */
+
+static double
+benchScalar(const st_rsa_bn_mont_t * const pMont, const st_rsa_bn_t * const pExp, const uint32_t batch)
+{
+	/* Function data types */
+	const uint32_t rounds = (BENCH_MIN_MESSAGES + batch - 0x01u) / batch;
+	uint32_t register r = 0x00u;
+	uint32_t register i = 0x00u;
+	double start = getTimeSeconds();
+
+	/* Function body */
+	for(r = 0x00u; r < rounds; ++r)
+	{
+		for(i = 0x00u; i < batch; ++i)
+		{ bnPowMod(pMont, &ciphers[i], &messages[i], pExp); }
+	}
+
+	return (double) (rounds * batch) / (getTimeSeconds() - start);
+}/* benchScalar */
+
+static double
+benchMultiBuffer(const st_rsa_mb_mont_t * const pMbMont, const st_rsa_bn_t * const pExp, const uint32_t batch)
+{
+	/* Function data types */
+	const uint32_t rounds = (BENCH_MIN_MESSAGES + batch - 0x01u) / batch;
+	uint32_t register r = 0x00u;
+	uint32_t register i = 0x00u;
+	double start = getTimeSeconds();
+
+	/* Function body */
+	for(r = 0x00u; r < rounds; ++r)
+	{
+		for(i = 0x00u; i < batch; i += RSA_MB_LANES)
+		{ mbPowMod(pMbMont, &ciphers[i], &messages[i], pExp); }
+	}
+
+	return (double) (rounds * batch) / (getTimeSeconds() - start);
+}/* benchMultiBuffer */
+
+/*
+*--------------------------------------------------------------------------------------
+*- Main
+*--------------------------------------------------------------------------------------
+**/
+
+int main(void)
+{
+	/* Function data types */
+	const uint32_t sizes[BENCH_NUM_OF_SIZES] = {1024u, 2048u, 4096u};
+	const uint32_t batches[BENCH_NUM_OF_BATCHES] = {1u, 4u, 16u, 64u, 128u, 256u};
+	st_rsa_bn_mont_t mont;
+	st_rsa_mb_mont_t mbMont;
+	st_rsa_bn_t n;
+	st_rsa_bn_t exp;
+	uint32_t register i = 0x00u;
+	uint32_t register j = 0x00u;
+
+	/* Function body */
+	if( (0x00u == mbIsAvailable()) )
+	{ printf("multi-buffer kernels not supported by this CPU, the batch API uses the scalar engine\n"); }
+	else;
+
+	bnFromWord(&exp, 65537u);
+
+	for(i = 0x00u; i < BENCH_NUM_OF_SIZES; ++i)
+	{
+		if( (sizes[i] > RSA_MAX_KEY_BITS) )
+		{ continue; }
+		else;
+
+		bnRandom(&n, sizes[i], RSA_BN_RAND_TOP_ONE | RSA_BN_RAND_ODD);
+		bnMontInit(&mont, &n);
+		mbMontInit(&mbMont, &mont);
+		for(j = 0x00u; j < BENCH_MAX_BATCH; ++j)
+		{ bnRandom(&messages[j], sizes[i] - 0x01u, RSA_BN_RAND_TOP_ANY); }
+
+		printf("modulus %u bits, e = 65537\n", sizes[i]);
+		for(j = 0x00u; j < BENCH_NUM_OF_BATCHES; ++j)
+		{
+			const double scalarRate = benchScalar(&mont, &exp, batches[j]);
+
+			if( (mbIsAvailable()) )
+			{
+				const double mbRate = benchMultiBuffer(&mbMont, &exp, batches[j]);
+				printf("  batch %4u | scalar %9.0f msg/s | %u lanes %9.0f msg/s | %.2fx\n",
+				       batches[j], scalarRate, RSA_MB_LANES, mbRate, mbRate / scalarRate);
+			}
+			else
+			{ printf("  batch %4u | scalar %9.0f msg/s\n", batches[j], scalarRate); }
+		}
+	}
+
+	return 0;
+}
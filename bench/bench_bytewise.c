@@ -0,0 +1,154 @@
+/**
+ * @file bench_bytewise.c
+ * @author Mohamed ashraf (wx@wx.com)
+ * @brief byte-wise format benchmark
+ * @version 0.1
+ * @date 2023-01-01
+ *
+ * @copyright Copyright (c) Wx 2023
+ *
+ * @attention
+ *      Reports the message bytes per second of rsa_ctx_encrypt() and
+ *      rsa_ctx_decrypt() of a single thread, one exponentiation per byte
+ *      against the byte table of rsa_ctx_enable_byte_table(), together with
+ *      the time taken to build the table.
+ *
+ */
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "rsa_cfg.h"
+#include "rsa_prv.h"
+#include "rsa_int.h"
+
+/*
+*--------------------------------------------------------------------------------------
+*- Macros
+*--------------------------------------------------------------------------------------
+**/
+
+#define BENCH_NUM_OF_SIZES 				(0x03u)
+#define BENCH_PLAIN_BYTES 				(0x40u)
+#define BENCH_TABLE_BYTES 				(0x1000u)
+#define BENCH_TABLE_ROUNDS 				(0x40u)
+
+/*
+*--------------------------------------------------------------------------------------
+*- Data types
+*--------------------------------------------------------------------------------------
+**/
+
+static uint8_t message[BENCH_TABLE_BYTES];
+static uint8_t plain[BENCH_TABLE_BYTES];
+static uint8_t cipher[BENCH_TABLE_BYTES * (RSA_MAX_KEY_BITS / 0x08u)];
+
+/*
+*--------------------------------------------------------------------------------------
+*- Private Functions Implementation
+*--------------------------------------------------------------------------------------
+**/
+
+static double
+getTimeSeconds(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (double) ts.tv_sec + ((double) ts.tv_nsec * 1e-9);
+}/* getTimeSeconds */
+
+/**
+ * @brief Encrypts then decrypts `len` bytes `rounds` times, the rates are
+ * 			  written in bytes per second. Returns 0 when a round trip fails.
+ */
+static uint8_t
+benchRoundTrip(const rsa_ctx_t * const pCtx, const uint64_t len, const uint32_t rounds,
+               double * const pEncRate, double * const pDecRate)
+{
+	/* Function data types */
+	uint32_t register r = 0x00u;
+	double start = getTimeSeconds();
+
+	/* Function body */
+	for(r = 0x00u; r < rounds; ++r)
+	{ (void) rsa_ctx_encrypt(pCtx, message, len, cipher); }
+	*pEncRate = (double) (rounds * len) / (getTimeSeconds() - start);
+
+	start = getTimeSeconds();
+	for(r = 0x00u; r < rounds; ++r)
+	{ (void) rsa_ctx_decrypt(pCtx, cipher, len, plain); }
+	*pDecRate = (double) (rounds * len) / (getTimeSeconds() - start);
+
+	return (0x00 == memcmp(message, plain, len)) ? (0x01u) : (0x00u);
+}/* benchRoundTrip */
+
+/*
+*--------------------------------------------------------------------------------------
+*- Main
+*--------------------------------------------------------------------------------------
+**/
+
+int main(void)
+{
+	/* Function data types */
+	const uint32_t sizes[BENCH_NUM_OF_SIZES] = {1024u, 2048u, 4096u};
+	rsa_ctx_t *pCtx = NULL;
+	double plainEnc = 0.0, plainDec = 0.0;
+	double tableEnc = 0.0, tableDec = 0.0;
+	double buildTime = 0.0;
+	uint32_t register i = 0x00u;
+
+	/* Function body */
+	for(i = 0x00u; i < BENCH_TABLE_BYTES; ++i)
+	{ message[i] = (uint8_t) rand(); }
+
+	for(i = 0x00u; i < BENCH_NUM_OF_SIZES; ++i)
+	{
+		if( (sizes[i] > RSA_MAX_KEY_BITS) )
+		{ continue; }
+		else;
+
+		pCtx = rsa_ctx_create();
+		if( (NULL == pCtx) || (rsaStatusOk != rsa_ctx_generate(pCtx, sizes[i])) )
+		{
+			printf("key generation failed\n");
+			return 1;
+		}
+		else;
+
+		if( (0x00u == benchRoundTrip(pCtx, BENCH_PLAIN_BYTES, 0x01u, &plainEnc, &plainDec)) )
+		{
+			printf("round trip failed\n");
+			return 1;
+		}
+		else;
+
+		buildTime = getTimeSeconds();
+		if( (rsaStatusOk != rsa_ctx_enable_byte_table(pCtx)) )
+		{
+			printf("byte table allocation failed\n");
+			return 1;
+		}
+		else;
+		buildTime = getTimeSeconds() - buildTime;
+
+		if( (0x00u == benchRoundTrip(pCtx, BENCH_TABLE_BYTES, BENCH_TABLE_ROUNDS, &tableEnc, &tableDec)) )
+		{
+			printf("round trip failed\n");
+			return 1;
+		}
+		else;
+
+		printf("modulus %u bits, e = 65537, table built in %.1f ms\n", sizes[i], buildTime * 1e3);
+		printf("  encrypt | exponentiation %11.0f B/s | table %11.0f B/s | %.0fx\n",
+		       plainEnc, tableEnc, tableEnc / plainEnc);
+		printf("  decrypt | exponentiation %11.0f B/s | table %11.0f B/s | %.0fx\n",
+		       plainDec, tableDec, tableDec / plainDec);
+
+		rsa_ctx_destroy(pCtx);
+	}
+
+	return 0;
+}
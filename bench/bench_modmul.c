@@ -0,0 +1,123 @@
+/**
+ * @file bench_modmul.c
+ * @author Mohamed ashraf (wx@wx.com)
+ * @brief modular multiplication micro benchmark
+ * @version 0.1
+ * @date 2023-01-01
+ * 
+ * @copyright Copyright (c) Wx 2023
+ * 
+ * @attention
+ *      Compares the legacy bit-serial `mulMod` against the montgomery kernels,
+ *      both run a dependent chain of multiplications over the same moduli.
+ * 
+ */
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "rsa_cfg.h"
+#include "rsa_prv.h"
+#include "rsa_mont.h"
+
+/*
+*--------------------------------------------------------------------------------------
+*- Macros
+*--------------------------------------------------------------------------------------
+**/
+
+#define BENCH_NUM_OF_MODULI 		(0x10u)
+#define BENCH_SERIAL_ITERATIONS 	(0x100000u)
+#define BENCH_MONT_ITERATIONS 		(0x4000000u)
+
+/*
+*--------------------------------------------------------------------------------------
+*- Private Functions Implementation
+*--------------------------------------------------------------------------------------
+**/
+
+/**
+ * @brief The original shift-and-add multiplication, kept as the baseline.
+ */
+static uint64_t 
+serialMulMod(uint64_t a, uint64_t b, const uint64_t mod)
+{
+	uint64_t res = 0, c;
+	for (b %= mod; a; a & 1 ? b >= mod - res ? res -= mod : 0, res += b : 0, a >>= 1, (c = b) >= mod - b ? c -= mod : 0, b += c);
+	return res % mod;
+}/* serialMulMod */
+
+static double
+getTimeSeconds(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (double) ts.tv_sec + ((double) ts.tv_nsec * 1e-9);
+}/* getTimeSeconds */
+
+static uint64_t
+getRandom64(uint64_t * const pState)
+{
+	/* splitmix64 */
+	uint64_t z = (*pState += 0x9E3779B97F4A7C15u);
+	z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9u;
+	z = (z ^ (z >> 27)) * 0x94D049BB133111EBu;
+	return z ^ (z >> 31);
+}/* getRandom64 */
+
+/*
+*--------------------------------------------------------------------------------------
+*- Main
+*--------------------------------------------------------------------------------------
+**/
+
+int main(void)
+{
+	/* Function data types */
+	uint64_t seed = 0x5EEDu;
+	uint64_t moduli[BENCH_NUM_OF_MODULI];
+	volatile uint64_t sink = 0x00u;
+	uint64_t register i = 0x00u;
+	uint64_t register k = 0x00u;
+	double start = 0.0, serialRate = 0.0, montRate = 0.0;
+
+	/* Function body */
+	for(i = 0x00u; i < BENCH_NUM_OF_MODULI; ++i)
+	{ moduli[i] = getRandom64(&seed) | 0x8000000000000001u; }
+
+	/* Baseline: bit-serial multiplication */
+	start = getTimeSeconds();
+	for(i = 0x00u; i < BENCH_NUM_OF_MODULI; ++i)
+	{
+		uint64_t x = getRandom64(&seed) % moduli[i];
+		uint64_t y = getRandom64(&seed) % moduli[i];
+
+		for(k = 0x00u; k < BENCH_SERIAL_ITERATIONS; ++k)
+		{ x = serialMulMod(x, y, moduli[i]); }
+		sink ^= x;
+	}
+	serialRate = (BENCH_NUM_OF_MODULI * (double) BENCH_SERIAL_ITERATIONS) / (getTimeSeconds() - start);
+
+	/* Montgomery: context setup is included in the measurement */
+	start = getTimeSeconds();
+	for(i = 0x00u; i < BENCH_NUM_OF_MODULI; ++i)
+	{
+		st_rsa_mont_t mont;
+		montInit(&mont, moduli[i]);
+
+		uint64_t x = montToForm(&mont, getRandom64(&seed));
+		uint64_t y = montToForm(&mont, getRandom64(&seed));
+
+		for(k = 0x00u; k < BENCH_MONT_ITERATIONS; ++k)
+		{ x = montMul(&mont, x, y); }
+		sink ^= montFromForm(&mont, x);
+	}
+	montRate = (BENCH_NUM_OF_MODULI * (double) BENCH_MONT_ITERATIONS) / (getTimeSeconds() - start);
+
+	printf("bit-serial mulMod : %12.0f modmul/s\n", serialRate);
+	printf("montgomery montMul: %12.0f modmul/s\n", montRate);
+	printf("speedup           : %12.1fx\n", montRate / serialRate);
+
+	return (int) (sink & 0x00u);
+}
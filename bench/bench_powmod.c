@@ -0,0 +1,114 @@
+/**
+ * @file bench_powmod.c
+ * @author Mohamed ashraf (wx@wx.com)
+ * @brief modular exponentiation micro benchmark
+ * @version 0.1
+ * @date 2023-01-01
+ * 
+ * @copyright Copyright (c) Wx 2023
+ * 
+ * @attention
+ *      Reports the montgomery squarings and multiplications done by the
+ *      sliding window engine against the plain binary method
+ *      (bits - 1 squarings and popcount - 1 multiplications).
+ * 
+ */
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "rsa_cfg.h"
+#include "rsa_prv.h"
+#include "rsa_bn.h"
+
+/*
+*--------------------------------------------------------------------------------------
+*- Macros
+*--------------------------------------------------------------------------------------
+**/
+
+#define BENCH_NUM_OF_SIZES 				(0x04u)
+#define BENCH_REPETITIONS 				(0x10u)
+
+/*
+*--------------------------------------------------------------------------------------
+*- Private Functions Implementation
+*--------------------------------------------------------------------------------------
+**/
+
+static double
+getTimeSeconds(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (double) ts.tv_sec + ((double) ts.tv_nsec * 1e-9);
+}/* getTimeSeconds */
+
+static void
+benchExponent(const char * const pName, const st_rsa_bn_mont_t * const pMont, const st_rsa_bn_t * const pExp)
+{
+	/* Function data types */
+	st_rsa_bn_exp_stats_t stats = {0};
+	st_rsa_bn_t base;
+	st_rsa_bn_t res;
+	const uint32_t bits = bnBitLength(pExp);
+	uint32_t popCount = 0x00u;
+	uint32_t register i = 0x00u;
+	double start = 0.0, elapsed = 0.0;
+
+	/* Function body */
+	for(i = 0x00u; i < pExp->used; ++i)
+	{ popCount += (uint32_t) __builtin_popcountll(pExp->limbs[i]); }
+
+	bnRandom(&base, bnBitLength(&pMont->n) - 0x01u, RSA_BN_RAND_TOP_ANY);
+
+	start = getTimeSeconds();
+	for(i = 0x00u; i < BENCH_REPETITIONS; ++i)
+	{ bnPowModStats(pMont, &res, &base, pExp, &stats); }
+	elapsed = (getTimeSeconds() - start) / BENCH_REPETITIONS;
+
+	printf("  %-10s exp %4u bits | binary %5u sqr %5u mul | window k=%u %5llu sqr %5llu mul | %9.1f us/op\n",
+	       pName, bits, bits - 0x01u, popCount - 0x01u, stats.windowBits,
+	       (unsigned long long) (stats.squarings / BENCH_REPETITIONS),
+	       (unsigned long long) (stats.multiplies / BENCH_REPETITIONS), elapsed * 1e6);
+}/* benchExponent */
+
+/*
+*--------------------------------------------------------------------------------------
+*- Main
+*--------------------------------------------------------------------------------------
+**/
+
+int main(void)
+{
+	/* Function data types */
+	const uint32_t sizes[BENCH_NUM_OF_SIZES] = {512u, 1024u, 2048u, 4096u};
+	st_rsa_bn_mont_t mont;
+	st_rsa_bn_t n;
+	st_rsa_bn_t exp;
+	uint32_t register i = 0x00u;
+
+	/* Function body */
+	for(i = 0x00u; i < BENCH_NUM_OF_SIZES; ++i)
+	{
+		if( (sizes[i] > RSA_MAX_KEY_BITS) )
+		{ continue; }
+		else;
+
+		bnRandom(&n, sizes[i], RSA_BN_RAND_TOP_ONE | RSA_BN_RAND_ODD);
+		bnMontInit(&mont, &n);
+		printf("modulus %u bits\n", sizes[i]);
+
+		bnFromWord(&exp, 65537u);
+		benchExponent("e=65537", &mont, &exp);
+
+		bnRandom(&exp, sizes[i] / 0x02u, RSA_BN_RAND_TOP_ONE);
+		benchExponent("half size", &mont, &exp);
+
+		bnRandom(&exp, sizes[i], RSA_BN_RAND_TOP_ONE);
+		benchExponent("full size", &mont, &exp);
+	}
+
+	return 0;
+}
@@ -0,0 +1,139 @@
+/**
+ * @file bench_prime.c
+ * @author Mohamed ashraf (wx@wx.com)
+ * @brief prime search micro benchmark
+ * @version 0.1
+ * @date 2023-01-01
+ * 
+ * @copyright Copyright (c) Wx 2023
+ * 
+ * @attention
+ *      Compares the plain odd walk (every candidate goes through
+ *      bnIsPrimeNumber) against the sieved search where only the candidates
+ *      without small factors reach Miller-Rabin.
+ * 
+ */
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "rsa_cfg.h"
+#include "rsa_prv.h"
+#include "rsa_bn.h"
+#include "rsa_prime.h"
+
+/*
+*--------------------------------------------------------------------------------------
+*- Macros
+*--------------------------------------------------------------------------------------
+**/
+
+#define BENCH_NUM_OF_SIZES 				(0x03u)
+#define BENCH_REPETITIONS 				(0x20u)
+
+/*
+*--------------------------------------------------------------------------------------
+*- Private Functions Implementation
+*--------------------------------------------------------------------------------------
+**/
+
+static double
+getTimeSeconds(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (double) ts.tv_sec + ((double) ts.tv_nsec * 1e-9);
+}/* getTimeSeconds */
+
+static uint64_t
+naiveSearch(st_rsa_bn_t * const pPrime, const uint32_t bits)
+{
+	/* Function data types */
+	uint64_t candidates = 0x00u;
+
+	/* Function body */
+	do
+	{
+		bnRandom(pPrime, bits, RSA_BN_RAND_TOP_TWO | RSA_BN_RAND_ODD);
+		while( (bnBitLength(pPrime) == bits) )
+		{
+			++candidates;
+			if( (numberIsPrime == bnIsPrimeNumber(pPrime)) )
+			{ return candidates; }
+			else;
+
+			bnAddWord(pPrime, pPrime, 0x02u);
+		}
+	}
+	while(1);
+}/* naiveSearch */
+
+static void
+sievedSearch(st_rsa_bn_t * const pPrime, const uint32_t bits, st_rsa_prime_stats_t * const pStats)
+{
+	/* Function data types */
+	st_rsa_prime_sieve_t sieve;
+	en_PrimeNumbersStatus_t numberStatus = numberNotPrime;
+
+	/* Function body */
+	while( (numberNotPrime == numberStatus) )
+	{
+		primeSieveInit(&sieve, bits);
+		while( (numberNotPrime == numberStatus) && (primeSieveNext(&sieve, pPrime)) )
+		{ numberStatus = bnMillerRabin(pPrime); }
+
+		pStats->candidates += sieve.stats.candidates;
+		pStats->sieved += sieve.stats.sieved;
+		pStats->mrTested += sieve.stats.mrTested;
+		pStats->windows += sieve.stats.windows;
+	}
+}/* sievedSearch */
+
+/*
+*--------------------------------------------------------------------------------------
+*- Main
+*--------------------------------------------------------------------------------------
+**/
+
+int main(void)
+{
+	/* Function data types */
+	const uint32_t sizes[BENCH_NUM_OF_SIZES] = {512u, 1024u, 2048u};
+	st_rsa_prime_stats_t stats;
+	st_rsa_bn_t prime;
+	uint64_t naiveCandidates = 0x00u;
+	uint32_t register i = 0x00u;
+	uint32_t register j = 0x00u;
+	double start = 0.0, naiveTime = 0.0, sievedTime = 0.0;
+
+	/* Function body */
+	for(i = 0x00u; i < BENCH_NUM_OF_SIZES; ++i)
+	{
+		if( (sizes[i] > RSA_MAX_KEY_BITS) )
+		{ continue; }
+		else;
+
+		naiveCandidates = 0x00u;
+		start = getTimeSeconds();
+		for(j = 0x00u; j < BENCH_REPETITIONS; ++j)
+		{ naiveCandidates += naiveSearch(&prime, sizes[i]); }
+		naiveTime = (getTimeSeconds() - start) / BENCH_REPETITIONS;
+
+		memset(&stats, 0x00u, sizeof(stats));
+		start = getTimeSeconds();
+		for(j = 0x00u; j < BENCH_REPETITIONS; ++j)
+		{ sievedSearch(&prime, sizes[i], &stats); }
+		sievedTime = (getTimeSeconds() - start) / BENCH_REPETITIONS;
+
+		printf("prime %4u bits | naive %6.1f ms (%5llu candidates) | sieved %6.1f ms (%5llu candidates, %5llu sieved, %4llu mr tested, %llu windows) | %.2fx\n",
+		       sizes[i], naiveTime * 1e3, (unsigned long long) (naiveCandidates / BENCH_REPETITIONS),
+		       sievedTime * 1e3, (unsigned long long) (stats.candidates / BENCH_REPETITIONS),
+		       (unsigned long long) (stats.sieved / BENCH_REPETITIONS),
+		       (unsigned long long) (stats.mrTested / BENCH_REPETITIONS),
+		       (unsigned long long) stats.windows, naiveTime / sievedTime);
+	}
+
+	return 0;
+}
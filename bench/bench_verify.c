@@ -0,0 +1,193 @@
+/**
+ * @file bench_verify.c
+ * @author Mohamed ashraf (wx@wx.com)
+ * @brief signature verification benchmark
+ * @version 0.1
+ * @date 2023-01-01
+ *
+ * @copyright Copyright (c) Wx 2023
+ *
+ * @attention
+ *      Reports the verifications per second of a single thread, one call of
+ *      rsa_pubkey_verify() per signature against rsa_pubkey_verify_batch()
+ *      over the same signatures, under one key and spread over several keys.
+ *
+ */
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "rsa_cfg.h"
+#include "rsa_prv.h"
+#include "rsa_int.h"
+
+/*
+*--------------------------------------------------------------------------------------
+*- Macros
+*--------------------------------------------------------------------------------------
+**/
+
+#define BENCH_NUM_OF_SIZES 				(0x03u)
+#define BENCH_NUM_OF_KEYS 				(0x04u)
+#define BENCH_NUM_OF_ITEMS 				(0x100u)
+#define BENCH_MSG_BYTES 					(0x40u)
+#define BENCH_MIN_VERIFIES 				(0x800u)
+
+/*
+*--------------------------------------------------------------------------------------
+*- Data types
+*--------------------------------------------------------------------------------------
+**/
+
+static uint8_t messages[BENCH_NUM_OF_ITEMS][BENCH_MSG_BYTES];
+static uint8_t signatures[BENCH_NUM_OF_ITEMS][RSA_MAX_KEY_BITS / 0x08u];
+static const uint8_t *pMessages[BENCH_NUM_OF_ITEMS];
+static const uint8_t *pSignatures[BENCH_NUM_OF_ITEMS];
+static uint64_t messageLens[BENCH_NUM_OF_ITEMS];
+static const rsa_pubkey_t *pItemKeys[BENCH_NUM_OF_ITEMS];
+static en_rsa_status_t results[BENCH_NUM_OF_ITEMS];
+
+/*
+*--------------------------------------------------------------------------------------
+*- Private Functions Implementation
+*--------------------------------------------------------------------------------------
+**/
+
+static double
+getTimeSeconds(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (double) ts.tv_sec + ((double) ts.tv_nsec * 1e-9);
+}/* getTimeSeconds */
+
+/**
+ * @brief Signs every message, item i under key i % numOfKeys.
+ */
+static uint8_t
+benchSign(rsa_ctx_t * const * const ppCtxs, rsa_pubkey_t * const * const ppKeys, const uint32_t numOfKeys)
+{
+	/* Function data types */
+	uint32_t register i = 0x00u;
+
+	/* Function body */
+	for(i = 0x00u; i < BENCH_NUM_OF_ITEMS; ++i)
+	{
+		pItemKeys[i] = ppKeys[i % numOfKeys];
+		if( (rsaStatusOk != rsa_ctx_sign(ppCtxs[i % numOfKeys], messages[i], messageLens[i], signatures[i])) )
+		{ return 0x00u; }
+		else;
+	}
+
+	return 0x01u;
+}/* benchSign */
+
+static double
+benchScalar(void)
+{
+	/* Function data types */
+	const uint32_t rounds = (BENCH_MIN_VERIFIES + BENCH_NUM_OF_ITEMS - 0x01u) / BENCH_NUM_OF_ITEMS;
+	uint32_t register r = 0x00u;
+	uint32_t register i = 0x00u;
+	double start = getTimeSeconds();
+
+	/* Function body */
+	for(r = 0x00u; r < rounds; ++r)
+	{
+		for(i = 0x00u; i < BENCH_NUM_OF_ITEMS; ++i)
+		{ results[i] = rsa_pubkey_verify(pItemKeys[i], pMessages[i], messageLens[i], pSignatures[i]); }
+	}
+
+	return (double) (rounds * BENCH_NUM_OF_ITEMS) / (getTimeSeconds() - start);
+}/* benchScalar */
+
+static double
+benchBatch(void)
+{
+	/* Function data types */
+	const uint32_t rounds = (BENCH_MIN_VERIFIES + BENCH_NUM_OF_ITEMS - 0x01u) / BENCH_NUM_OF_ITEMS;
+	uint32_t register r = 0x00u;
+	double start = getTimeSeconds();
+
+	/* Function body */
+	for(r = 0x00u; r < rounds; ++r)
+	{ (void) rsa_pubkey_verify_batch(pItemKeys, pMessages, messageLens, pSignatures, BENCH_NUM_OF_ITEMS, results); }
+
+	return (double) (rounds * BENCH_NUM_OF_ITEMS) / (getTimeSeconds() - start);
+}/* benchBatch */
+
+/*
+*--------------------------------------------------------------------------------------
+*- Main
+*--------------------------------------------------------------------------------------
+**/
+
+int main(void)
+{
+	/* Function data types */
+	const uint32_t sizes[BENCH_NUM_OF_SIZES] = {1024u, 2048u, 4096u};
+	const uint32_t spreads[0x02u] = {1u, BENCH_NUM_OF_KEYS};
+	rsa_ctx_t *pCtxs[BENCH_NUM_OF_KEYS];
+	rsa_pubkey_t *pKeys[BENCH_NUM_OF_KEYS];
+	uint32_t register i = 0x00u;
+	uint32_t register j = 0x00u;
+
+	/* Function body */
+	for(i = 0x00u; i < BENCH_NUM_OF_ITEMS; ++i)
+	{
+		for(j = 0x00u; j < BENCH_MSG_BYTES; ++j)
+		{ messages[i][j] = (uint8_t) rand(); }
+
+		messageLens[i] = BENCH_MSG_BYTES;
+		pMessages[i] = messages[i];
+		pSignatures[i] = signatures[i];
+	}
+
+	for(i = 0x00u; i < BENCH_NUM_OF_SIZES; ++i)
+	{
+		if( (sizes[i] > RSA_MAX_KEY_BITS) )
+		{ continue; }
+		else;
+
+		for(j = 0x00u; j < BENCH_NUM_OF_KEYS; ++j)
+		{
+			pCtxs[j] = rsa_ctx_create();
+			if( (NULL == pCtxs[j]) || (rsaStatusOk != rsa_ctx_generate(pCtxs[j], sizes[i])) )
+			{
+				printf("key generation failed\n");
+				return 1;
+			}
+			else;
+
+			pKeys[j] = rsa_pubkey_create(pCtxs[j]);
+		}
+
+		printf("modulus %u bits, e = 65537, %u signatures of %u bytes\n", sizes[i], BENCH_NUM_OF_ITEMS, BENCH_MSG_BYTES);
+		for(j = 0x00u; j < 0x02u; ++j)
+		{
+			double scalarRate = 0.0;
+			double batchRate = 0.0;
+
+			if( (0x00u == benchSign(pCtxs, pKeys, spreads[j])) )
+			{
+				printf("signing failed\n");
+				return 1;
+			}
+			else;
+
+			scalarRate = benchScalar();
+			batchRate = benchBatch();
+			printf("  %u key(s) | single %9.0f verify/s | batch %9.0f verify/s | %.2fx\n",
+			       spreads[j], scalarRate, batchRate, batchRate / scalarRate);
+		}
+
+		for(j = 0x00u; j < BENCH_NUM_OF_KEYS; ++j)
+		{
+			rsa_pubkey_destroy(pKeys[j]);
+			rsa_ctx_destroy(pCtxs[j]);
+		}
+	}
+
+	return 0;
+}
@@ -0,0 +1,433 @@
+/**
+ * @file rsa_bench.c
+ * @author Mohamed ashraf (wx@wx.com)
+ * @brief rsa benchmark suite
+ * @version 0.1
+ * @date 2023-01-01
+ *
+ * @copyright Copyright (c) Wx 2023
+ *
+ * @attention
+ *      Every case runs `warmup` untimed repetitions then `repetitions` timed
+ *      ones, each repetition performing `ops` operations. The median, p99,
+ *      min and mean are reported per operation, cycles are read from the
+ *      time stamp counter so they follow the nominal frequency.
+ *      usage: rsa_bench [--json] [--quick]
+ *
+ */
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "rsa_cfg.h"
+#include "rsa_prv.h"
+#include "rsa_int.h"
+#include "rsa_arith.h"
+#include "rsa_prime64.h"
+
+/*
+*--------------------------------------------------------------------------------------
+*- Macros
+*--------------------------------------------------------------------------------------
+**/
+
+#define BENCH_NUM_OF_INPUTS 				(0x400u)
+#define BENCH_INPUT_MASK 						(BENCH_NUM_OF_INPUTS - 0x01u)
+#define BENCH_MAX_RESULTS 					(0x40u)
+#define BENCH_NUM_OF_KEY_SIZES 			(0x04u)
+#define BENCH_MAX_PRIMES 						(0x04u)
+
+#if defined(__x86_64__) || defined(__i386__)
+	#define BENCH_READ_CYCLES() 				(__builtin_ia32_rdtsc())
+#else
+	#define BENCH_READ_CYCLES() 				(0x00u)
+#endif
+
+/*
+*--------------------------------------------------------------------------------------
+*- Data types
+*--------------------------------------------------------------------------------------
+**/
+
+typedef void (*pf_bench_op_t)(void *pArg, const uint32_t ops);
+
+typedef struct bench_result
+{
+	const char *pName;
+	uint32_t param; 			/* Operand or key size in bits */
+	uint32_t warmup;
+	uint32_t repetitions;
+	uint32_t ops; 				/* Operations per repetition */
+	double medianNs;
+	double p99Ns;
+	double minNs;
+	double meanNs;
+	double cyclesPerOp; 	/* Median repetition */
+}st_bench_result_t;
+
+/** @brief Inputs of the word sized micro benchmarks */
+typedef struct bench_words
+{
+	uint64_t a[BENCH_NUM_OF_INPUTS];
+	uint64_t b[BENCH_NUM_OF_INPUTS];
+	uint64_t mod[BENCH_NUM_OF_INPUTS]; 		/* Odd moduli */
+	en_PrimeNumbersStatus_t status[BENCH_NUM_OF_INPUTS];
+	uint64_t sink;
+}st_bench_words_t;
+
+typedef struct bench_key
+{
+	rsa_ctx_t *pCtx;
+	uint32_t keyBits;
+	uint64_t msgLen; 											/* One block of payload */
+	uint8_t msg[RSA_MAX_KEY_BITS / 0x08u];
+	uint8_t cipher[RSA_MAX_KEY_BITS / 0x08u];
+	uint8_t plain[RSA_MAX_KEY_BITS / 0x08u];
+}st_bench_key_t;
+
+static st_bench_words_t words;
+static st_bench_key_t keys[BENCH_NUM_OF_KEY_SIZES];
+static st_bench_result_t results[BENCH_MAX_RESULTS];
+static uint32_t numOfResults = 0x00u;
+
+/*
+*--------------------------------------------------------------------------------------
+*- Private Functions Implementation
+*--------------------------------------------------------------------------------------
+**/
+
+static uint64_t
+getTimeNs(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ((uint64_t) ts.tv_sec * 1000000000ull) + (uint64_t) ts.tv_nsec;
+}/* getTimeNs */
+
+static uint64_t
+getRandom64(uint64_t * const pState)
+{
+	/* splitmix64 */
+	uint64_t z = (*pState += 0x9E3779B97F4A7C15u);
+	z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9u;
+	z = (z ^ (z >> 27)) * 0x94D049BB133111EBu;
+	return z ^ (z >> 31);
+}/* getRandom64 */
+
+static int
+compareDoubles(const void *pA, const void *pB)
+{
+	const double a = *(const double *) pA;
+	const double b = *(const double *) pB;
+	return (a < b) ? (-1) : ((a > b) ? (1) : (0));
+}/* compareDoubles */
+
+/**
+ * @brief Times `repetitions` runs of pfOp and appends the per operation
+ * 			  statistics to the results.
+ */
+static void
+benchRun(const char * const pName, const uint32_t param, const uint32_t warmup, const uint32_t repetitions,
+         const uint32_t ops, const pf_bench_op_t pfOp, void * const pArg)
+{
+	/* Function data types */
+	double *pNs = (double *) malloc(repetitions * sizeof(double));
+	double *pCycles = (double *) malloc(repetitions * sizeof(double));
+	st_bench_result_t *pRes = &results[numOfResults];
+	uint64_t startNs = 0x00u;
+	uint64_t startCycles = 0x00u;
+	double sum = 0.0;
+	uint32_t register i = 0x00u;
+
+	/* Validating */
+	if( (NULL == pNs) || (NULL == pCycles) || (numOfResults >= BENCH_MAX_RESULTS) || (0x00u == repetitions) )
+	{
+		free(pNs);
+		free(pCycles);
+		return;
+	}
+	else;
+
+	/* Function body */
+	for(i = 0x00u; i < warmup; ++i)
+	{ pfOp(pArg, ops); }
+
+	for(i = 0x00u; i < repetitions; ++i)
+	{
+		startNs = getTimeNs();
+		startCycles = BENCH_READ_CYCLES();
+		pfOp(pArg, ops);
+		pCycles[i] = (double) (BENCH_READ_CYCLES() - startCycles) / ops;
+		pNs[i] = (double) (getTimeNs() - startNs) / ops;
+		sum += pNs[i];
+	}
+
+	qsort(pNs, repetitions, sizeof(double), compareDoubles);
+	qsort(pCycles, repetitions, sizeof(double), compareDoubles);
+
+	pRes->pName = pName;
+	pRes->param = param;
+	pRes->warmup = warmup;
+	pRes->repetitions = repetitions;
+	pRes->ops = ops;
+	pRes->medianNs = pNs[repetitions / 0x02u];
+	pRes->p99Ns = pNs[((repetitions * 99u) + 99u) / 100u - 0x01u];
+	pRes->minNs = pNs[0];
+	pRes->meanNs = sum / repetitions;
+	pRes->cyclesPerOp = pCycles[repetitions / 0x02u];
+	++numOfResults;
+
+	fprintf(stderr, "%-16s %5u bits: median %12.1f ns, p99 %12.1f ns, %12.0f cycles/op\n",
+	        pName, param, pRes->medianNs, pRes->p99Ns, pRes->cyclesPerOp);
+
+	free(pNs);
+	free(pCycles);
+}/* benchRun */
+
+/** @defgroup Micro benchmark operations */
+
+static void
+opMulMod(void *pArg, const uint32_t ops)
+{
+	st_bench_words_t * const pWords = (st_bench_words_t *) pArg;
+	uint64_t x = pWords->sink;
+	uint32_t register i = 0x00u;
+
+	/* Dependent chain so the latency is measured */
+	for(i = 0x00u; i < ops; ++i)
+	{ x = mulMod(x ^ pWords->a[i & BENCH_INPUT_MASK], pWords->b[i & BENCH_INPUT_MASK], pWords->mod[i & BENCH_INPUT_MASK]); }
+	pWords->sink = x;
+}/* opMulMod */
+
+static void
+opPowMod(void *pArg, const uint32_t ops)
+{
+	st_bench_words_t * const pWords = (st_bench_words_t *) pArg;
+	uint64_t x = pWords->sink;
+	uint32_t register i = 0x00u;
+
+	for(i = 0x00u; i < ops; ++i)
+	{ x ^= powMod(pWords->a[i & BENCH_INPUT_MASK], pWords->b[i & BENCH_INPUT_MASK], pWords->mod[i & BENCH_INPUT_MASK]); }
+	pWords->sink = x;
+}/* opPowMod */
+
+static void
+opGetGCD(void *pArg, const uint32_t ops)
+{
+	st_bench_words_t * const pWords = (st_bench_words_t *) pArg;
+	uint64_t x = pWords->sink;
+	uint32_t register i = 0x00u;
+
+	for(i = 0x00u; i < ops; ++i)
+	{ x ^= getGCD(pWords->a[i & BENCH_INPUT_MASK] | 0x01u, pWords->mod[i & BENCH_INPUT_MASK]); }
+	pWords->sink = x;
+}/* opGetGCD */
+
+static void
+opIsPrimeNumber(void *pArg, const uint32_t ops)
+{
+	st_bench_words_t * const pWords = (st_bench_words_t *) pArg;
+	uint64_t x = pWords->sink;
+	uint32_t register i = 0x00u;
+
+	for(i = 0x00u; i < ops; ++i)
+	{ x += isPrimeNumber(pWords->mod[i & BENCH_INPUT_MASK]); }
+	pWords->sink = x;
+}/* opIsPrimeNumber */
+
+static void
+opBailliePSW(void *pArg, const uint32_t ops)
+{
+	st_bench_words_t * const pWords = (st_bench_words_t *) pArg;
+	uint64_t x = pWords->sink;
+	uint32_t register i = 0x00u;
+
+	for(i = 0x00u; i < ops; ++i)
+	{ x += prime64BailliePSW(pWords->mod[i & BENCH_INPUT_MASK]); }
+	pWords->sink = x;
+}/* opBailliePSW */
+
+static void
+opPrimeTestBatch(void *pArg, const uint32_t ops)
+{
+	st_bench_words_t * const pWords = (st_bench_words_t *) pArg;
+	uint64_t x = pWords->sink;
+	uint32_t register i = 0x00u;
+
+	/* ops is a multiple of the inputs count */
+	for(i = 0x00u; i < ops; i += BENCH_NUM_OF_INPUTS)
+	{ x += prime64TestBatch(pWords->mod, pWords->status, BENCH_NUM_OF_INPUTS); }
+	pWords->sink = x;
+}/* opPrimeTestBatch */
+
+/** @defgroup End to end operations */
+
+static void
+opKeygen(void *pArg, const uint32_t ops)
+{
+	st_bench_key_t * const pKey = (st_bench_key_t *) pArg;
+	uint32_t register i = 0x00u;
+
+	for(i = 0x00u; i < ops; ++i)
+	{ rsa_ctx_generate(pKey->pCtx, pKey->keyBits); }
+}/* opKeygen */
+
+static void
+opEncrypt(void *pArg, const uint32_t ops)
+{
+	st_bench_key_t * const pKey = (st_bench_key_t *) pArg;
+	uint32_t register i = 0x00u;
+
+	for(i = 0x00u; i < ops; ++i)
+	{
+		pKey->msg[0] = (uint8_t) i;
+		rsa_ctx_encrypt_blocks(pKey->pCtx, pKey->msg, pKey->msgLen, pKey->cipher);
+	}
+}/* opEncrypt */
+
+static void
+opDecrypt(void *pArg, const uint32_t ops)
+{
+	st_bench_key_t * const pKey = (st_bench_key_t *) pArg;
+	uint64_t plainLen = 0x00u;
+	uint32_t register i = 0x00u;
+
+	for(i = 0x00u; i < ops; ++i)
+	{ rsa_ctx_decrypt_blocks(pKey->pCtx, pKey->cipher, rsa_ctx_block_cipher_size(pKey->pCtx, pKey->msgLen), pKey->plain, &plainLen); }
+}/* opDecrypt */
+
+static void
+opSign(void *pArg, const uint32_t ops)
+{
+	st_bench_key_t * const pKey = (st_bench_key_t *) pArg;
+	uint32_t register i = 0x00u;
+
+	for(i = 0x00u; i < ops; ++i)
+	{
+		pKey->msg[0] = (uint8_t) i;
+		rsa_ctx_sign(pKey->pCtx, pKey->msg, pKey->msgLen, pKey->plain);
+	}
+}/* opSign */
+
+static void
+printJson(void)
+{
+	/* Function data types */
+	uint32_t register i = 0x00u;
+
+	/* Function body */
+	printf("{\n  \"suite\": \"rsa_bench\",\n  \"results\": [\n");
+	for(i = 0x00u; i < numOfResults; ++i)
+	{
+		printf("    {\"name\": \"%s\", \"bits\": %u, \"warmup\": %u, \"repetitions\": %u, \"ops_per_repetition\": %u, "
+		       "\"median_ns\": %.1f, \"p99_ns\": %.1f, \"min_ns\": %.1f, \"mean_ns\": %.1f, \"cycles_per_op\": %.1f}%s\n",
+		       results[i].pName, results[i].param, results[i].warmup, results[i].repetitions, results[i].ops,
+		       results[i].medianNs, results[i].p99Ns, results[i].minNs, results[i].meanNs, results[i].cyclesPerOp,
+		       ((i + 0x01u) < numOfResults) ? (",") : (""));
+	}
+	printf("  ]\n}\n");
+}/* printJson */
+
+static void
+printTable(void)
+{
+	/* Function data types */
+	uint32_t register i = 0x00u;
+
+	/* Function body */
+	printf("%-16s %6s %8s %14s %14s %14s\n", "benchmark", "bits", "reps", "median ns/op", "p99 ns/op", "cycles/op");
+	for(i = 0x00u; i < numOfResults; ++i)
+	{
+		printf("%-16s %6u %8u %14.1f %14.1f %14.0f\n", results[i].pName, results[i].param,
+		       results[i].repetitions, results[i].medianNs, results[i].p99Ns, results[i].cyclesPerOp);
+	}
+}/* printTable */
+
+/*
+*--------------------------------------------------------------------------------------
+*- Main
+*--------------------------------------------------------------------------------------
+**/
+
+int main(int argc, char **argv)
+{
+	/* Function data types */
+	const uint32_t keyBits[BENCH_NUM_OF_KEY_SIZES] = {1024u, 2048u, 3072u, 4096u};
+	const uint32_t keygenReps[BENCH_NUM_OF_KEY_SIZES] = {21u, 9u, 5u, 3u};
+	const char * const decryptNames[BENCH_MAX_PRIMES + 0x01u] = {NULL, NULL, "decrypt", "decrypt-3p", "decrypt-4p"};
+	const char * const signNames[BENCH_MAX_PRIMES + 0x01u] = {NULL, NULL, "sign", "sign-3p", "sign-4p"};
+	uint32_t primes = 0x00u;
+	uint64_t seed = 0x5EEDu;
+	uint8_t json = 0x00u;
+	uint32_t numOfKeys = BENCH_NUM_OF_KEY_SIZES;
+	uint32_t register i = 0x00u;
+
+	/* Function body */
+	for(i = 0x01u; i < (uint32_t) argc; ++i)
+	{
+		if( (0x00 == strcmp(argv[i], "--json")) )
+		{ json = 0x01u; }
+		else if( (0x00 == strcmp(argv[i], "--quick")) )
+		{ numOfKeys = 0x02u; }
+		else
+		{
+			fprintf(stderr, "usage: %s [--json] [--quick]\n", argv[0]);
+			return 2;
+		}
+	}
+
+	for(i = 0x00u; i < BENCH_NUM_OF_INPUTS; ++i)
+	{
+		words.a[i] = getRandom64(&seed);
+		words.b[i] = getRandom64(&seed);
+		words.mod[i] = getRandom64(&seed) | 0x8000000000000001u;
+	}
+
+	benchRun("mulMod", 64u, 10u, 200u, 4096u, opMulMod, &words);
+	benchRun("powMod", 64u, 10u, 200u, 256u, opPowMod, &words);
+	benchRun("getGCD", 64u, 10u, 200u, 1024u, opGetGCD, &words);
+	benchRun("isPrimeNumber", 64u, 10u, 200u, 256u, opIsPrimeNumber, &words);
+	benchRun("bailliePSW", 64u, 10u, 200u, 256u, opBailliePSW, &words);
+	benchRun("primeTestBatch", 64u, 10u, 200u, BENCH_NUM_OF_INPUTS, opPrimeTestBatch, &words);
+
+	for(i = 0x00u; i < numOfKeys; ++i)
+	{
+		keys[i].keyBits = keyBits[i];
+		keys[i].pCtx = rsa_ctx_create();
+		if( (NULL == keys[i].pCtx) )
+		{ return 1; }
+		else;
+
+		benchRun("keygen", keyBits[i], 0x01u, keygenReps[i], 0x01u, opKeygen, &keys[i]);
+
+		keys[i].msgLen = (keyBits[i] / 0x08u) - RSA_BLOCK_HEADER_BYTES - 0x01u;
+		memset(keys[i].msg, 0xA5u, keys[i].msgLen);
+		benchRun("encrypt", keyBits[i], 0x10u, 200u, 0x10u, opEncrypt, &keys[i]);
+		benchRun("decrypt", keyBits[i], 0x02u, 50u, 0x02u, opDecrypt, &keys[i]);
+		benchRun("sign", keyBits[i], 0x02u, 50u, 0x02u, opSign, &keys[i]);
+
+		/* The private key operations again under multi-prime keys of the same size */
+		for(primes = 0x03u; (primes <= RSA_MAX_PRIMES) && (primes <= BENCH_MAX_PRIMES); ++primes)
+		{
+			if( (rsaStatusOk != rsa_ctx_set_num_of_primes(keys[i].pCtx, primes)) ||
+			    (rsaStatusOk != rsa_ctx_generate(keys[i].pCtx, keyBits[i])) )
+			{ return 1; }
+			else;
+
+			rsa_ctx_encrypt_blocks(keys[i].pCtx, keys[i].msg, keys[i].msgLen, keys[i].cipher);
+			benchRun(decryptNames[primes], keyBits[i], 0x02u, 50u, 0x02u, opDecrypt, &keys[i]);
+			benchRun(signNames[primes], keyBits[i], 0x02u, 50u, 0x02u, opSign, &keys[i]);
+		}
+
+		rsa_ctx_destroy(keys[i].pCtx);
+	}
+
+	if( (json) )
+	{ printJson(); }
+	else
+	{ printTable(); }
+
+	return (int) (words.sink & 0x00u);
+}
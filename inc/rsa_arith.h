@@ -0,0 +1,50 @@
+/**
+ * @file rsa_arith.h
+ * @author Mohamed ashraf (wx@wx.com)
+ * @brief rsa single word arithmetic interface file
+ * @version 0.1
+ * @date 2023-01-01
+ *
+ * @copyright Copyright (c) Wx 2023
+ *
+ * @attention
+ *      The header must be included after `rsa_cfg.h` and `rsa_prv.h`.
+ *
+ */
+/** @def Header guards */
+#ifndef __RSA_ARITH_H__
+#define __RSA_ARITH_H__
+
+/** @def Handeling name mangle */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+*--------------------------------------------------------------------------------------
+*- Functions Declaration
+*--------------------------------------------------------------------------------------
+**/
+
+_FORCE_CONST
+uint64_t
+mulMod(uint64_t a, uint64_t b, const uint64_t mod);
+
+uint64_t
+powMod(uint64_t n, uint64_t exp, const uint64_t mod);
+
+en_PrimeNumbersStatus_t
+isPrimeNumber(uint64_t primeNumber);
+
+uint64_t
+getGCD(uint64_t numA, uint64_t numB);
+
+uint64_t
+modInverse(uint64_t num, const uint64_t mod);
+
+/** @def Handeling name mangle */
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __RSA_ARITH_H__ */
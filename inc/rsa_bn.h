@@ -0,0 +1,167 @@
+/**
+ * @file rsa_bn.h
+ * @author Mohamed ashraf (wx@wx.com)
+ * @brief rsa multi-precision integer interface file
+ * @version 0.1
+ * @date 2023-01-01
+ *
+ * @copyright Copyright (c) Wx 2023
+ *
+ * @attention
+ *      Numbers are stored in a fixed capacity little endian limb array sized
+ *      by `RSA_MAX_KEY_BITS`, no operation allocates from the heap.
+ *      All the limbs above `used` are kept zero.
+ *      The numbers and the montgomery contexts hold no pointer, so they stay
+ *      valid when mapped from a key store file.
+ *      The header must be included after `rsa_cfg.h` and `rsa_prv.h`.
+ *
+ */
+/** @def Header guards */
+#ifndef __RSA_BN_H__
+#define __RSA_BN_H__
+
+/** @def Handeling name mangle */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+*--------------------------------------------------------------------------------------
+*- Macros
+*--------------------------------------------------------------------------------------
+**/
+
+#define RSA_BN_LIMB_BITS 					(64u)
+#define RSA_BN_MAX_LIMBS 					(RSA_MAX_KEY_BITS / RSA_BN_LIMB_BITS)
+/** @brief Double width storage used by products before being reduced */
+#define RSA_BN_WIDE_LIMBS 				((RSA_BN_MAX_LIMBS * 0x02u) + 0x02u)
+
+/** @defgroup bnRandom flags */
+#define RSA_BN_RAND_TOP_ANY 			(0x00u)
+#define RSA_BN_RAND_TOP_ONE 			(0x01u)
+#define RSA_BN_RAND_TOP_TWO 			(0x02u)
+#define RSA_BN_RAND_ODD 					(0x04u)
+
+/** @brief Windows held by an exponent plan, public exponents need a handful */
+#define RSA_BN_EXP_PLAN_MAX_WINDOWS (0x40u)
+
+/*
+*--------------------------------------------------------------------------------------
+*- Data types
+*--------------------------------------------------------------------------------------
+**/
+
+/**
+ * @brief Multi-precision unsigned integer.
+*/
+typedef struct rsa_bn
+{
+	uint64_t limbs[RSA_BN_MAX_LIMBS]; 	/* Little endian limbs */
+	uint32_t used; 											/* Number of significant limbs, 0 for zero */
+}__attribute__((aligned(64))) st_rsa_bn_t;
+
+/**
+ * @brief Per-modulus montgomery context, R = 2^(64 * len).
+*/
+typedef struct rsa_bn_mont
+{
+	st_rsa_bn_t n; 			/* Odd modulus */
+	st_rsa_bn_t rr; 		/* R^2 mod n, used to enter the montgomery domain */
+	st_rsa_bn_t one; 		/* R mod n, montgomery form of 1 */
+	uint64_t n0inv; 		/* -n^-1 mod 2^64 */
+	uint32_t len; 			/* Number of limbs of n */
+}st_rsa_bn_mont_t;
+
+/**
+ * @brief Montgomery operation counters of an exponentiation.
+*/
+typedef struct rsa_bn_exp_stats
+{
+	uint64_t squarings;
+	uint64_t multiplies; 		/* Including the odd powers table precomputation */
+	uint32_t windowBits; 		/* Window size used by the last exponentiation */
+}st_rsa_bn_exp_stats_t;
+
+/**
+ * @brief Sliding window layout of a fixed exponent, recoded once so that the
+ * 			  exponentiations under the same exponent skip the bit scanning.
+ * 				Window 0 loads its table entry, every later window i squares
+ * 				squarings[i] times then multiplies by its table entry.
+*/
+typedef struct rsa_bn_exp_plan
+{
+	uint16_t squarings[RSA_BN_EXP_PLAN_MAX_WINDOWS];
+	uint8_t index[RSA_BN_EXP_PLAN_MAX_WINDOWS]; 	/* Odd powers table entry of window i */
+	uint32_t numOfWindows;
+	uint32_t tailSquarings; 											/* Squarings after the last window */
+	uint32_t windowBits; 													/* 0 when the exponent doesn't fit the plan */
+}st_rsa_bn_exp_plan_t;
+
+/*
+*--------------------------------------------------------------------------------------
+*- Functions Declaration
+*--------------------------------------------------------------------------------------
+**/
+
+/** @defgroup Basic operations */
+void bnZero(st_rsa_bn_t * const pRes);
+void bnFromWord(st_rsa_bn_t * const pRes, const uint64_t word);
+void bnCopy(st_rsa_bn_t * const pRes, const st_rsa_bn_t * const pA);
+uint32_t bnBitLength(const st_rsa_bn_t * const pA);
+uint8_t bnTestBit(const st_rsa_bn_t * const pA, const uint32_t bit);
+int8_t bnCompare(const st_rsa_bn_t * const pA, const st_rsa_bn_t * const pB);
+uint8_t bnIsWord(const st_rsa_bn_t * const pA, const uint64_t word);
+
+/** @defgroup Arithmetic operations */
+void bnAdd(st_rsa_bn_t * const pRes, const st_rsa_bn_t * const pA, const st_rsa_bn_t * const pB);
+void bnSub(st_rsa_bn_t * const pRes, const st_rsa_bn_t * const pA, const st_rsa_bn_t * const pB);
+void bnAddWord(st_rsa_bn_t * const pRes, const st_rsa_bn_t * const pA, const uint64_t word);
+void bnSubWord(st_rsa_bn_t * const pRes, const st_rsa_bn_t * const pA, const uint64_t word);
+void bnShiftRight(st_rsa_bn_t * const pRes, const st_rsa_bn_t * const pA, const uint32_t bits);
+void bnMul(st_rsa_bn_t * const pRes, const st_rsa_bn_t * const pA, const st_rsa_bn_t * const pB);
+void bnDivMod(st_rsa_bn_t * const pQuot, st_rsa_bn_t * const pRem,
+              const st_rsa_bn_t * const pA, const st_rsa_bn_t * const pM);
+void bnMod(st_rsa_bn_t * const pRes, const st_rsa_bn_t * const pA, const st_rsa_bn_t * const pM);
+uint64_t bnModWord(const st_rsa_bn_t * const pA, const uint64_t word);
+void bnMulMod(st_rsa_bn_t * const pRes, const st_rsa_bn_t * const pA,
+              const st_rsa_bn_t * const pB, const st_rsa_bn_t * const pM);
+
+/** @defgroup Montgomery operations */
+void bnMontInit(st_rsa_bn_mont_t * const pMont, const st_rsa_bn_t * const pN);
+void bnMontToForm(const st_rsa_bn_mont_t * const pMont, st_rsa_bn_t * const pRes, const st_rsa_bn_t * const pA);
+void bnMontFromForm(const st_rsa_bn_mont_t * const pMont, st_rsa_bn_t * const pRes, const st_rsa_bn_t * const pA);
+void bnMontMul(const st_rsa_bn_mont_t * const pMont, st_rsa_bn_t * const pRes,
+               const st_rsa_bn_t * const pA, const st_rsa_bn_t * const pB);
+void bnMontSqr(const st_rsa_bn_mont_t * const pMont, st_rsa_bn_t * const pRes, const st_rsa_bn_t * const pA);
+
+/** @defgroup Number theory operations */
+void bnPowMod(const st_rsa_bn_mont_t * const pMont, st_rsa_bn_t * const pRes,
+              const st_rsa_bn_t * const pBase, const st_rsa_bn_t * const pExp);
+void bnPowModStats(const st_rsa_bn_mont_t * const pMont, st_rsa_bn_t * const pRes,
+                   const st_rsa_bn_t * const pBase, const st_rsa_bn_t * const pExp,
+                   st_rsa_bn_exp_stats_t * const pStats);
+void bnExpPlanInit(st_rsa_bn_exp_plan_t * const pPlan, const st_rsa_bn_t * const pExp);
+void bnPowModPlan(const st_rsa_bn_mont_t * const pMont, st_rsa_bn_t * const pRes,
+                  const st_rsa_bn_t * const pBase, const st_rsa_bn_t * const pExp,
+                  const st_rsa_bn_exp_plan_t * const pPlan);
+en_PrimeNumbersStatus_t bnIsPrimeNumber(const st_rsa_bn_t * const pA);
+en_PrimeNumbersStatus_t bnMillerRabin(const st_rsa_bn_t * const pA);
+void bnGetGCD(st_rsa_bn_t * const pRes, const st_rsa_bn_t * const pA, const st_rsa_bn_t * const pB);
+uint8_t bnModInverse(st_rsa_bn_t * const pRes, const st_rsa_bn_t * const pA, const st_rsa_bn_t * const pM);
+uint8_t bnModInverseBatch(const st_rsa_bn_mont_t * const pMont, st_rsa_bn_t * const pRes,
+                          const st_rsa_bn_t * const pA, const uint32_t count);
+
+/** @defgroup Conversion operations */
+void bnRandom(st_rsa_bn_t * const pRes, const uint32_t bits, const uint8_t flags);
+void bnGetRandomBytes(uint8_t * const pBuf, const uint32_t len);
+void bnFromBytes(st_rsa_bn_t * const pRes, const uint8_t * const pBuf, const uint32_t len);
+void bnToBytes(uint8_t * const pBuf, const uint32_t len, const st_rsa_bn_t * const pA);
+void bnToHex(char * const pBuf, const uint32_t len, const st_rsa_bn_t * const pA);
+uint8_t bnFromHex(st_rsa_bn_t * const pRes, const char * const pHex);
+
+/** @def Handeling name mangle */
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __RSA_BN_H__ */
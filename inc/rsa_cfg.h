@@ -27,19 +27,195 @@ extern "C" {
 *--------------------------------------------------------------------------------------
 **/
 
+/** @defgroup Configuration parameters values, defined ahead of the flags using them */
+#define DEBUGGING_INACTIVE          (0x00u)
+#define DEBUGGING_ACTIVE            (0x01u)
+
+#define FULL_ASSERTION_INACTIVE     (0x00u)
+#define FULL_ASSERTION_ACTIVE       (0x01u)
+
+#define TRACING_INACTIVE            (0x00u)
+#define TRACING_ACTIVE              (0x01u)
+
+#define STATS_INACTIVE              (0x00u)
+#define STATS_ACTIVE                (0x01u)
+
+#define FIXED_KERNELS_INACTIVE      (0x00u)
+#define FIXED_KERNELS_ACTIVE        (0x01u)
+
+#define PRIME64_TEST_MILLER_RABIN   (0x00u)
+#define PRIME64_TEST_BAILLIE_PSW    (0x01u)
+
+#define SIMD_PRIME_TEST_INACTIVE    (0x00u)
+#define SIMD_PRIME_TEST_ACTIVE      (0x01u)
+
 /**
  * @defgroup Configuration Parameters
- *      @arg DEBUGGING_ACTIVE
- *      @arg DEBUGGING_INACTIVE
+ *      @arg DEBUGGING_ACTIVE, the library prints its diagnostics to stderr
+ *      @arg DEBUGGING_INACTIVE, the library stays silent, use RSA_TRACE for timing
  */
-#define DEBUGGING_FLAG              (DEBUGGING_ACTIVE)
+#define DEBUGGING_FLAG              (DEBUGGING_INACTIVE)
 /**
  * @defgroup Configuration Parameters
  *      @arg FULL_ASSERTION_ACTIVE
  *      @arg FULL_ASSERTION_INACTIVE
  */
 #define FULL_ASSERTION_FLAG         (FULL_ASSERTION_ACTIVE)
+/**
+ * @defgroup Configuration Parameters
+ *      @arg TRACING_ACTIVE, the trace points are compiled in and enabled at runtime
+ *      @arg TRACING_INACTIVE, the trace points compile to nothing
+ */
+#define TRACING_FLAG                (TRACING_ACTIVE)
+/**
+ * @defgroup Configuration Parameters
+ *      @arg STATS_ACTIVE, the performance counters read by rsa_get_stats() are compiled in
+ *      @arg STATS_INACTIVE, the counters compile to nothing and rsa_get_stats() reports zeros
+ */
+#define STATS_FLAG                  (STATS_ACTIVE)
+/**
+ * @defgroup Configuration Parameters
+ *      @arg FIXED_KERNELS_ACTIVE, moduli of the usual key sizes run the unrolled C++ kernels
+ *      @arg FIXED_KERNELS_INACTIVE, every modulus runs the generic limbs loops
+ */
+#define FIXED_KERNELS_FLAG          (FIXED_KERNELS_ACTIVE)
+/**
+ * @defgroup Configuration Parameters
+ *      @arg PRIME64_TEST_MILLER_RABIN, single word primes use the deterministic Miller-Rabin bases
+ *      @arg PRIME64_TEST_BAILLIE_PSW, single word primes use a base 2 round and a strong Lucas test
+ */
+#define PRIME64_TEST_FLAG           (PRIME64_TEST_MILLER_RABIN)
+/**
+ * @defgroup Configuration Parameters
+ *      @arg SIMD_PRIME_TEST_ACTIVE, the prime search filters its candidates by a base 2 round
+ *           running several candidates per AVX2 or AVX-512 vector when the CPU has them
+ *      @arg SIMD_PRIME_TEST_INACTIVE, every candidate goes through the scalar test alone
+ */
+#define SIMD_PRIME_TEST_FLAG        (SIMD_PRIME_TEST_ACTIVE)
+
+
+/*
+*--------------------------------------------------------------------------------------
+*- Key Configuration parameters
+*--------------------------------------------------------------------------------------
+**/
+
+/**
+ * @brief Modulus size in bits used by generate_keys().
+ */
+#define RSA_KEY_BITS 								(2048u)
+/**
+ * @brief Largest supported modulus size in bits, it sizes the fixed limb
+ * 				storage of every multi-precision number (multiple of 64).
+ */
+#define RSA_MAX_KEY_BITS 						(4096u)
+/**
+ * @brief Default public exponent of the generated keys (odd, at least 3).
+ * 				Keys too small for it fall back to the smallest e co-prime to phi.
+ */
+#define RSA_PUBLIC_EXPONENT 				(65537u)
+/**
+ * @brief Default number of primes of the generated keys, more primes make
+ * 				every CRT exponentiation of the private key operations smaller.
+ */
+#define RSA_NUM_OF_PRIMES 					(2u)
+/**
+ * @brief Largest number of primes of a key, it sizes the CRT storage of
+ * 				every context (at least 2).
+ */
+#define RSA_MAX_PRIMES 							(4u)
+/**
+ * @brief Default number of threads searching the key primes concurrently,
+ * 				0 uses every online core and 1 keeps the search on the caller thread.
+ * 				Changed per context by rsa_ctx_set_search_threads().
+ */
+#define RSA_PRIME_SEARCH_THREADS 				(0u)
+
+/*
+*--------------------------------------------------------------------------------------
+*- Arithmetic Configuration parameters
+*--------------------------------------------------------------------------------------
+**/
 
+/**
+ * @brief Operand size in 64-bit limbs from which the multiplication and
+ * 				squaring switch from comba to karatsuba.
+ */
+#define RSA_BN_KARATSUBA_THRESHOLD 	(32u)
+
+/**
+ * @brief Number of odd candidates covered by one prime search sieve window.
+ */
+#define RSA_PRIME_SIEVE_WINDOW 			(4096u)
+
+/**
+ * @brief Single word candidates whose base 2 round runs in lockstep in
+ * 				prime64TestBatch().
+ */
+#define RSA_PRIME64_LANES 						(0x04u)
+
+/*
+*--------------------------------------------------------------------------------------
+*- Pipeline Configuration parameters
+*--------------------------------------------------------------------------------------
+**/
+
+/**
+ * @brief Number of block mode blocks processed by a worker per file chunk.
+ */
+#define RSA_PIPE_CHUNK_BLOCKS 				(0x40u)
+/**
+ * @brief Chunk buffers in flight per worker, bounds the pipeline memory
+ * 				independently of the file size.
+ */
+#define RSA_PIPE_SLOTS_PER_WORKER 		(0x02u)
+
+/*
+*--------------------------------------------------------------------------------------
+*- Executor Configuration parameters
+*--------------------------------------------------------------------------------------
+**/
+
+/**
+ * @brief Blocks per piece below which an encryption or decryption job is
+ * 				not split further, a piece must outweigh a steal.
+ */
+#define RSA_EXEC_SPLIT_BLOCKS 				(0x04u)
+
+/*
+*--------------------------------------------------------------------------------------
+*- Key pool Configuration parameters
+*--------------------------------------------------------------------------------------
+**/
+
+/**
+ * @brief Defaults of rsa_pool_cfg_default(), the generators refill the pool
+ * 				up to the high watermark once fewer than the low watermark keys are left.
+ */
+#define RSA_POOL_LOW_WATERMARK 				(0x04u)
+#define RSA_POOL_HIGH_WATERMARK 			(0x10u)
+#define RSA_POOL_THREADS 							(0x01u)
+
+/*
+*--------------------------------------------------------------------------------------
+*- Tracing Configuration parameters
+*--------------------------------------------------------------------------------------
+**/
+
+/**
+ * @brief Records kept per thread before the oldest are overwritten (power of two).
+ */
+#define RSA_TRACE_RING_EVENTS 				(0x400u)
+/**
+ * @brief Threads alive at the same time that get a trace ring, the rings of
+ *        exited threads are reused, threads past that are not traced.
+ */
+#define RSA_TRACE_MAX_THREADS 				(0x40u)
+/**
+ * @brief Threads alive at the same time that get their own counters block,
+ *        the blocks of exited threads are reused, threads past that share one.
+ */
+#define RSA_STATS_MAX_THREADS 				(0x40u)
 
 /*
 *--------------------------------------------------------------------------------------
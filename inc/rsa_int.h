@@ -8,8 +8,55 @@
  * @copyright Copyright (c) Wx 2023
  * 
  * @attention
- *      @todo
- * 
+ *      Every key lives in its own rsa_ctx_t, the library keeps no global
+ *      state so independent contexts can be used from different threads
+ *      without locking. A single context must not be generated into while
+ *      another thread uses it.
+ *      Block mode format, for a modulus of k bytes every k bytes ciphertext
+ *      block decrypts to k - 1 big endian bytes: a 2 bytes payload length L
+ *      (L <= k - 3), L message bytes and zero padding. The leading zero byte
+ *      keeps every block below n.
+ *      Memory is only taken when a context, its byte table or a file
+ *      pipeline is created, through the allocator given to
+ *      rsa_ctx_create_with(). Encryption and decryption write into caller
+ *      buffers and never allocate.
+ *      The byte-wise format encrypts every byte on its own, so a key only
+ *      has 256 ciphertext blocks. rsa_ctx_enable_byte_table() computes them
+ *      once, the byte-wise calls of the context then copy and look up blocks
+ *      with no exponentiation, the ciphertexts are unchanged.
+ *      Keys are generated with e = RSA_PUBLIC_EXPONENT unless changed by
+ *      rsa_ctx_set_public_exponent(), and with RSA_NUM_OF_PRIMES primes unless
+ *      changed by rsa_ctx_set_num_of_primes(). A multi-prime key decrypts and
+ *      signs with one exponentiation per prime, each over a smaller modulus
+ *      and exponent, its public half is the same as a two prime key.
+ *      The primes are searched on RSA_PRIME_SEARCH_THREADS threads unless
+ *      changed by rsa_ctx_set_search_threads(). The key pool generators and
+ *      the executor generate jobs already run side by side, each of their
+ *      keys is searched on its own thread.
+ *      rsa_pubkey_create() copies the public half of a key with its
+ *      precomputation into a handle that can encrypt on its own, the
+ *      montgomery constants and the window layout of e are derived once per
+ *      key instead of once per block.
+ *      Signatures are RSASSA-PKCS1-v1_5 over SHA-256 and take the size of the
+ *      modulus, keys below 496 bits are too small to sign. The batch
+ *      verification settles every item on its own in pResults, the
+ *      signatures sharing a key handle are opened together on the SIMD lanes.
+ *      The file pipeline streams block mode chunks through a reader, a pool
+ *      of workers and an ordered writer, its memory use only depends on the
+ *      key size and the worker count.
+ *      rsa_store_write() saves many keys with their precomputation to a binary
+ *      key store, rsa_store_open() maps it and rsa_store_find() returns a key
+ *      usable in place, no key is parsed or derived when loading.
+ *      rsa_exec_create() starts a work-stealing executor, key generation,
+ *      encryption and decryption jobs submitted to it complete through a
+ *      callback or are polled, long jobs are split across the executor
+ *      threads. The job control blocks belong to the caller, submitting a
+ *      job never allocates.
+ *      rsa_pool_create() starts background threads keeping pre-generated keys
+ *      ready, rsa_pool_take() hands one over without blocking, so a caller
+ *      does not pay for the prime search.
+ *      Tracing and the performance counters are the only process wide state,
+ *      rsa_trace_enable() and rsa_reset_stats() apply to every thread.
  * 
  */
 /** @def Header guards */
@@ -27,12 +74,140 @@ extern "C" {
 *--------------------------------------------------------------------------------------
 **/
 
+/** @brief Buckets of the key generation latency histogram */
+#define RSA_STATS_KEYGEN_BUCKETS 			(0x20u)
+/** @brief Pieces an encryption or decryption job is split into at most */
+#define RSA_JOB_MAX_SPLITS 						(0x20u)
+
 /*
 *--------------------------------------------------------------------------------------
 *- Data types
 *--------------------------------------------------------------------------------------
 **/
 
+/**
+ * @brief Allocation hooks, pfAlloc returns `size` bytes aligned to `align`
+ * 			  (a power of two) or NULL. pUser is handed back to both hooks.
+*/
+typedef struct rsa_allocator
+{
+	void *(*pfAlloc)(void *pUser, const size_t size, const size_t align);
+	void (*pfFree)(void *pUser, void *pMem);
+	void *pUser;
+}rsa_allocator_t;
+
+/**
+ * @brief Bump arena over a caller buffer, not thread safe.
+*/
+typedef struct rsa_arena
+{
+	uint8_t *pBase;
+	size_t size;
+	size_t used;
+}rsa_arena_t;
+
+/**
+ * @brief Performance counters summed over every thread, all the fields are
+ * 			  64-bit counters.
+*/
+typedef struct rsa_stats
+{
+	uint64_t montMultiplies; 		/* Multi-precision montgomery multiplications */
+	uint64_t montSquarings;
+	uint64_t powModCalls; 			/* Modular exponentiations, one per multi-buffer lane */
+	uint64_t mrRounds; 					/* Miller-Rabin witnesses tried */
+	uint64_t primeCandidates; 	/* Prime search candidates */
+	uint64_t sieveRejected; 		/* Candidates rejected by the sieve */
+	uint64_t fermatRejected; 		/* Sieve survivors rejected by the base 2 fermat lanes */
+	uint64_t mrRejected; 				/* Candidates rejected by the primality test */
+	uint64_t primesFound;
+	uint64_t gcdIterations; 		/* Euclid steps of the gcd and modular inverse */
+	uint64_t bytesEncrypted; 		/* Message bytes */
+	uint64_t bytesDecrypted;
+	uint64_t keygens;
+	uint64_t keygenTotalNs;
+	uint64_t keygenHistogram[RSA_STATS_KEYGEN_BUCKETS]; /* Bucket i: latency below 2^i ms, above bucket i - 1 */
+}rsa_stats_t;
+
+/**
+ * @brief Key pool settings, see rsa_pool_cfg_default().
+*/
+typedef struct rsa_pool_cfg
+{
+	uint32_t keyBits;
+	uint32_t lowWatermark; 							/* Refill starts when fewer keys are left (at least 1) */
+	uint32_t highWatermark; 						/* Keys kept ready once refilled */
+	uint32_t numOfThreads; 							/* Generator threads, up to 16 */
+	uint64_t publicExponent;
+	uint32_t numOfPrimes; 							/* Primes per key, 2 to RSA_MAX_PRIMES */
+	const rsa_allocator_t *pAllocator; 	/* Thread safe allocator, NULL for the default one */
+}rsa_pool_cfg_t;
+
+/** @brief Opaque key context */
+typedef struct rsa_parameters rsa_ctx_t;
+/** @brief Opaque public key handle, holds no private material */
+typedef struct rsa_pubkey rsa_pubkey_t;
+/** @brief Opaque background key pool */
+typedef struct rsa_pool rsa_pool_t;
+/** @brief Opaque mapped key store */
+typedef struct rsa_store rsa_store_t;
+/** @brief Opaque work-stealing executor */
+typedef struct rsa_exec rsa_exec_t;
+
+typedef enum en_rsa_status
+{
+	rsaStatusOk = 0x00u,
+	rsaStatusNullArgument,
+	rsaStatusInvalidKeySize,
+	rsaStatusNoKey,
+	rsaStatusNoMemory,
+	rsaStatusKeyFailure,
+	rsaStatusInvalidCipher,
+	rsaStatusIoError,
+	rsaStatusInvalidKeyFile,
+	rsaStatusInvalidArgument,
+	rsaStatusInvalidSignature
+}en_rsa_status_t;
+
+typedef enum en_rsa_job_type
+{
+	rsaJobGenerate = 0x00u,
+	rsaJobEncrypt, 					/* Block mode */
+	rsaJobDecrypt 					/* Block mode */
+}en_rsa_job_type_t;
+
+typedef struct rsa_job rsa_job_t;
+
+/** @brief Completion callback, called once from an executor thread before
+ * 				the job is marked done */
+typedef void (*rsa_job_done_t)(rsa_job_t *pJob, const en_rsa_status_t status, void *pUser);
+
+/**
+ * @brief Job control block owned by the caller, filled by rsa_exec_submit_*()
+ * 			  and left alone until the job is done. The fields are private to
+ * 				the executor, the job is read through rsa_job_done() and rsa_job_wait().
+*/
+struct rsa_job
+{
+	en_rsa_job_type_t type;
+	rsa_ctx_t *pCtx; 													/* Only written by generate jobs */
+	const uint8_t *pIn;
+	uint64_t inLen;
+	uint8_t *pOut;
+	uint64_t *pOutLen;
+	uint32_t keyBits;
+	rsa_job_done_t pfDone;
+	void *pUser;
+	rsa_exec_t *pExec;
+	rsa_job_t *pNext; 												/* Submission queue link */
+	en_rsa_status_t status;
+	uint32_t done;
+	uint32_t refs; 														/* Executor threads holding the job */
+	uint32_t nextSplit; 											/* Next piece to be claimed */
+	uint32_t numOfSplits;
+	uint64_t splitBlocks; 										/* Blocks per piece */
+	uint64_t splitLens[RSA_JOB_MAX_SPLITS]; 	/* Message bytes of every decrypted piece */
+};
 
 /*
 *--------------------------------------------------------------------------------------
@@ -40,6 +215,194 @@ extern "C" {
 *--------------------------------------------------------------------------------------
 **/
 
+rsa_allocator_t
+rsa_allocator_default(void);
+
+void
+rsa_arena_init(rsa_arena_t * const pArena, void * const pBuf, const size_t size);
+
+void *
+rsa_arena_alloc(rsa_arena_t * const pArena, const size_t size, const size_t align);
+
+void
+rsa_arena_reset(rsa_arena_t * const pArena);
+
+rsa_allocator_t
+rsa_arena_allocator(rsa_arena_t * const pArena);
+
+rsa_ctx_t *
+rsa_ctx_create(void);
+
+rsa_ctx_t *
+rsa_ctx_create_with(const rsa_allocator_t * const pAllocator);
+
+void
+rsa_ctx_destroy(rsa_ctx_t * const pCtx);
+
+en_rsa_status_t
+rsa_ctx_set_public_exponent(rsa_ctx_t * const pCtx, const uint64_t e);
+
+en_rsa_status_t
+rsa_ctx_set_num_of_primes(rsa_ctx_t * const pCtx, const uint32_t numOfPrimes);
+
+en_rsa_status_t
+rsa_ctx_set_search_threads(rsa_ctx_t * const pCtx, const uint32_t numOfThreads);
+
+en_rsa_status_t
+rsa_ctx_generate(rsa_ctx_t * const pCtx, const uint32_t keyBits);
+
+uint64_t
+rsa_ctx_cipher_size(const rsa_ctx_t * const pCtx, const uint64_t msgLen);
+
+en_rsa_status_t
+rsa_ctx_encrypt(const rsa_ctx_t * const pCtx, const uint8_t * const pMsg,
+                const uint64_t msgLen, uint8_t * const pCipher);
+
+en_rsa_status_t
+rsa_ctx_encrypt_batch(const rsa_ctx_t * const pCtx, const uint8_t * const * const ppMsgs,
+                      const uint64_t * const pMsgLens, const uint32_t numOfMsgs,
+                      uint8_t * const * const ppCiphers);
+
+en_rsa_status_t
+rsa_ctx_decrypt(const rsa_ctx_t * const pCtx, const uint8_t * const pCipher,
+                const uint64_t msgLen, uint8_t * const pMsg);
+
+en_rsa_status_t
+rsa_ctx_enable_byte_table(rsa_ctx_t * const pCtx);
+
+void
+rsa_ctx_disable_byte_table(rsa_ctx_t * const pCtx);
+
+uint64_t
+rsa_ctx_block_cipher_size(const rsa_ctx_t * const pCtx, const uint64_t msgLen);
+
+en_rsa_status_t
+rsa_ctx_encrypt_blocks(const rsa_ctx_t * const pCtx, const uint8_t * const pMsg,
+                       const uint64_t msgLen, uint8_t * const pCipher);
+
+en_rsa_status_t
+rsa_ctx_decrypt_blocks(const rsa_ctx_t * const pCtx, const uint8_t * const pCipher,
+                       const uint64_t cipherLen, uint8_t * const pMsg, uint64_t * const pMsgLen);
+
+rsa_pubkey_t *
+rsa_pubkey_create(const rsa_ctx_t * const pCtx);
+
+void
+rsa_pubkey_destroy(rsa_pubkey_t * const pKey);
+
+uint64_t
+rsa_pubkey_block_cipher_size(const rsa_pubkey_t * const pKey, const uint64_t msgLen);
+
+en_rsa_status_t
+rsa_pubkey_encrypt_blocks(const rsa_pubkey_t * const pKey, const uint8_t * const pMsg,
+                          const uint64_t msgLen, uint8_t * const pCipher);
+
+uint64_t
+rsa_ctx_signature_size(const rsa_ctx_t * const pCtx);
+
+en_rsa_status_t
+rsa_ctx_sign(const rsa_ctx_t * const pCtx, const uint8_t * const pMsg,
+             const uint64_t msgLen, uint8_t * const pSig);
+
+en_rsa_status_t
+rsa_ctx_verify(const rsa_ctx_t * const pCtx, const uint8_t * const pMsg,
+               const uint64_t msgLen, const uint8_t * const pSig);
+
+en_rsa_status_t
+rsa_pubkey_verify(const rsa_pubkey_t * const pKey, const uint8_t * const pMsg,
+                  const uint64_t msgLen, const uint8_t * const pSig);
+
+en_rsa_status_t
+rsa_pubkey_verify_batch(const rsa_pubkey_t * const * const ppKeys, const uint8_t * const * const ppMsgs,
+                        const uint64_t * const pMsgLens, const uint8_t * const * const ppSigs,
+                        const uint32_t numOfItems, en_rsa_status_t * const pResults);
+
+en_rsa_status_t
+rsa_ctx_save(const rsa_ctx_t * const pCtx, const char * const pPath);
+
+en_rsa_status_t
+rsa_ctx_load(rsa_ctx_t * const pCtx, const char * const pPath);
+
+en_rsa_status_t
+rsa_store_write(const char * const pPath, const rsa_ctx_t * const * const ppCtxs,
+                const uint64_t * const pIds, const uint64_t numOfKeys);
+
+en_rsa_status_t
+rsa_store_open(rsa_store_t ** const ppStore, const char * const pPath);
+
+void
+rsa_store_close(rsa_store_t * const pStore);
+
+const rsa_ctx_t *
+rsa_store_find(const rsa_store_t * const pStore, const uint64_t id);
+
+uint64_t
+rsa_store_count(const rsa_store_t * const pStore);
+
+en_rsa_status_t
+rsa_pipe_encrypt_file(const rsa_ctx_t * const pCtx, const char * const pInPath,
+                      const char * const pOutPath, const uint32_t numOfWorkers);
+
+en_rsa_status_t
+rsa_pipe_decrypt_file(const rsa_ctx_t * const pCtx, const char * const pInPath,
+                      const char * const pOutPath, const uint32_t numOfWorkers);
+
+rsa_exec_t *
+rsa_exec_create(const uint32_t numOfWorkers, const rsa_allocator_t * const pAllocator);
+
+void
+rsa_exec_destroy(rsa_exec_t * const pExec);
+
+en_rsa_status_t
+rsa_exec_submit_generate(rsa_exec_t * const pExec, rsa_job_t * const pJob, rsa_ctx_t * const pCtx,
+                         const uint32_t keyBits, const rsa_job_done_t pfDone, void * const pUser);
+
+en_rsa_status_t
+rsa_exec_submit_encrypt(rsa_exec_t * const pExec, rsa_job_t * const pJob, const rsa_ctx_t * const pCtx,
+                        const uint8_t * const pMsg, const uint64_t msgLen, uint8_t * const pCipher,
+                        const rsa_job_done_t pfDone, void * const pUser);
+
+en_rsa_status_t
+rsa_exec_submit_decrypt(rsa_exec_t * const pExec, rsa_job_t * const pJob, const rsa_ctx_t * const pCtx,
+                        const uint8_t * const pCipher, const uint64_t cipherLen, uint8_t * const pMsg,
+                        uint64_t * const pMsgLen, const rsa_job_done_t pfDone, void * const pUser);
+
+uint8_t
+rsa_job_done(const rsa_job_t * const pJob);
+
+en_rsa_status_t
+rsa_job_wait(rsa_job_t * const pJob);
+
+rsa_pool_cfg_t
+rsa_pool_cfg_default(const uint32_t keyBits);
+
+rsa_pool_t *
+rsa_pool_create(const rsa_pool_cfg_t * const pCfg);
+
+void
+rsa_pool_destroy(rsa_pool_t * const pPool);
+
+rsa_ctx_t *
+rsa_pool_take(rsa_pool_t * const pPool);
+
+uint32_t
+rsa_pool_available(const rsa_pool_t * const pPool);
+
+void
+rsa_get_stats(rsa_stats_t * const pStats);
+
+void
+rsa_reset_stats(void);
+
+void
+rsa_trace_enable(const uint8_t enable);
+
+en_rsa_status_t
+rsa_trace_save(const char * const pPath);
+
+en_rsa_status_t
+rsa_trace_dump(const char * const pPath);
+
 void 
 generate_keys(const uint8_t * const pString);
 
@@ -0,0 +1,78 @@
+/**
+ * @file rsa_mb.h
+ * @author Mohamed ashraf (wx@wx.com)
+ * @brief rsa multi-buffer montgomery interface file
+ * @version 0.1
+ * @date 2023-01-01
+ *
+ * @copyright Copyright (c) Wx 2023
+ *
+ * @attention
+ *      Runs RSA_MB_LANES independent exponentiations under the same modulus
+ *      and exponent, one per SIMD lane. Numbers are held in radix 2^29 so
+ *      the 32x32 -> 64 bit lane multiplier never overflows the accumulators.
+ *      mbFermatBase2() runs the base 2 round of the prime search with a
+ *      different candidate in every lane, 8 lanes on AVX-512 and 4 on AVX2.
+ *      The header must be included after `rsa_cfg.h`, `rsa_prv.h` and `rsa_bn.h`.
+ *
+ */
+/** @def Header guards */
+#ifndef __RSA_MB_H__
+#define __RSA_MB_H__
+
+/** @def Handeling name mangle */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+*--------------------------------------------------------------------------------------
+*- Macros
+*--------------------------------------------------------------------------------------
+**/
+
+#define RSA_MB_LANES 							(0x04u)
+/** @brief Lanes of the widest prime filter kernel */
+#define RSA_MB_MAX_PRIME_LANES 		(0x08u)
+#define RSA_MB_DIGIT_BITS 				(29u)
+#define RSA_MB_DIGIT_MASK 				((0x01ull << RSA_MB_DIGIT_BITS) - 0x01u)
+/** @brief Digits needed by the largest modulus, R must exceed 4n */
+#define RSA_MB_MAX_DIGITS 				(((RSA_MAX_KEY_BITS + 0x02u) + RSA_MB_DIGIT_BITS - 0x01u) / RSA_MB_DIGIT_BITS)
+
+/*
+*--------------------------------------------------------------------------------------
+*- Data types
+*--------------------------------------------------------------------------------------
+**/
+
+/**
+ * @brief Per-modulus context of the multi-buffer engine, R = 2^(29 * digits).
+*/
+typedef struct rsa_mb_mont
+{
+	uint64_t n[RSA_MB_MAX_DIGITS]; 		/* Radix 2^29 digits of n */
+	uint64_t rr[RSA_MB_MAX_DIGITS]; 	/* R^2 mod n, used to enter the montgomery domain */
+	st_rsa_bn_t modulus; 							/* n, used by the final correction */
+	uint64_t n0inv; 									/* -n^-1 mod 2^29 */
+	uint32_t digits;
+}st_rsa_mb_mont_t;
+
+/*
+*--------------------------------------------------------------------------------------
+*- Functions Declaration
+*--------------------------------------------------------------------------------------
+**/
+
+uint8_t mbIsAvailable(void);
+uint32_t mbPrimeLanes(void);
+void mbMontInit(st_rsa_mb_mont_t * const pMbMont, const st_rsa_bn_mont_t * const pMont);
+void mbPowMod(const st_rsa_mb_mont_t * const pMbMont, st_rsa_bn_t * const pRes,
+              const st_rsa_bn_t * const pBase, const st_rsa_bn_t * const pExp);
+void mbFermatBase2(const st_rsa_bn_t * const pCandidates, uint8_t * const pPass, const uint32_t count);
+
+/** @def Handeling name mangle */
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __RSA_MB_H__ */
@@ -0,0 +1,61 @@
+/**
+ * @file rsa_mod.h
+ * @author Mohamed ashraf (wx@wx.com)
+ * @brief rsa fixed size montgomery kernels, C interface file
+ * @version 0.1
+ * @date 2023-01-01
+ *
+ * @copyright Copyright (c) Wx 2023
+ *
+ * @attention
+ *      The kernels are instances of rsa::modulus<Bits> (`rsa_mod.hpp`) for
+ *      the limb counts of the supported key sizes and of their CRT halves.
+ *      The montgomery operations look them up by the limb count of the
+ *      modulus, every other size keeps the generic limbs loops.
+ *      The header must be included after `rsa_cfg.h`.
+ *
+ */
+/** @def Header guards */
+#ifndef __RSA_MOD_H__
+#define __RSA_MOD_H__
+
+/** @def Handeling name mangle */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+*--------------------------------------------------------------------------------------
+*- Data types
+*--------------------------------------------------------------------------------------
+**/
+
+/**
+ * @brief Montgomery multiplication and squaring of a fixed number of limbs,
+ * 			  pRes may alias the operands. pfMontMul is NULL for the sizes where
+ * 				the generic multiplication is faster.
+*/
+typedef struct rsa_mod_kernels
+{
+	uint32_t len; 			/* Number of 64-bit limbs of the modulus */
+	void (*pfMontMul)(uint64_t * const pRes, const uint64_t * const pA, const uint64_t * const pB,
+	                  const uint64_t * const pN, const uint64_t n0inv);
+	void (*pfMontSqr)(uint64_t * const pRes, const uint64_t * const pA,
+	                  const uint64_t * const pN, const uint64_t n0inv);
+}st_rsa_mod_kernels_t;
+
+/*
+*--------------------------------------------------------------------------------------
+*- Functions Declaration
+*--------------------------------------------------------------------------------------
+**/
+
+const st_rsa_mod_kernels_t *
+modGetKernels(const uint32_t len);
+
+/** @def Handeling name mangle */
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __RSA_MOD_H__ */
@@ -0,0 +1,255 @@
+/**
+ * @file rsa_mod.hpp
+ * @author Mohamed ashraf (wx@wx.com)
+ * @brief rsa fixed size montgomery arithmetic, C++ template layer
+ * @version 0.1
+ * @date 2023-01-01
+ *
+ * @copyright Copyright (c) Wx 2023
+ *
+ * @attention
+ *      rsa::modulus<Bits> fixes the limb count at compile time, every loop
+ *      over the limbs has a constant trip count and is unrolled by the
+ *      compiler. The operands are raw little endian limb arrays of exactly
+ *      `limbs` words below n, results may alias the operands.
+ *      The C code reaches the kernels through `rsa_mod.h`, this header is
+ *      only included by C++ translation units.
+ *
+ */
+/** @def Header guards */
+#ifndef __RSA_MOD_HPP__
+#define __RSA_MOD_HPP__
+
+#include <stdint.h>
+#include <string.h>
+
+namespace rsa
+{
+
+/*
+*--------------------------------------------------------------------------------------
+*- Compile time helpers
+*--------------------------------------------------------------------------------------
+**/
+
+/** @brief Double word used by the multiply and reduce kernels */
+typedef unsigned __int128 dword_t;
+
+/**
+ * @brief -n0^-1 mod 2^64 by newton iterations, each one doubles the correct
+ * 			  low bits of `inv` (an odd n0 is its own inverse modulo 8).
+ */
+constexpr uint64_t
+negInverse(const uint64_t n0, const uint64_t inv = 0x00u, const uint32_t steps = 0x05u)
+{
+	return (0x00u == inv) ? (negInverse(n0, n0, steps)) :
+	       (0x00u == steps) ? (0x00u - inv) :
+	       (negInverse(n0, inv * (0x02u - (n0 * inv)), steps - 0x01u));
+}/* negInverse */
+
+static_assert((uint64_t) (negInverse(0x03u) * 0x03u) == ~(uint64_t) 0x00u, "negInverse is broken");
+static_assert((uint64_t) (negInverse(0xFFFFFFFFFFFFFFC5ull) * 0xFFFFFFFFFFFFFFC5ull) == ~(uint64_t) 0x00u,
+              "negInverse is broken");
+
+/*
+*--------------------------------------------------------------------------------------
+*- Data types
+*--------------------------------------------------------------------------------------
+**/
+
+/**
+ * @brief Odd modulus of exactly `Bits` bits with its montgomery constant,
+ * 			  R = 2^Bits. The modulus limbs are borrowed, not copied.
+ */
+template<uint32_t Bits>
+class modulus
+{
+public:
+	static_assert((Bits > 0x00u) && (0x00u == (Bits % 64u)), "Bits must be a non zero multiple of 64");
+
+	static constexpr uint32_t bits = Bits;
+	static constexpr uint32_t limbs = Bits / 64u;
+	static constexpr uint32_t wideLimbs = limbs * 0x02u;
+
+	modulus(const uint64_t * const pN, const uint64_t n0inv) : pN_(pN), n0inv_(n0inv) {}
+	explicit modulus(const uint64_t * const pN) : pN_(pN), n0inv_(negInverse(pN[0])) {}
+
+	/**
+	 * @brief pRes = pA * pB / R mod n, coarsely integrated operand scanning
+	 * 			  (CIOS): every product row is reduced right away so the working
+	 * 				set stays at limbs + 2 words.
+	 */
+	void
+	mul(uint64_t * const pRes, const uint64_t * const pA, const uint64_t * const pB) const
+	{
+		/* Function data types */
+		uint64_t t[limbs + 0x02u];
+		uint64_t m = 0x00u;
+		uint64_t carry = 0x00u;
+		dword_t p = 0x00u;
+		uint32_t i = 0x00u;
+		uint32_t j = 0x00u;
+
+		/* Function body */
+		memset(t, 0x00u, sizeof(t));
+
+		for(i = 0x00u; i < limbs; ++i)
+		{
+			/* t += a * b[i] */
+			carry = 0x00u;
+#pragma GCC unroll 64
+			for(j = 0x00u; j < limbs; ++j)
+			{
+				p = ((dword_t) pA[j] * pB[i]) + t[j] + carry;
+				t[j] = (uint64_t) p;
+				carry = (uint64_t) (p >> 64);
+			}
+			p = (dword_t) t[limbs] + carry;
+			t[limbs] = (uint64_t) p;
+			t[limbs + 0x01u] = (uint64_t) (p >> 64);
+
+			/* t = (t + m * n) / 2^64, m clears the low word */
+			m = t[0] * n0inv_;
+			p = ((dword_t) m * pN_[0]) + t[0];
+			carry = (uint64_t) (p >> 64);
+#pragma GCC unroll 64
+			for(j = 0x01u; j < limbs; ++j)
+			{
+				p = ((dword_t) m * pN_[j]) + t[j] + carry;
+				t[j - 0x01u] = (uint64_t) p;
+				carry = (uint64_t) (p >> 64);
+			}
+			p = (dword_t) t[limbs] + carry;
+			t[limbs - 0x01u] = (uint64_t) p;
+			t[limbs] = t[limbs + 0x01u] + (uint64_t) (p >> 64);
+		}
+
+		finalSubtract(pRes, t, t[limbs]);
+	}/* mul */
+
+	/**
+	 * @brief pRes = pA^2 / R mod n, the cross products are computed once and
+	 * 			  doubled before the diagonal is added, then reduced.
+	 */
+	void
+	sqr(uint64_t * const pRes, const uint64_t * const pA) const
+	{
+		/* Function data types */
+		uint64_t t[wideLimbs];
+		uint64_t carry = 0x00u;
+		uint64_t word = 0x00u;
+		dword_t p = 0x00u;
+		dword_t s = 0x00u;
+		uint32_t i = 0x00u;
+		uint32_t j = 0x00u;
+
+		/* Function body */
+		memset(t, 0x00u, sizeof(t));
+
+		/* Cross products a[i] * a[j], i < j */
+		for(i = 0x00u; i < limbs; ++i)
+		{
+			carry = 0x00u;
+			for(j = i + 0x01u; j < limbs; ++j)
+			{
+				p = ((dword_t) pA[i] * pA[j]) + t[i + j] + carry;
+				t[i + j] = (uint64_t) p;
+				carry = (uint64_t) (p >> 64);
+			}
+			t[i + limbs] = carry;
+		}
+
+		/* Doubling */
+		carry = 0x00u;
+#pragma GCC unroll 128
+		for(i = 0x00u; i < wideLimbs; ++i)
+		{
+			word = t[i];
+			t[i] = (word << 0x01u) | carry;
+			carry = word >> 63;
+		}
+
+		/* Diagonal a[i]^2 */
+		carry = 0x00u;
+#pragma GCC unroll 64
+		for(i = 0x00u; i < limbs; ++i)
+		{
+			p = (dword_t) pA[i] * pA[i];
+			s = (dword_t) t[i * 0x02u] + (uint64_t) p + carry;
+			t[i * 0x02u] = (uint64_t) s;
+			s = (dword_t) t[(i * 0x02u) + 0x01u] + (uint64_t) (p >> 64) + (uint64_t) (s >> 64);
+			t[(i * 0x02u) + 0x01u] = (uint64_t) s;
+			carry = (uint64_t) (s >> 64);
+		}
+
+		reduce(pRes, t);
+	}/* sqr */
+
+private:
+	/**
+	 * @brief pRes = pT / R mod n for a double width pT below n * R, pT is
+	 * 			  overwritten.
+	 */
+	void
+	reduce(uint64_t * const pRes, uint64_t * const pT) const
+	{
+		/* Function data types */
+		uint64_t topCarry = 0x00u;
+		uint64_t carry = 0x00u;
+		uint64_t m = 0x00u;
+		dword_t p = 0x00u;
+		uint32_t i = 0x00u;
+		uint32_t j = 0x00u;
+
+		/* Function body */
+		for(i = 0x00u; i < limbs; ++i)
+		{
+			m = pT[i] * n0inv_;
+			carry = 0x00u;
+#pragma GCC unroll 64
+			for(j = 0x00u; j < limbs; ++j)
+			{
+				p = ((dword_t) m * pN_[j]) + pT[i + j] + carry;
+				pT[i + j] = (uint64_t) p;
+				carry = (uint64_t) (p >> 64);
+			}
+			p = (dword_t) pT[i + limbs] + carry + topCarry;
+			pT[i + limbs] = (uint64_t) p;
+			topCarry = (uint64_t) (p >> 64);
+		}
+
+		finalSubtract(pRes, pT + limbs, topCarry);
+	}/* reduce */
+
+	/**
+	 * @brief pRes = pT - n when pT (with its carry word) is at least n, the
+	 * 			  value is below 2n so one subtraction is enough.
+	 */
+	void
+	finalSubtract(uint64_t * const pRes, const uint64_t * const pT, const uint64_t topCarry) const
+	{
+		/* Function data types */
+		uint64_t diff[limbs];
+		uint64_t borrow = 0x00u;
+		dword_t s = 0x00u;
+		uint32_t j = 0x00u;
+
+		/* Function body */
+#pragma GCC unroll 64
+		for(j = 0x00u; j < limbs; ++j)
+		{
+			s = (dword_t) pT[j] - pN_[j] - borrow;
+			diff[j] = (uint64_t) s;
+			borrow = (uint64_t) (s >> 64) & 0x01u;
+		}
+
+		memcpy(pRes, ( (topCarry) || (0x00u == borrow) ) ? (diff) : (pT), sizeof(diff));
+	}/* finalSubtract */
+
+	const uint64_t *pN_;
+	uint64_t n0inv_;
+};
+
+} /* namespace rsa */
+
+#endif /* __RSA_MOD_HPP__ */
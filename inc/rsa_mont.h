@@ -0,0 +1,198 @@
+/**
+ * @file rsa_mont.h
+ * @author Mohamed ashraf (wx@wx.com)
+ * @brief rsa montgomery arithmetic file (single word modulus)
+ * @version 0.1
+ * @date 2023-01-01
+ *
+ * @copyright Copyright (c) Wx 2023
+ *
+ * @attention
+ *      All the kernels assume an odd modulus `n` and operands already reduced
+ *      below `n`, the caller is responsible for keeping values in range.
+ *      The header must be included after `rsa_prv.h`.
+ *
+ */
+/** @def Header guards */
+#ifndef __RSA_MONT_H__
+#define __RSA_MONT_H__
+
+/** @def Handeling name mangle */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+*--------------------------------------------------------------------------------------
+*- Macros
+*--------------------------------------------------------------------------------------
+**/
+
+/** @brief Number of newton iterations needed to lift a 3-bit inverse to 64-bit */
+#define MONT_INV_ITERATIONS 		(0x05u)
+
+/*
+*--------------------------------------------------------------------------------------
+*- Data types
+*--------------------------------------------------------------------------------------
+**/
+
+/**
+ * @brief Per-modulus montgomery context, R = 2^64.
+*/
+typedef struct rsa_mont_parameters
+{
+	uint64_t n; 		/* Odd modulus */
+	uint64_t nInv; 	/* n^-1 mod R (the subtractive form of n') */
+	uint64_t r; 		/* R mod n, montgomery form of 1 */
+	uint64_t r2; 		/* R^2 mod n, used to enter the montgomery domain */
+}st_rsa_mont_t;
+
+/*
+*--------------------------------------------------------------------------------------
+*- Inline Functions Implementation
+*--------------------------------------------------------------------------------------
+**/
+
+/**
+ * @brief Initialize the montgomery context for an odd modulus.
+ * 			  The inverse is lifted using newton iterations `x = x * (2 - n * x)`,
+ * 				each iteration doubles the number of correct low bits.
+ */
+_STATIC_INLINE void
+montInit(st_rsa_mont_t * const pMont, const uint64_t n)
+{
+	/* Validating */
+#if (FULL_ASSERTION_FLAG == FULL_ASSERTION_ACTIVE)
+	STATIC_ASSERT((pMont != NULL), DEFAULT_EXIT_CODE);
+	STATIC_ASSERT((n & 0x01u), DEFAULT_EXIT_CODE);
+#endif
+	/* Function data types */
+	uint64_t inv = n;
+	uint8_t register i = 0x00u;
+
+	/* Function body */
+	for(; i < MONT_INV_ITERATIONS; ++i)
+	{ inv *= 0x02u - (n * inv); }
+
+	pMont->n = n;
+	pMont->nInv = inv;
+	pMont->r = (0x00u - n) % n;
+	pMont->r2 = (uint64_t) (((uint128_t) pMont->r * pMont->r) % n);
+}/* montInit */
+
+/**
+ * @brief Montgomery reduction, returns `T * R^-1 mod n` for `T < n * R`.
+ * 			  m = T * n^-1 mod R makes `T - m * n` divisible by R, the high word
+ * 				difference is then in the range (-n, n) and needs one correction.
+ */
+_STATIC_INLINE uint64_t
+montRedc(const st_rsa_mont_t * const pMont, const uint128_t T)
+{
+	uint64_t m = (uint64_t) T * pMont->nInv;
+	uint64_t mnHi = (uint64_t) (((uint128_t) m * pMont->n) >> 64);
+	uint64_t tHi = (uint64_t) (T >> 64);
+	uint64_t res = tHi - mnHi;
+
+	return (tHi < mnHi) ? (res + pMont->n) : (res);
+}/* montRedc */
+
+_STATIC_INLINE uint64_t
+montMul(const st_rsa_mont_t * const pMont, const uint64_t a, const uint64_t b)
+{
+	return montRedc(pMont, (uint128_t) a * b);
+}/* montMul */
+
+_STATIC_INLINE uint64_t
+montSqr(const st_rsa_mont_t * const pMont, const uint64_t a)
+{
+	return montRedc(pMont, (uint128_t) a * a);
+}/* montSqr */
+
+/**
+ * @brief Convert `a` into the montgomery domain (a * R mod n).
+ */
+_STATIC_INLINE uint64_t
+montToForm(const st_rsa_mont_t * const pMont, const uint64_t a)
+{
+	return montMul(pMont, a % pMont->n, pMont->r2);
+}/* montToForm */
+
+/**
+ * @brief Convert `a` out of the montgomery domain (a * R^-1 mod n).
+ */
+_STATIC_INLINE uint64_t
+montFromForm(const st_rsa_mont_t * const pMont, const uint64_t a)
+{
+	return montRedc(pMont, (uint128_t) a);
+}/* montFromForm */
+
+/**
+ * @brief Left-to-right sliding window exponentiation, base and result are
+ * 			  both in the montgomery domain (same scheme as the multi-precision
+ * 				engine, the window never exceeds 3 bits for a 64-bit exponent).
+ */
+_STATIC_INLINE uint64_t
+montPow(const st_rsa_mont_t * const pMont, const uint64_t base, const uint64_t exp)
+{
+	/* Function data types */
+	uint64_t table[0x01u << (RSA_EXP_WINDOW_BITS(64u) - 0x01u)];
+	uint64_t res = pMont->r;
+	const uint32_t bits = (exp) ? (64u - (uint32_t) __builtin_clzll(exp)) : (0x00u);
+	const uint32_t windowBits = RSA_EXP_WINDOW_BITS(bits);
+	const uint32_t tableSize = 0x01u << (windowBits - 0x01u);
+	uint8_t started = 0x00u;
+	int32_t register i = (int32_t) bits - 0x01;
+	int32_t register j = 0x00;
+	uint32_t register k = 0x00u;
+
+	/* Function body */
+	table[0] = base;
+	if( (tableSize > 0x01u) )
+	{
+		const uint64_t baseSqr = montSqr(pMont, base);
+		for(k = 0x01u; k < tableSize; ++k)
+		{ table[k] = montMul(pMont, table[k - 0x01u], baseSqr); }
+	}
+	else;
+
+	while( (i >= 0) )
+	{
+		if( (0x00u == ((exp >> i) & 0x01u)) )
+		{
+			res = montSqr(pMont, res);
+			--i;
+			continue;
+		}
+		else;
+
+		j = ((i - (int32_t) windowBits + 0x01) > 0) ? (i - (int32_t) windowBits + 0x01) : (0);
+		while( (0x00u == ((exp >> j) & 0x01u)) )
+		{ ++j; }
+
+		const uint32_t value = (uint32_t) ((exp >> j) & ((0x01ull << (i - j + 0x01)) - 0x01u));
+
+		if( (started) )
+		{
+			for(k = 0x00u; k <= (uint32_t) (i - j); ++k)
+			{ res = montSqr(pMont, res); }
+			res = montMul(pMont, res, table[value >> 0x01u]);
+		}
+		else
+		{
+			res = table[value >> 0x01u];
+			started = 0x01u;
+		}
+
+		i = j - 0x01;
+	}
+
+	return res;
+}/* montPow */
+
+/** @def Handeling name mangle */
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __RSA_MONT_H__ */
@@ -0,0 +1,91 @@
+/**
+ * @file rsa_prime.h
+ * @author Mohamed ashraf (wx@wx.com)
+ * @brief rsa prime search interface file
+ * @version 0.1
+ * @date 2023-01-01
+ *
+ * @copyright Copyright (c) Wx 2023
+ *
+ * @attention
+ *      The header must be included after `rsa_cfg.h` and `rsa_prv.h`.
+ *
+ */
+/** @def Header guards */
+#ifndef __RSA_PRIME_H__
+#define __RSA_PRIME_H__
+
+/** @def Handeling name mangle */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+*--------------------------------------------------------------------------------------
+*- Macros
+*--------------------------------------------------------------------------------------
+**/
+
+/** @brief Upper bound of the prime search worker threads */
+#define RSA_PRIME_MAX_THREADS 				(0x40u)
+/** @brief Upper bound of the primes found by one search (size of the found mask) */
+#define RSA_PRIME_MAX_SLOTS 					(0x20u)
+
+/*
+*--------------------------------------------------------------------------------------
+*- Data types
+*--------------------------------------------------------------------------------------
+**/
+
+/**
+ * @brief Prime search counters, every field is accumulated by the search.
+*/
+typedef struct rsa_prime_stats
+{
+	uint64_t candidates; 		/* Odd candidates examined */
+	uint64_t sieved; 				/* Candidates rejected by the small primes sieve */
+	uint64_t fermatRejected; 	/* Sieve survivors rejected by the base 2 fermat lanes */
+	uint64_t mrTested; 			/* Candidates that reached Miller-Rabin */
+	uint64_t windows; 			/* Sieve windows built */
+}st_rsa_prime_stats_t;
+
+/**
+ * @brief Incremental sieve over a window of odd candidates base + 2k,
+ * 			  the residues of base modulo every small prime are kept so moving
+ * 				to the next window only costs one addition per prime.
+*/
+typedef struct rsa_prime_sieve
+{
+	st_rsa_bn_t base; 														/* Candidate at window index 0 */
+	uint16_t residues[PRIME_NUMBERS_DB_SIZE]; 		/* base mod smallPrimes[i] */
+	uint8_t composite[RSA_PRIME_SIEVE_WINDOW]; 		/* Non zero when base + 2k has a small factor */
+	uint32_t index; 															/* Next window index to examine */
+	uint32_t numOfPrimes; 												/* Small primes below the candidates */
+	uint32_t bits;
+	st_rsa_prime_stats_t stats;
+}st_rsa_prime_sieve_t;
+
+/**
+ * @brief Primality test applied to the sieve survivors, it must be safe to
+ * 			  call from several threads at once.
+*/
+typedef en_PrimeNumbersStatus_t (*pf_rsa_prime_test_t)(const st_rsa_bn_t * const pCandidate);
+
+/*
+*--------------------------------------------------------------------------------------
+*- Functions Declaration
+*--------------------------------------------------------------------------------------
+**/
+
+void primeSieveInit(st_rsa_prime_sieve_t * const pSieve, const uint32_t bits);
+uint8_t primeSieveNext(st_rsa_prime_sieve_t * const pSieve, st_rsa_bn_t * const pCandidate);
+void primeSearch(st_rsa_bn_t * const pPrimes, const uint32_t * const pBits, const uint32_t numOfPrimes,
+                 const uint32_t numOfThreads, const pf_rsa_prime_test_t pfTest,
+                 st_rsa_prime_stats_t * const pStats);
+
+/** @def Handeling name mangle */
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __RSA_PRIME_H__ */
@@ -0,0 +1,43 @@
+/**
+ * @file rsa_prime64.h
+ * @author Mohamed ashraf (wx@wx.com)
+ * @brief rsa single word primality interface file
+ * @version 0.1
+ * @date 2023-01-01
+ *
+ * @copyright Copyright (c) Wx 2023
+ *
+ * @attention
+ *      Every test is deterministic over the whole 64-bit range, any value
+ *      (0, 1 and 2 included) is a valid input.
+ *      The header must be included after `rsa_cfg.h` and `rsa_prv.h`.
+ *
+ */
+/** @def Header guards */
+#ifndef __RSA_PRIME64_H__
+#define __RSA_PRIME64_H__
+
+/** @def Handeling name mangle */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+*--------------------------------------------------------------------------------------
+*- Functions Declaration
+*--------------------------------------------------------------------------------------
+**/
+
+/** @brief Primality test selected by PRIME64_TEST_FLAG */
+en_PrimeNumbersStatus_t prime64Test(const uint64_t num);
+en_PrimeNumbersStatus_t prime64MillerRabin(const uint64_t num);
+en_PrimeNumbersStatus_t prime64BailliePSW(const uint64_t num);
+uint32_t prime64TestBatch(const uint64_t * const pNums, en_PrimeNumbersStatus_t * const pStatus,
+                          const uint32_t count);
+
+/** @def Handeling name mangle */
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __RSA_PRIME64_H__ */
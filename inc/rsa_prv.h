@@ -71,15 +71,33 @@ extern "C" {
 #define _FORCE_INLINE __attribute__((always_inline))
 #define _FORCE_CONST __attribute__((const))
 
-/** @defgroup Configuration parameters macros */
-#define DEBUGGING_INACTIVE          (0x00u)
-#define DEBUGGING_ACTIVE            (0x01u)
+/** @defgroup Program macros */
+/** @brief Number of odd small primes held by the prime search sieve table */
+#define PRIME_NUMBERS_DB_SIZE 		(0x800u)
 
-#define FULL_ASSERTION_INACTIVE     (0x00u)
-#define FULL_ASSERTION_ACTIVE       (0x01u)
+/** @brief Big endian payload length stored at the head of every block of the block mode */
+#define RSA_BLOCK_HEADER_BYTES 		(0x02u)
 
-/** @defgroup Program macros */
-#define PRIME_NUMBERS_DB_SIZE 		(0x7Fu)
+/** @brief Size of the DER DigestInfo header put ahead of the SHA-256 hash of a signature */
+#define RSA_SIGNATURE_DIGEST_INFO_BYTES (0x13u)
+/** @brief Smallest modulus size able to carry the signature encoding, 0x00 0x01, 8 bytes
+ * 				of 0xFF padding, 0x00, the DigestInfo header and the hash */
+#define RSA_SIGNATURE_MIN_BYTES 	(0x0Bu + RSA_SIGNATURE_DIGEST_INFO_BYTES + 0x20u)
+/** @brief Items of a verification batch searched for signatures sharing a key */
+#define RSA_VERIFY_BATCH_WINDOW 	(0x40u)
+
+/** @brief Byte values of the byte-wise format, one ciphertext each per key */
+#define RSA_BYTE_TABLE_ENTRIES 		(0x100u)
+/** @brief Open addressing slots of the byte table index, twice the entries */
+#define RSA_BYTE_TABLE_SLOT_BITS 	(0x09u)
+#define RSA_BYTE_TABLE_SLOTS 			(0x01u << RSA_BYTE_TABLE_SLOT_BITS)
+#define RSA_BYTE_TABLE_HASH_MULTIPLIER (0x9E3779B97F4A7C15ull)
+
+/** @brief Largest sliding window, the odd powers table holds 2^(k - 1) entries */
+#define RSA_EXP_MAX_WINDOW_BITS 	(0x06u)
+/** @brief Sliding window size for an exponent of the given bit length */
+#define RSA_EXP_WINDOW_BITS(_BITS) (((_BITS) > 671u) ? (6u) : ((_BITS) > 239u) ? (5u) : \
+                                    ((_BITS) > 79u) ? (4u) : ((_BITS) > 23u) ? (3u) : (1u))
 
 /*
 *--------------------------------------------------------------------------------------
@@ -87,12 +105,54 @@ extern "C" {
 *--------------------------------------------------------------------------------------
 **/
 
+/** @brief Double word type used by the 64-bit multiply and reduce kernels */
+typedef unsigned __int128 uint128_t;
+
 typedef enum en_PrimeNumbersStatus
 {
 	numberNotPrime = 0x00u,
   numberIsPrime
 }en_PrimeNumbersStatus_t;
 
+/** @def Multi-precision types used by the algorithm parameters */
+#include "rsa_bn.h"
+#include "rsa_mb.h"
+/** @def Public types held by the context */
+#include "rsa_int.h"
+
+/**
+ * @brief Public half of a key together with the precomputation reused by
+ * 			  every encryption under it, n is held by the montgomery context.
+*/
+typedef struct rsa_public_key
+{
+	st_rsa_bn_mont_t montN; 			/* Montgomery context of n */
+	st_rsa_bn_t e;
+	st_rsa_bn_exp_plan_t ePlan; 	/* Sliding window layout of e */
+	uint32_t modulusBytes; 				/* Size of n in bytes, also the ciphertext block size */
+}st_rsa_pub_t;
+
+/**
+ * @brief Standalone public key handle, see rsa_pubkey_create().
+*/
+typedef struct rsa_pubkey
+{
+	st_rsa_pub_t pub;
+	st_rsa_mb_mont_t mbN; 				/* Multi-buffer context of n, used by the batch verification */
+	rsa_allocator_t allocator; 		/* Owner of the handle */
+}st_rsa_pubkey_t;
+
+/**
+ * @brief Ciphertexts of the 256 byte values under one key, see
+ * 			  rsa_ctx_enable_byte_table(). The blocks follow the structure in
+ * 				the same allocation.
+*/
+typedef struct rsa_byte_table
+{
+	uint16_t index[RSA_BYTE_TABLE_SLOTS]; 	/* Byte + 1 of the block hashed to the slot, 0 when free */
+	uint8_t *pBlocks; 											/* Block b of modulusBytes bytes is the ciphertext of b */
+}st_rsa_byte_table_t;
+
 /**
  * @brief struct to store the algorithm parameters.
 */
@@ -100,14 +160,40 @@ typedef struct rsa_parameters
 {
 	struct rsa_math_parameters
 	{
-		uint64_t n;
-		uint64_t phi;
-		uint64_t e;
-		uint64_t d;
+		st_rsa_bn_t n;
+		st_rsa_bn_t phi;
+		st_rsa_bn_t d;
 	}math_parameters;
 
-	uint64_t publicKey;
-	uint64_t privateKey;
+	struct rsa_crt_parameters
+	{
+		st_rsa_bn_t p;
+		st_rsa_bn_t q;
+		st_rsa_bn_t dP; 					/* d mod (p - 1) */
+		st_rsa_bn_t dQ; 					/* d mod (q - 1) */
+		st_rsa_bn_t qInv; 				/* q^-1 mod p */
+		st_rsa_bn_mont_t montP;
+		st_rsa_bn_mont_t montQ;
+
+		/* Primes past p and q of a multi-prime key, RFC 8017 section 3.2 */
+		struct rsa_crt_prime
+		{
+			st_rsa_bn_t r;
+			st_rsa_bn_t d; 					/* d mod (r - 1) */
+			st_rsa_bn_t t; 					/* (p * q * .. * previous r)^-1 mod r */
+			st_rsa_bn_mont_t montR;
+		}others[RSA_MAX_PRIMES - 0x02u];
+		uint32_t numOfPrimes; 		/* p, q and numOfPrimes - 2 others */
+	}crt_parameters;
+
+	st_rsa_pub_t pub; 				/* n, e and the public key precomputation */
+	st_rsa_mb_mont_t mbN; 		/* Multi-buffer context of n, used by the batch encryption */
+	st_rsa_byte_table_t *pByteTable; /* Byte-wise format lookup table of the key, NULL unless enabled */
+	uint64_t publicExponent; 	/* e of the next generated key */
+	uint32_t numOfPrimes; 		/* Primes of the next generated key */
+	uint32_t searchThreads; 	/* Prime search threads of the next generated key, 0 for every core */
+	uint8_t keyReady; 				/* Set once a key has been generated into the context */
+	rsa_allocator_t allocator; /* Owner of the context and of the pipeline buffers, unset in a key store */
 }st_rsa_t;
 
 /*
@@ -116,64 +202,129 @@ typedef struct rsa_parameters
 *--------------------------------------------------------------------------------------
 **/
 
+_STATIC_INLINE en_PrimeNumbersStatus_t
+testPrimeCandidate(const st_rsa_bn_t * const pCandidate);
+
 _FORCE_INLINE
-_FORCE_CONST
-_STATIC_INLINE uint64_t 
-getPrimeNumber(void);
+_STATIC_INLINE void
+getPrimeNumbers(st_rsa_bn_t * const pPrimes, const uint32_t * const pBits, const uint32_t numOfPrimes,
+                const uint32_t numOfThreads);
 
 _FORCE_INLINE
-_FORCE_CONST
-_STATIC_INLINE uint64_t 
-getEncryptionModulus(const uint64_t PrimeNumberA, 
-                     const uint64_t PrimeNumberB);
+_STATIC_INLINE void
+getKeyPrimeNumbers(st_rsa_bn_t * const pPrimes, const uint32_t keyBits, const uint32_t numOfPrimes,
+                   const uint32_t numOfThreads);
+
 _FORCE_INLINE
-_FORCE_CONST
 _STATIC_INLINE uint64_t 
-mulMod(uint64_t a, uint64_t b, const uint64_t mod);
+getEncryptionModulus(st_rsa_t * const pCtx, const st_rsa_bn_t * const pPrimes, const uint32_t numOfPrimes);
 
 _FORCE_INLINE
-_FORCE_CONST
-_STATIC_INLINE uint64_t 
-powMod(uint64_t n, uint64_t exp, const uint64_t mod);
+_STATIC_INLINE uint8_t
+getPublicKeyParams(st_rsa_t * const pCtx, const st_rsa_bn_t * const pPrimes, const uint32_t numOfPrimes);
 
 _FORCE_INLINE
-_FORCE_CONST
-_STATIC_INLINE en_PrimeNumbersStatus_t 
-isPrimeNumber(uint64_t primeNumber);
+_STATIC_INLINE void
+setKeyParams(st_rsa_t * const pCtx, const st_rsa_bn_t * const pPrimes,
+             const uint32_t numOfPrimes, const st_rsa_bn_t * const pE);
 
 _FORCE_INLINE
-_FORCE_CONST
-_STATIC_INLINE uint64_t
-getGCD(uint64_t numA, uint64_t numB);
+_STATIC_INLINE uint8_t
+getPrivateKeyParams(st_rsa_t * const pCtx, const st_rsa_bn_t * const pPrimes, const uint32_t numOfPrimes);
+
+_FORCE_INLINE
+_STATIC_INLINE void
+stringEncoder(const st_rsa_pub_t * const pPub, const uint8_t * const pString,
+              const uint64_t strLen, uint8_t * const pEncryptedString);
+
+_FORCE_INLINE
+_STATIC_INLINE void
+pubkeyEncrypter(const st_rsa_pub_t * const pPub, const uint8_t Letter, uint8_t * const pCipher);
+
+_FORCE_INLINE
+_STATIC_INLINE uint8_t
+stringDecoder(const st_rsa_t * const pCtx, const uint8_t * const pEncryptedString,
+              const uint64_t strLen, uint8_t * const pDecryptedString);
 
 _FORCE_INLINE
-_FORCE_CONST
 _STATIC_INLINE void
-getPublicKeyParams(const uint64_t PrimeNumberA, 
-             			 const uint64_t PrimeNumberB);
+privkeyOperation(const st_rsa_t * const pCtx, st_rsa_bn_t * const pResult, const st_rsa_bn_t * const pInput);
+
+_FORCE_INLINE
+_STATIC_INLINE uint8_t
+privkeyDecrypter(const st_rsa_t * const pCtx, const uint8_t * const pCipher, uint8_t * const pLetter);
+
+_FORCE_INLINE
+_STATIC_INLINE uint32_t
+byteTableSlot(const uint8_t * const pBlock, const uint32_t blockLen);
 
 _FORCE_INLINE
-_FORCE_CONST
 _STATIC_INLINE void
-getPrivateKeyParams(const uint64_t PrimeNumberA, 
-              			const uint64_t PrimeNumberB);
+byteTableEncoder(const st_rsa_t * const pCtx, const uint8_t * const pString,
+                 const uint64_t strLen, uint8_t * const pEncryptedString);
 
 _FORCE_INLINE
-_FORCE_CONST
-_STATIC_INLINE uint64_t *
-stringEncoder(const uint8_t * const pString);
+_STATIC_INLINE uint8_t
+byteTableDecoder(const st_rsa_t * const pCtx, const uint8_t * const pEncryptedString,
+                 const uint64_t strLen, uint8_t * const pDecryptedString);
+
+_FORCE_INLINE
+_STATIC_INLINE void
+pubkeyBlockEncrypter(const st_rsa_pub_t * const pPub, const uint8_t * const pBlock, uint8_t * const pCipher);
+
+_FORCE_INLINE
+_STATIC_INLINE void
+blockEncoder(const st_rsa_pub_t * const pPub, const uint8_t * const pMsg,
+             const uint64_t msgLen, uint8_t * const pCipher);
+
+_FORCE_INLINE
+_STATIC_INLINE uint64_t
+blockCipherSize(const st_rsa_pub_t * const pPub, const uint64_t msgLen);
 
 _FORCE_INLINE
-_FORCE_CONST
 _STATIC_INLINE uint8_t
-pubkeyEncrypter(const uint8_t Letter);
+privkeyBlockDecrypter(const st_rsa_t * const pCtx, const uint8_t * const pCipher, uint8_t * const pBlock);
 
 _FORCE_INLINE
-_FORCE_CONST
 _STATIC_INLINE void
-printStrArrHex(const uint64_t * const pArr, 
+signatureEncoder(const uint32_t modulusBytes, const uint8_t * const pMsg,
+                 const uint64_t msgLen, uint8_t * const pEncoded);
+
+_FORCE_INLINE
+_STATIC_INLINE en_rsa_status_t
+signatureChecker(const st_rsa_pub_t * const pPub, const st_rsa_bn_t * const pOpened,
+                 const uint8_t * const pMsg, const uint64_t msgLen);
+
+_FORCE_INLINE
+_STATIC_INLINE en_rsa_status_t
+signatureLoader(const st_rsa_pub_t * const pPub, const uint8_t * const pSig, st_rsa_bn_t * const pSignature);
+
+_FORCE_INLINE
+_STATIC_INLINE en_rsa_status_t
+pubkeyVerifier(const st_rsa_pub_t * const pPub, const uint8_t * const pMsg,
+               const uint64_t msgLen, const uint8_t * const pSig);
+
+_FORCE_INLINE
+_STATIC_INLINE void
+printStrArrHex(const uint8_t * const pArr, 
 							 const uint64_t arrLen);
 
+/*
+*--------------------------------------------------------------------------------------
+*- Private Inline Functions Implementation
+*--------------------------------------------------------------------------------------
+**/
+
+/**
+ * @brief Allocator of the buffers derived from a context, the contexts mapped
+ * 			  from a key store have none and use the default one.
+ */
+_STATIC_INLINE rsa_allocator_t
+getCtxAllocator(const st_rsa_t * const pCtx)
+{
+	return (NULL != pCtx->allocator.pfAlloc) ? (pCtx->allocator) : (rsa_allocator_default());
+}/* getCtxAllocator */
+
 /** @def Handeling name mangle */
 #ifdef __cplusplus
 }
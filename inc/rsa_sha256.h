@@ -0,0 +1,63 @@
+/**
+ * @file rsa_sha256.h
+ * @author Mohamed ashraf (wx@wx.com)
+ * @brief rsa SHA-256 message digest interface file
+ * @version 0.1
+ * @date 2023-01-01
+ *
+ * @copyright Copyright (c) Wx 2023
+ *
+ * @attention
+ *      FIPS 180-4 SHA-256, used to digest the messages of the signatures.
+ *      The header must be included after `rsa_cfg.h` and `rsa_prv.h`.
+ *
+ */
+/** @def Header guards */
+#ifndef __RSA_SHA256_H__
+#define __RSA_SHA256_H__
+
+/** @def Handeling name mangle */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+*--------------------------------------------------------------------------------------
+*- Macros
+*--------------------------------------------------------------------------------------
+**/
+
+#define RSA_SHA256_DIGEST_BYTES 		(0x20u)
+#define RSA_SHA256_BLOCK_BYTES 			(0x40u)
+
+/*
+*--------------------------------------------------------------------------------------
+*- Data types
+*--------------------------------------------------------------------------------------
+**/
+
+typedef struct rsa_sha256
+{
+	uint32_t state[0x08u];
+	uint64_t length; 													/* Message bytes absorbed so far */
+	uint8_t block[RSA_SHA256_BLOCK_BYTES]; 		/* Pending bytes of the current block */
+	uint32_t blockLen;
+}st_rsa_sha256_t;
+
+/*
+*--------------------------------------------------------------------------------------
+*- Functions Declaration
+*--------------------------------------------------------------------------------------
+**/
+
+void sha256Init(st_rsa_sha256_t * const pSha);
+void sha256Update(st_rsa_sha256_t * const pSha, const uint8_t * const pData, const uint64_t len);
+void sha256Final(st_rsa_sha256_t * const pSha, uint8_t * const pDigest);
+void sha256Digest(const uint8_t * const pData, const uint64_t len, uint8_t * const pDigest);
+
+/** @def Handeling name mangle */
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __RSA_SHA256_H__ */
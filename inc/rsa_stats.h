@@ -0,0 +1,87 @@
+/**
+ * @file rsa_stats.h
+ * @author Mohamed ashraf (wx@wx.com)
+ * @brief rsa performance counters interface file
+ * @version 0.1
+ * @date 2023-01-01
+ *
+ * @copyright Copyright (c) Wx 2023
+ *
+ * @attention
+ *      RSA_STATS_ADD() expands to nothing unless STATS_FLAG is active. Every
+ *      thread adds to its own counters block, the blocks are only summed by
+ *      rsa_get_stats() so the counting never shares a cache line.
+ *      The header must be included after `rsa_cfg.h`, `rsa_prv.h` and `rsa_int.h`.
+ *
+ */
+/** @def Header guards */
+#ifndef __RSA_STATS_H__
+#define __RSA_STATS_H__
+
+/** @def Handeling name mangle */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+*--------------------------------------------------------------------------------------
+*- Data types
+*--------------------------------------------------------------------------------------
+**/
+
+/**
+ * @brief Counters of one thread, statsSharedBlock collects the threads past
+ * 			  RSA_STATS_MAX_THREADS alive at the same time and is the only block
+ * 				updated atomically.
+*/
+typedef struct rsa_stats_block
+{
+	rsa_stats_t counters;
+}__attribute__((aligned(64))) st_rsa_stats_block_t;
+
+/*
+*--------------------------------------------------------------------------------------
+*- Macros
+*--------------------------------------------------------------------------------------
+**/
+
+#if (STATS_FLAG == STATS_ACTIVE)
+	/** @brief Adds `_COUNT` to the `_FIELD` counter of the calling thread */
+	#define RSA_STATS_ADD(_FIELD, _COUNT) ({ \
+						st_rsa_stats_block_t * const _pBlock = (NULL != statsBlock) ? (statsBlock) : (statsClaimBlock()); \
+						if( (&statsSharedBlock == _pBlock) ) \
+						{ __atomic_fetch_add(&_pBlock->counters._FIELD, (uint64_t) (_COUNT), __ATOMIC_RELAXED); } \
+						else \
+						{ \
+							__atomic_store_n(&_pBlock->counters._FIELD, \
+							                 __atomic_load_n(&_pBlock->counters._FIELD, __ATOMIC_RELAXED) + (uint64_t) (_COUNT), \
+							                 __ATOMIC_RELAXED); \
+						} \
+					})
+	/** @brief Monotonic time in nanoseconds, used to time the key generation */
+	#define RSA_STATS_TIME_NS() 			(statsGetTimeNs())
+#else
+	#define RSA_STATS_ADD(_FIELD, _COUNT) ({ ; })
+	#define RSA_STATS_TIME_NS() 			(0x00u)
+#endif
+
+/*
+*--------------------------------------------------------------------------------------
+*- Functions Declaration
+*--------------------------------------------------------------------------------------
+**/
+
+#if (STATS_FLAG == STATS_ACTIVE)
+extern __thread st_rsa_stats_block_t *statsBlock;
+extern st_rsa_stats_block_t statsSharedBlock;
+st_rsa_stats_block_t *statsClaimBlock(void);
+uint64_t statsGetTimeNs(void);
+#endif
+void statsRecordKeygen(const uint64_t startNs);
+
+/** @def Handeling name mangle */
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __RSA_STATS_H__ */
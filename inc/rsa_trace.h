@@ -0,0 +1,97 @@
+/**
+ * @file rsa_trace.h
+ * @author Mohamed ashraf (wx@wx.com)
+ * @brief rsa tracing interface file
+ * @version 0.1
+ * @date 2023-01-01
+ *
+ * @copyright Copyright (c) Wx 2023
+ *
+ * @attention
+ *      RSA_TRACE() expands to nothing unless TRACING_FLAG is active. Once
+ *      compiled in, a disabled trace costs a relaxed load and a branch, an
+ *      enabled one stores a fixed size record in the ring of the calling
+ *      thread without any lock or I/O. The rings are written to a file by
+ *      rsa_trace_save() and decoded offline by rsa_trace_dump().
+ *      The header must be included after `rsa_cfg.h` and `rsa_prv.h`.
+ *
+ */
+/** @def Header guards */
+#ifndef __RSA_TRACE_H__
+#define __RSA_TRACE_H__
+
+/** @def Handeling name mangle */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+*--------------------------------------------------------------------------------------
+*- Data types
+*--------------------------------------------------------------------------------------
+**/
+
+/** @brief Trace events, the names printed by the dumper follow the same order */
+typedef enum en_rsa_trace_event
+{
+	traceEventNone = 0x00u,
+	traceEventPrimeTest, 				/* argA: candidate bits, argB: 1 if prime */
+	traceEventPrimeTest64, 			/* argA: candidate, argB: 1 if prime */
+	traceEventPrimeFound, 			/* argA: slot, argB: bits */
+	traceEventGcd, 							/* argA: first operand, argB: gcd */
+	traceEventEncryptLetter, 		/* argA: letter, argB: block bytes */
+	traceEventEncrypt, 					/* argA: message bytes, argB: ciphertext bytes */
+	traceEventBlockEncrypt, 		/* argA: message bytes, argB: blocks */
+	traceEventBlockDecrypt, 		/* argA: ciphertext bytes, argB: status */
+	traceEventPipeChunk, 				/* argA: chunk sequence, argB: chunk bytes */
+	traceEventPoolTake, 				/* argA: keys left in the pool */
+	traceEventJobDone, 					/* argA: job type, argB: status */
+	traceEventCount
+}en_rsa_trace_event_t;
+
+/**
+ * @brief Fixed size trace record, also the on-disk format of rsa_trace_save().
+*/
+typedef struct rsa_trace_record
+{
+	uint64_t time; 				/* CLOCK_MONOTONIC nanoseconds */
+	uint64_t argA;
+	uint64_t argB;
+	uint32_t event;
+	uint32_t thread; 			/* Serial number of the recording thread */
+}st_rsa_trace_record_t;
+
+/*
+*--------------------------------------------------------------------------------------
+*- Macros
+*--------------------------------------------------------------------------------------
+**/
+
+#if (TRACING_FLAG == TRACING_ACTIVE)
+	/** @brief Records an event when the tracing is enabled at runtime */
+	#define RSA_TRACE(_EVENT, _ARG_A, _ARG_B) ({ \
+						if( (__builtin_expect(__atomic_load_n(&traceEnabled, __ATOMIC_RELAXED), 0x00u)) ) \
+						{ traceRecord((_EVENT), (uint64_t) (_ARG_A), (uint64_t) (_ARG_B)); } \
+						else; \
+					})
+#else
+	#define RSA_TRACE(_EVENT, _ARG_A, _ARG_B) ({ ; })
+#endif
+
+/*
+*--------------------------------------------------------------------------------------
+*- Functions Declaration
+*--------------------------------------------------------------------------------------
+**/
+
+#if (TRACING_FLAG == TRACING_ACTIVE)
+extern uint8_t traceEnabled;
+void traceRecord(const en_rsa_trace_event_t event, const uint64_t argA, const uint64_t argB);
+#endif
+
+/** @def Handeling name mangle */
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __RSA_TRACE_H__ */
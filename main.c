@@ -4,28 +4,109 @@
  * @brief main entrypoint for the library
  * @version 0.1
  * @date 2023-01-01
- * 
+ *
  * @copyright Copyright (c) Wx 2023
- * 
+ *
  */
 #include <stdio.h>
 #include <stdint.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include "rsa_int.h"
 
+/**
+ * @brief Prints the command line usage
+ */
+static void usage(const char *pProgram)
+{
+    fprintf(stderr,
+            "usage: %s                                          run the demo\n"
+            "       %s keygen  <bits> <keyfile>\n"
+            "       %s encrypt <keyfile> <in> <out> [threads]\n"
+            "       %s decrypt <keyfile> <in> <out> [threads]\n"
+            "       %s trace   <tracefile>\n"
+            "set RSA_TRACE_FILE=<tracefile> to record a trace of the other commands\n",
+            pProgram, pProgram, pProgram, pProgram, pProgram);
+}
+
 /**
  * @brief main entry point function
- * 
- * @return int 
+ *
+ * @return int
  */
-int main(void)
+int main(int argc, char **argv)
 {
-    generate_keys("Hello? I am mohamed ashraf ");
+    rsa_ctx_t *pCtx = NULL;
+    en_rsa_status_t status = rsaStatusOk;
+    uint32_t threads = 0;
+    const char *pTraceFile = getenv("RSA_TRACE_FILE");
+
+    if ((argc == 3) && (strcmp(argv[1], "trace") == 0))
+    {
+        return (rsa_trace_dump(argv[2]) == rsaStatusOk) ? 0 : 1;
+    }
+
+    if (pTraceFile != NULL)
+    {
+        rsa_trace_enable(1);
+    }
+
+    if (argc < 2)
+    {
+        generate_keys("Hello? I am mohamed ashraf ");
+        printf("\n");
+        return 0;
+    }
+
+    pCtx = rsa_ctx_create();
+    if (pCtx == NULL)
+    {
+        fprintf(stderr, "out of memory\n");
+        return 1;
+    }
+
+    if ((strcmp(argv[1], "keygen") == 0) && (argc == 4))
+    {
+        status = rsa_ctx_generate(pCtx, (uint32_t) strtoul(argv[2], NULL, 10));
+        if (status == rsaStatusOk)
+        {
+            status = rsa_ctx_save(pCtx, argv[3]);
+        }
+    }
+    else if (((strcmp(argv[1], "encrypt") == 0) || (strcmp(argv[1], "decrypt") == 0)) &&
+             ((argc == 5) || (argc == 6)))
+    {
+        threads = (argc == 6) ? (uint32_t) strtoul(argv[5], NULL, 10) : 0;
+        status = rsa_ctx_load(pCtx, argv[2]);
+        if ((status == rsaStatusOk) && (argv[1][0] == 'e'))
+        {
+            status = rsa_pipe_encrypt_file(pCtx, argv[3], argv[4], threads);
+        }
+        else if (status == rsaStatusOk)
+        {
+            status = rsa_pipe_decrypt_file(pCtx, argv[3], argv[4], threads);
+        }
+    }
+    else
+    {
+        usage(argv[0]);
+        rsa_ctx_destroy(pCtx);
+        return 2;
+    }
+
+    rsa_ctx_destroy(pCtx);
+
+    if ((pTraceFile != NULL) && (rsa_trace_save(pTraceFile) != rsaStatusOk))
+    {
+        fprintf(stderr, "failed to save the trace to %s\n", pTraceFile);
+    }
 
-    printf("\n");
-    /* Run forever */
-    while(1) {;}
+    if (status != rsaStatusOk)
+    {
+        fprintf(stderr, "%s failed with status %u\n", argv[1], (unsigned) status);
+        return 1;
+    }
 
     return 0;
-}
\ No newline at end of file
+}
@@ -0,0 +1,166 @@
+/**
+ * @file rsa_alloc.c
+ * @author Mohamed ashraf (wx@wx.com)
+ * @brief rsa allocation hooks program file
+ * @version 0.1
+ * @date 2023-01-01
+ *
+ * @copyright Copyright (c) Wx 2023
+ *
+ * @attention
+ *      The library only allocates when a context or a file pipeline is
+ *      created, the encryption and decryption calls work on caller buffers
+ *      and stack temporaries. An arena is a plain bump pointer over a
+ *      caller buffer, it has no lock so every thread keeps its own.
+ *
+ */
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "rsa_cfg.h"
+#include "rsa_prv.h"
+#include "rsa_int.h"
+
+/*
+*--------------------------------------------------------------------------------------
+*- Private Functions Implementation
+*--------------------------------------------------------------------------------------
+**/
+
+static void *
+defaultAlloc(void *pUser, const size_t size, const size_t align)
+{
+	/* Function data types */
+	void *pMem = NULL;
+
+	/* Function body */
+	(void) pUser;
+
+	/* posix_memalign() rejects alignments below the size of a pointer */
+	if( (0x00 != posix_memalign(&pMem, (align < sizeof(void *)) ? (sizeof(void *)) : (align), size)) )
+	{ return NULL; }
+	else;
+
+	return pMem;
+}/* defaultAlloc */
+
+static void
+defaultFree(void *pUser, void *pMem)
+{
+	(void) pUser;
+	free(pMem);
+}/* defaultFree */
+
+static void *
+arenaAlloc(void *pUser, const size_t size, const size_t align)
+{
+	return rsa_arena_alloc((rsa_arena_t *) pUser, size, align);
+}/* arenaAlloc */
+
+/**
+ * @brief Arena memory is only released as a whole by rsa_arena_reset().
+ */
+static void
+arenaFree(void *pUser, void *pMem)
+{
+	(void) pUser;
+	(void) pMem;
+}/* arenaFree */
+
+/*
+*--------------------------------------------------------------------------------------
+*- Public Functions Implementation
+*--------------------------------------------------------------------------------------
+**/
+
+/**
+ * @brief Allocator used when none is supplied, backed by posix_memalign().
+ */
+rsa_allocator_t
+rsa_allocator_default(void)
+{
+	/* Function data types */
+	rsa_allocator_t allocator;
+
+	/* Function body */
+	allocator.pfAlloc = defaultAlloc;
+	allocator.pfFree = defaultFree;
+	allocator.pUser = NULL;
+
+	return allocator;
+}/* rsa_allocator_default */
+
+void
+rsa_arena_init(rsa_arena_t * const pArena, void * const pBuf, const size_t size)
+{
+	/* Validating */
+#if (FULL_ASSERTION_FLAG == FULL_ASSERTION_ACTIVE)
+	STATIC_ASSERT((pArena != NULL) && ((pBuf != NULL) || (0x00u == size)), DEFAULT_EXIT_CODE);
+#endif
+
+	/* Function body */
+	pArena->pBase = (uint8_t *) pBuf;
+	pArena->size = size;
+	pArena->used = 0x00u;
+}/* rsa_arena_init */
+
+/**
+ * @brief Bumps `size` bytes aligned to `align` (a power of two) out of the arena.
+ * @return NULL once the arena is exhausted.
+ */
+void *
+rsa_arena_alloc(rsa_arena_t * const pArena, const size_t size, const size_t align)
+{
+	/* Function data types */
+	uintptr_t address = 0x00u;
+	size_t offset = 0x00u;
+
+	/* Validating */
+	if( (NULL == pArena) || (NULL == pArena->pBase) || (0x00u == align) || (0x00u != (align & (align - 0x01u))) )
+	{ return NULL; }
+	else;
+
+	/* Function body */
+	address = (uintptr_t) (pArena->pBase + pArena->used);
+	offset = pArena->used + (size_t) (((address + align - 0x01u) & ~((uintptr_t) align - 0x01u)) - address);
+
+	if( (offset > pArena->size) || (size > (pArena->size - offset)) )
+	{ return NULL; }
+	else;
+
+	pArena->used = offset + size;
+
+	return pArena->pBase + offset;
+}/* rsa_arena_alloc */
+
+/**
+ * @brief Releases everything allocated from the arena at once.
+ */
+void
+rsa_arena_reset(rsa_arena_t * const pArena)
+{
+	/* Function body */
+	if( (NULL != pArena) )
+	{ pArena->used = 0x00u; }
+	else;
+}/* rsa_arena_reset */
+
+/**
+ * @brief Allocator drawing from the arena, frees are ignored until the
+ * 			  arena is reset.
+ */
+rsa_allocator_t
+rsa_arena_allocator(rsa_arena_t * const pArena)
+{
+	/* Function data types */
+	rsa_allocator_t allocator;
+
+	/* Function body */
+	allocator.pfAlloc = arenaAlloc;
+	allocator.pfFree = arenaFree;
+	allocator.pUser = pArena;
+
+	return allocator;
+}/* rsa_arena_allocator */
@@ -0,0 +1,191 @@
+/**
+ * @file rsa_arith.c
+ * @author Mohamed ashraf (wx@wx.com)
+ * @brief rsa single word arithmetic program file
+ * @version 0.1
+ * @date 2023-01-01
+ *
+ * @copyright Copyright (c) Wx 2023
+ *
+ * @attention
+ *      Word sized helpers used by the keys whose modulus or primes fit in a
+ *      single 64-bit limb, they are kept out of line so the benchmarks can
+ *      measure them on their own.
+ *
+ */
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "rsa_cfg.h"
+#include "rsa_prv.h"
+#include "rsa_mont.h"
+#include "rsa_arith.h"
+#include "rsa_prime64.h"
+#include "rsa_int.h"
+#include "rsa_trace.h"
+#include "rsa_stats.h"
+
+/*
+*--------------------------------------------------------------------------------------
+*- Public Functions Implementation
+*--------------------------------------------------------------------------------------
+**/
+
+/**
+ * @brief Generic modular multiplication, used only when the modulus is even
+ * 			  and the montgomery domain isn't available.
+ */
+uint64_t
+mulMod(uint64_t a, uint64_t b, const uint64_t mod)
+{
+	return (uint64_t) (((uint128_t) a * b) % mod); // return (a * b) % mod using a 128-bit product.
+}/* mulMod */
+
+uint64_t
+powMod(uint64_t n, uint64_t exp, const uint64_t mod)
+{
+	/* Function data types */
+	uint64_t res = 1; // return (n ^ exp) % mod
+	st_rsa_mont_t mont;
+
+	/* Function body */
+	if( (0x01u == mod) )
+	{ res = 0x00u; }
+	else if( (mod & 0x01u) )
+	{
+		montInit(&mont, mod);
+		res = montFromForm(&mont, montPow(&mont, montToForm(&mont, n), exp));
+	}
+	else
+	{
+		for (n %= mod; exp; exp & 1 ? res = mulMod(res, n, mod) : 0, n = mulMod(n, n, mod), exp >>= 1);
+	}
+
+	RSA_STATS_ADD(powModCalls, 0x01u);
+
+	return res;
+}/* powMod */
+
+/**
+ * @brief Deterministic primality test of a word, any value is accepted.
+ * 			  See rsa_prime64.c for the trial division and the tests behind it.
+ */
+en_PrimeNumbersStatus_t
+isPrimeNumber(uint64_t primeNumber)
+{
+	/* Function data types */
+	const en_PrimeNumbersStatus_t primeNumberStatus = prime64Test(primeNumber);
+
+	/* Function body */
+	RSA_TRACE(traceEventPrimeTest64, primeNumber, primeNumberStatus);
+
+	return primeNumberStatus;
+}/* isPrimeNumber */
+
+/**
+ * @brief Binary (Stein) greatest common divisor of two non zero words, the
+ * 			  loop only shifts and subtracts.
+ */
+uint64_t
+getGCD(uint64_t numA, uint64_t numB)
+{
+#if (FULL_ASSERTION_FLAG == FULL_ASSERTION_ACTIVE)
+	STATIC_ASSERT((numA != 0), DEFAULT_EXIT_CODE);
+	STATIC_ASSERT((numB != 0), DEFAULT_EXIT_CODE);
+#endif
+
+	/* Function data types */
+	const uint32_t shift = (uint32_t) __builtin_ctzll(numA | numB);
+	uint64_t tempA = numA >> __builtin_ctzll(numA);
+	uint64_t tempB = numB;
+	uint64_t tempVar = 0x00u;
+	uint64_t iterations = 0x00u;
+
+	/* Function body */
+	/* Both odd from here, their difference is even and loses its low zeros,
+	 * the smaller value and the distance are selected without branching */
+	do
+	{
+		++iterations;
+		tempB >>= __builtin_ctzll(tempB);
+
+		tempVar = (tempA < tempB) ? (tempB - tempA) : (tempA - tempB);
+		tempA = (tempA < tempB) ? (tempA) : (tempB);
+		tempB = tempVar;
+	}
+	while( (tempB) );
+
+	tempA <<= shift;
+
+	RSA_TRACE(traceEventGcd, numA, tempA);
+	RSA_STATS_ADD(gcdIterations, iterations);
+
+	return tempA;
+}/* getGCD */
+
+/**
+ * @brief Inverse of `num` modulo an odd `mod` by the binary extended
+ * 			  euclidean algorithm, u = x1 * num and v = x2 * num (mod `mod`) hold
+ * 				through the loop, which only shifts, adds and subtracts.
+ * @return The inverse in [1, mod), 0 when gcd(num, mod) != 1.
+ */
+uint64_t
+modInverse(uint64_t num, const uint64_t mod)
+{
+#if (FULL_ASSERTION_FLAG == FULL_ASSERTION_ACTIVE)
+	STATIC_ASSERT((mod & 0x01u), DEFAULT_EXIT_CODE);
+#endif
+
+	/* Function data types */
+	uint64_t u = num % mod;
+	uint64_t v = mod;
+	uint64_t x1 = 0x01u;
+	uint64_t x2 = 0x00u;
+	uint64_t iterations = 0x00u;
+
+	/* Function body */
+	if( (0x01u == mod) || (0x00u == u) )
+	{ return 0x00u; }
+	else;
+
+	while( (0x01u != u) && (0x01u != v) )
+	{
+		++iterations;
+
+		/* x / 2 mod `mod`, an odd x is made even by adding the odd modulus */
+		while( (0x00u == (u & 0x01u)) )
+		{
+			u >>= 0x01u;
+			x1 = (x1 & 0x01u) ? ((x1 >> 0x01u) + (mod >> 0x01u) + 0x01u) : (x1 >> 0x01u);
+		}
+		while( (0x00u == (v & 0x01u)) )
+		{
+			v >>= 0x01u;
+			x2 = (x2 & 0x01u) ? ((x2 >> 0x01u) + (mod >> 0x01u) + 0x01u) : (x2 >> 0x01u);
+		}
+
+		if( (u >= v) )
+		{
+			u -= v;
+			x1 = (x1 >= x2) ? (x1 - x2) : (x1 + (mod - x2));
+		}
+		else
+		{
+			v -= u;
+			x2 = (x2 >= x1) ? (x2 - x1) : (x2 + (mod - x1));
+		}
+
+		/* Equal odd values above one, they share a factor */
+		if( (0x00u == u) || (0x00u == v) )
+		{
+			RSA_STATS_ADD(gcdIterations, iterations);
+			return 0x00u;
+		}
+		else;
+	}
+
+	RSA_STATS_ADD(gcdIterations, iterations);
+
+	return (0x01u == u) ? (x1) : (x2);
+}/* modInverse */
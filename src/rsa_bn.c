@@ -0,0 +1,1722 @@
+/**
+ * @file rsa_bn.c
+ * @author Mohamed ashraf (wx@wx.com)
+ * @brief rsa multi-precision integer program file
+ * @version 0.1
+ * @date 2023-01-01
+ *
+ * @copyright Copyright (c) Wx 2023
+ *
+ * @attention
+ *      The file is split in two layers, the `limbs*` functions work on raw
+ *      limb arrays with explicit lengths (the hot loops), and the `bn*`
+ *      functions wrap them for `st_rsa_bn_t`.
+ *
+ */
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/random.h>
+
+#include "rsa_cfg.h"
+#include "rsa_prv.h"
+#include "rsa_bn.h"
+#include "rsa_arith.h"
+#include "rsa_mod.h"
+#include "rsa_int.h"
+#include "rsa_stats.h"
+
+/*
+*--------------------------------------------------------------------------------------
+*- Macros
+*--------------------------------------------------------------------------------------
+**/
+
+/** @brief Small primes used to reject candidates before running Miller-Rabin */
+#define BN_NUM_OF_TRIAL_PRIMES 		(0x36u)
+
+/**
+ * @brief Comba accumulator step, (c2:c1:c0) += a * b.
+ */
+#define COMBA_MULADD(c0, c1, c2, a, b) ({ \
+					uint128_t _p = (uint128_t) (a) * (b); \
+					uint128_t _s = (uint128_t) (c0) + (uint64_t) _p; \
+					(c0) = (uint64_t) _s; \
+					_s = (uint128_t) (c1) + (uint64_t) (_p >> 64) + (uint64_t) (_s >> 64); \
+					(c1) = (uint64_t) _s; \
+					(c2) += (uint64_t) (_s >> 64); \
+				})
+
+/*
+*--------------------------------------------------------------------------------------
+*- Data types
+*--------------------------------------------------------------------------------------
+**/
+
+static const uint8_t bnTrialPrimes[BN_NUM_OF_TRIAL_PRIMES] =
+{
+	  3,   5,   7,  11,  13,  17,  19,  23,  29,  31,  37,  41,  43,  47,  53,  59,  61,
+	 67,  71,  73,  79,  83,  89,  97, 101, 103, 107, 109, 113, 127, 131, 137, 139, 149,
+	151, 157, 163, 167, 173, 179, 181, 191, 193, 197, 199, 211, 223, 227, 229, 233, 239,
+	241, 251,   2
+};
+
+/*
+*--------------------------------------------------------------------------------------
+*- Limbs Functions Implementation
+*--------------------------------------------------------------------------------------
+**/
+
+_STATIC_INLINE uint32_t
+limbsNormalize(const uint64_t * const pA, uint32_t len)
+{
+	while( (len > 0x00u) && (0x00u == pA[len - 0x01u]) )
+	{ --len; }
+
+	return len;
+}/* limbsNormalize */
+
+/**
+ * @brief Clears the limbs above `len` and recomputes `used`, keeps the zero
+ * 			  padding invariant after a raw limbs operation wrote into pRes.
+ */
+_STATIC_INLINE void
+bnSetLength(st_rsa_bn_t * const pRes, const uint32_t len)
+{
+	memset(pRes->limbs + len, 0x00u, sizeof(uint64_t) * (RSA_BN_MAX_LIMBS - len));
+	pRes->used = limbsNormalize(pRes->limbs, len);
+}/* bnSetLength */
+
+_STATIC_INLINE int8_t
+limbsCompare(const uint64_t * const pA, const uint64_t * const pB, uint32_t len)
+{
+	while(len--)
+	{
+		if( (pA[len] != pB[len]) )
+		{ return (pA[len] > pB[len]) ? (1) : (-1); }
+		else;
+	}
+
+	return 0;
+}/* limbsCompare */
+
+_STATIC_INLINE uint64_t
+limbsAdd(uint64_t * const pRes, const uint64_t * const pA, const uint64_t * const pB, const uint32_t len)
+{
+	uint64_t carry = 0x00u;
+	uint32_t register i = 0x00u;
+
+	for(; i < len; ++i)
+	{
+		uint128_t s = (uint128_t) pA[i] + pB[i] + carry;
+		pRes[i] = (uint64_t) s;
+		carry = (uint64_t) (s >> 64);
+	}
+
+	return carry;
+}/* limbsAdd */
+
+_STATIC_INLINE uint64_t
+limbsSub(uint64_t * const pRes, const uint64_t * const pA, const uint64_t * const pB, const uint32_t len)
+{
+	uint64_t borrow = 0x00u;
+	uint32_t register i = 0x00u;
+
+	for(; i < len; ++i)
+	{
+		uint128_t s = (uint128_t) pA[i] - pB[i] - borrow;
+		pRes[i] = (uint64_t) s;
+		borrow = (uint64_t) (s >> 64) & 0x01u;
+	}
+
+	return borrow;
+}/* limbsSub */
+
+/**
+ * @brief Propagates `word` into pRes[0..len), returns the carry out.
+ */
+_STATIC_INLINE uint64_t
+limbsAddWord(uint64_t * const pRes, const uint32_t len, uint64_t word)
+{
+	uint32_t register i = 0x00u;
+
+	for(; (i < len) && (word); ++i)
+	{
+		pRes[i] += word;
+		word = (pRes[i] < word);
+	}
+
+	return word;
+}/* limbsAddWord */
+
+_STATIC_INLINE uint64_t
+limbsSubWord(uint64_t * const pRes, const uint32_t len, uint64_t word)
+{
+	uint32_t register i = 0x00u;
+
+	for(; (i < len) && (word); ++i)
+	{
+		uint64_t prev = pRes[i];
+		pRes[i] = prev - word;
+		word = (prev < word);
+	}
+
+	return word;
+}/* limbsSubWord */
+
+/**
+ * @brief Rectangular schoolbook product, pRes must hold `aLen + bLen` limbs
+ * 			  and must not alias the operands.
+ */
+static void
+limbsMulSchool(uint64_t * const pRes, const uint64_t * const pA, const uint32_t aLen,
+               const uint64_t * const pB, const uint32_t bLen)
+{
+	uint32_t register i = 0x00u;
+	uint32_t register j = 0x00u;
+
+	memset(pRes, 0x00u, sizeof(uint64_t) * (aLen + bLen));
+
+	for(i = 0x00u; i < aLen; ++i)
+	{
+		uint64_t carry = 0x00u;
+
+		for(j = 0x00u; j < bLen; ++j)
+		{
+			uint128_t p = (uint128_t) pA[i] * pB[j] + pRes[i + j] + carry;
+			pRes[i + j] = (uint64_t) p;
+			carry = (uint64_t) (p >> 64);
+		}
+		pRes[i + bLen] = carry;
+	}
+}/* limbsMulSchool */
+
+/**
+ * @brief Comba (column-wise) product of two `len` limb operands, every output
+ * 			  limb is written exactly once which keeps the stores sequential.
+ */
+static void
+limbsMulComba(uint64_t * const pRes, const uint64_t * const pA, const uint64_t * const pB, const uint32_t len)
+{
+	uint64_t c0 = 0x00u, c1 = 0x00u, c2 = 0x00u;
+	uint32_t register k = 0x00u;
+	uint32_t register i = 0x00u;
+
+	for(k = 0x00u; k < ((len * 0x02u) - 0x01u); ++k)
+	{
+		uint32_t iMin = (k >= len) ? (k - len + 0x01u) : (0x00u);
+		uint32_t iMax = (k < len) ? (k) : (len - 0x01u);
+
+		for(i = iMin; i <= iMax; ++i)
+		{ COMBA_MULADD(c0, c1, c2, pA[i], pB[k - i]); }
+
+		pRes[k] = c0;
+		c0 = c1;
+		c1 = c2;
+		c2 = 0x00u;
+	}
+	pRes[k] = c0;
+}/* limbsMulComba */
+
+/**
+ * @brief Comba squaring, the cross products `a[i] * a[j]` (i < j) are summed
+ * 			  once then doubled, so it needs about half of the multiplications.
+ */
+static void
+limbsSqrComba(uint64_t * const pRes, const uint64_t * const pA, const uint32_t len)
+{
+	uint64_t c0 = 0x00u, c1 = 0x00u, c2 = 0x00u;
+	uint32_t register k = 0x00u;
+	uint32_t register i = 0x00u;
+
+	for(k = 0x00u; k < ((len * 0x02u) - 0x01u); ++k)
+	{
+		uint64_t d0 = 0x00u, d1 = 0x00u, d2 = 0x00u;
+		uint32_t iMin = (k >= len) ? (k - len + 0x01u) : (0x00u);
+
+		for(i = iMin; (i < (k - i)); ++i)
+		{ COMBA_MULADD(d0, d1, d2, pA[i], pA[k - i]); }
+
+		d2 = (d2 << 0x01u) | (d1 >> 63);
+		d1 = (d1 << 0x01u) | (d0 >> 63);
+		d0 = (d0 << 0x01u);
+
+		if( (0x00u == (k & 0x01u)) )
+		{ COMBA_MULADD(d0, d1, d2, pA[k >> 0x01u], pA[k >> 0x01u]); }
+		else;
+
+		/* Add the carry coming from the previous column */
+		uint128_t s = (uint128_t) d0 + c0;
+		d0 = (uint64_t) s;
+		s = (uint128_t) d1 + c1 + (uint64_t) (s >> 64);
+		d1 = (uint64_t) s;
+		d2 += c2 + (uint64_t) (s >> 64);
+
+		pRes[k] = d0;
+		c0 = d1;
+		c1 = d2;
+		c2 = 0x00u;
+	}
+	pRes[k] = c0;
+}/* limbsSqrComba */
+
+static void
+limbsMul(uint64_t * const pRes, const uint64_t * const pA, const uint64_t * const pB, const uint32_t len);
+
+static void
+limbsSqr(uint64_t * const pRes, const uint64_t * const pA, const uint32_t len);
+
+/**
+ * @brief Karatsuba product, a = a1 * B^h + a0, b = b1 * B^h + b0
+ * 				a * b = z2 * B^2h + (z1 - z2 - z0) * B^h + z0
+ * 				with z1 = (a0 + a1) * (b0 + b1), the carries of the half sums are
+ * 				folded back into z1 explicitly.
+ * 				When `pB` is NULL the function squares `pA`.
+ */
+static void
+limbsKaratsuba(uint64_t * const pRes, const uint64_t * const pA, const uint64_t * const pB, const uint32_t len)
+{
+	/* Function data types */
+	const uint32_t h = len >> 0x01u;
+	const uint32_t m = len - h;
+	uint64_t sa[RSA_BN_MAX_LIMBS];
+	uint64_t sb[RSA_BN_MAX_LIMBS];
+	uint64_t z1[RSA_BN_WIDE_LIMBS];
+	uint64_t ca = 0x00u, cb = 0x00u;
+	uint32_t register i = 0x00u;
+
+	/* Function body */
+	/* Half sums, a0 is h limbs long and a1 is m limbs long (m >= h) */
+	memcpy(sa, pA + h, sizeof(uint64_t) * m);
+	ca = limbsAdd(sa, sa, pA, h);
+	ca = limbsAddWord(sa + h, m - h, ca);
+	if( (NULL != pB) )
+	{
+		memcpy(sb, pB + h, sizeof(uint64_t) * m);
+		cb = limbsAdd(sb, sb, pB, h);
+		cb = limbsAddWord(sb + h, m - h, cb);
+	}
+	else;
+
+	/* z0 -> pRes[0, 2h), z2 -> pRes[2h, 2len) */
+	if( (NULL != pB) )
+	{
+		limbsMul(pRes, pA, pB, h);
+		limbsMul(pRes + (h * 0x02u), pA + h, pB + h, m);
+		limbsMul(z1, sa, sb, m);
+	}
+	else
+	{
+		limbsSqr(pRes, pA, h);
+		limbsSqr(pRes + (h * 0x02u), pA + h, m);
+		limbsSqr(z1, sa, m);
+		memcpy(sb, sa, sizeof(uint64_t) * m);
+		cb = ca;
+	}
+
+	/* Fold the half sums carries: z1 += (ca * sb + cb * sa) * B^m + ca * cb * B^2m */
+	z1[m * 0x02u] = ca & cb;
+	if( (ca) )
+	{ z1[m * 0x02u] += limbsAdd(z1 + m, z1 + m, sb, m); }
+	else;
+	if( (cb) )
+	{ z1[m * 0x02u] += limbsAdd(z1 + m, z1 + m, sa, m); }
+	else;
+
+	/* z1 -= z0 + z2 */
+	limbsSubWord(z1 + (h * 0x02u), (m * 0x02u) + 0x01u - (h * 0x02u),
+	             limbsSub(z1, z1, pRes, h * 0x02u));
+	limbsSubWord(z1 + (m * 0x02u), 0x01u,
+	             limbsSub(z1, z1, pRes + (h * 0x02u), m * 0x02u));
+
+	/* pRes += z1 * B^h */
+	i = (m * 0x02u) + 0x01u;
+	limbsAddWord(pRes + h + i, (len * 0x02u) - h - i, limbsAdd(pRes + h, pRes + h, z1, i));
+}/* limbsKaratsuba */
+
+/**
+ * @brief Square product dispatcher, comba below the karatsuba threshold.
+ */
+static void
+limbsMul(uint64_t * const pRes, const uint64_t * const pA, const uint64_t * const pB, const uint32_t len)
+{
+	if( (len < RSA_BN_KARATSUBA_THRESHOLD) )
+	{ limbsMulComba(pRes, pA, pB, len); }
+	else
+	{ limbsKaratsuba(pRes, pA, pB, len); }
+}/* limbsMul */
+
+static void
+limbsSqr(uint64_t * const pRes, const uint64_t * const pA, const uint32_t len)
+{
+	if( (len < RSA_BN_KARATSUBA_THRESHOLD) )
+	{ limbsSqrComba(pRes, pA, len); }
+	else
+	{ limbsKaratsuba(pRes, pA, NULL, len); }
+}/* limbsSqr */
+
+/**
+ * @brief Word by word montgomery reduction of pT[0..2len) (pT is destroyed),
+ * 			  pRes = T * R^-1 mod n.
+ */
+static void
+limbsMontRedc(uint64_t * const pRes, uint64_t * const pT, const uint64_t * const pN,
+              const uint64_t n0inv, const uint32_t len)
+{
+	uint32_t register i = 0x00u;
+	uint32_t register j = 0x00u;
+	uint64_t topCarry = 0x00u;
+
+	for(i = 0x00u; i < len; ++i)
+	{
+		uint64_t m = pT[i] * n0inv;
+		uint64_t carry = 0x00u;
+
+		for(j = 0x00u; j < len; ++j)
+		{
+			uint128_t p = (uint128_t) m * pN[j] + pT[i + j] + carry;
+			pT[i + j] = (uint64_t) p;
+			carry = (uint64_t) (p >> 64);
+		}
+		topCarry += limbsAddWord(pT + i + len, len - i, carry);
+	}
+
+	/* The result is below 2n, one conditional subtraction is enough */
+	if( (topCarry) || (limbsCompare(pT + len, pN, len) >= 0) )
+	{ limbsSub(pRes, pT + len, pN, len); }
+	else
+	{ memcpy(pRes, pT + len, sizeof(uint64_t) * len); }
+}/* limbsMontRedc */
+
+/**
+ * @brief Knuth algorithm D, divides u (uLen limbs) by v (vLen limbs, top limb
+ * 			  non zero). pQuot receives `uLen - vLen + 1` limbs when not NULL, pRem
+ * 				receives vLen limbs.
+ */
+static void
+limbsDivMod(uint64_t * const pQuot, uint64_t * const pRem,
+            const uint64_t * const pU, const uint32_t uLen,
+            const uint64_t * const pV, const uint32_t vLen)
+{
+	/* Function data types */
+	uint64_t un[RSA_BN_WIDE_LIMBS + 0x01u];
+	uint64_t vn[RSA_BN_WIDE_LIMBS];
+	const uint32_t shift = __builtin_clzll(pV[vLen - 0x01u]);
+	int32_t register j = 0x00u;
+	uint32_t register i = 0x00u;
+
+	/* Function body */
+	if( (uLen < vLen) )
+	{
+		if( (NULL != pQuot) ) { pQuot[0] = 0x00u; } else;
+		memset(pRem, 0x00u, sizeof(uint64_t) * vLen);
+		memcpy(pRem, pU, sizeof(uint64_t) * uLen);
+		return;
+	}
+	else;
+
+	if( (0x01u == vLen) )
+	{
+		/* Single word divisor */
+		uint64_t rem = 0x00u;
+		for(j = (int32_t) uLen - 0x01; j >= 0; --j)
+		{
+			uint128_t cur = ((uint128_t) rem << 64) | pU[j];
+			if( (NULL != pQuot) ) { pQuot[j] = (uint64_t) (cur / pV[0]); } else;
+			rem = (uint64_t) (cur % pV[0]);
+		}
+		pRem[0] = rem;
+		return;
+	}
+	else;
+
+	/* Normalize so the top bit of the divisor is set */
+	for(i = vLen - 0x01u; i > 0x00u; --i)
+	{ vn[i] = (shift) ? ((pV[i] << shift) | (pV[i - 0x01u] >> (64 - shift))) : (pV[i]); }
+	vn[0] = pV[0] << shift;
+
+	un[uLen] = (shift) ? (pU[uLen - 0x01u] >> (64 - shift)) : (0x00u);
+	for(i = uLen - 0x01u; i > 0x00u; --i)
+	{ un[i] = (shift) ? ((pU[i] << shift) | (pU[i - 0x01u] >> (64 - shift))) : (pU[i]); }
+	un[0] = pU[0] << shift;
+
+	for(j = (int32_t) (uLen - vLen); j >= 0; --j)
+	{
+		/* Estimate the quotient digit */
+		uint128_t num = ((uint128_t) un[j + vLen] << 64) | un[j + vLen - 0x01u];
+		uint128_t qhat = num / vn[vLen - 0x01u];
+		uint128_t rhat = num % vn[vLen - 0x01u];
+
+		while( (qhat >> 64) ||
+		       ((qhat * vn[vLen - 0x02u]) > ((rhat << 64) | un[j + vLen - 0x02u])) )
+		{
+			--qhat;
+			rhat += vn[vLen - 0x01u];
+			if( (rhat >> 64) ) { break; } else;
+		}
+
+		/* Multiply and subtract */
+		uint64_t borrow = 0x00u;
+		uint64_t carry = 0x00u;
+		for(i = 0x00u; i < vLen; ++i)
+		{
+			uint128_t p = (uint128_t) (uint64_t) qhat * vn[i] + carry;
+			carry = (uint64_t) (p >> 64);
+			uint64_t sub = (uint64_t) p;
+			uint64_t prev = un[i + j];
+			un[i + j] = prev - sub - borrow;
+			borrow = (prev < sub) || ((prev - sub) < borrow);
+		}
+		uint64_t prev = un[j + vLen];
+		un[j + vLen] = prev - carry - borrow;
+		borrow = (prev < carry) || ((prev - carry) < borrow);
+
+		/* Add back, happens with probability ~2/B */
+		if( (borrow) )
+		{
+			--qhat;
+			un[j + vLen] += limbsAdd(un + j, un + j, vn, vLen);
+		}
+		else;
+
+		if( (NULL != pQuot) ) { pQuot[j] = (uint64_t) qhat; } else;
+	}
+
+	/* Unnormalize the remainder */
+	for(i = 0x00u; i < vLen; ++i)
+	{ pRem[i] = (shift) ? ((un[i] >> shift) | (un[i + 0x01u] << (64 - shift))) : (un[i]); }
+}/* limbsDivMod */
+
+/*
+*--------------------------------------------------------------------------------------
+*- Basic Functions Implementation
+*--------------------------------------------------------------------------------------
+**/
+
+void
+bnZero(st_rsa_bn_t * const pRes)
+{
+	memset(pRes, 0x00u, sizeof(st_rsa_bn_t));
+}/* bnZero */
+
+void
+bnFromWord(st_rsa_bn_t * const pRes, const uint64_t word)
+{
+	bnZero(pRes);
+	pRes->limbs[0] = word;
+	pRes->used = (word) ? (0x01u) : (0x00u);
+}/* bnFromWord */
+
+void
+bnCopy(st_rsa_bn_t * const pRes, const st_rsa_bn_t * const pA)
+{
+	if( (pRes != pA) )
+	{ memcpy(pRes, pA, sizeof(st_rsa_bn_t)); }
+	else;
+}/* bnCopy */
+
+uint32_t
+bnBitLength(const st_rsa_bn_t * const pA)
+{
+	return (pA->used) ?
+		(((pA->used - 0x01u) * RSA_BN_LIMB_BITS) + (64u - __builtin_clzll(pA->limbs[pA->used - 0x01u]))) : (0x00u);
+}/* bnBitLength */
+
+uint8_t
+bnTestBit(const st_rsa_bn_t * const pA, const uint32_t bit)
+{
+	return ((bit / RSA_BN_LIMB_BITS) < pA->used) ?
+		((pA->limbs[bit / RSA_BN_LIMB_BITS] >> (bit % RSA_BN_LIMB_BITS)) & 0x01u) : (0x00u);
+}/* bnTestBit */
+
+int8_t
+bnCompare(const st_rsa_bn_t * const pA, const st_rsa_bn_t * const pB)
+{
+	if( (pA->used != pB->used) )
+	{ return (pA->used > pB->used) ? (1) : (-1); }
+	else;
+
+	return limbsCompare(pA->limbs, pB->limbs, pA->used);
+}/* bnCompare */
+
+uint8_t
+bnIsWord(const st_rsa_bn_t * const pA, const uint64_t word)
+{
+	return (0x00u == word) ? (0x00u == pA->used) : ((0x01u == pA->used) && (pA->limbs[0] == word));
+}/* bnIsWord */
+
+/*
+*--------------------------------------------------------------------------------------
+*- Arithmetic Functions Implementation
+*--------------------------------------------------------------------------------------
+**/
+
+void
+bnAdd(st_rsa_bn_t * const pRes, const st_rsa_bn_t * const pA, const st_rsa_bn_t * const pB)
+{
+	/* Function data types */
+	const uint32_t len = (pA->used > pB->used) ? (pA->used) : (pB->used);
+	uint64_t carry = 0x00u;
+
+	/* Function body */
+	carry = limbsAdd(pRes->limbs, pA->limbs, pB->limbs, len);
+
+#if (FULL_ASSERTION_FLAG == FULL_ASSERTION_ACTIVE)
+	STATIC_ASSERT(((0x00u == carry) || (len < RSA_BN_MAX_LIMBS)), DEFAULT_EXIT_CODE);
+#endif
+
+	if( (carry) )
+	{ pRes->limbs[len] = carry; }
+	else;
+	bnSetLength(pRes, len + (uint32_t) carry);
+}/* bnAdd */
+
+/**
+ * @brief pRes = pA - pB, requires pA >= pB.
+ */
+void
+bnSub(st_rsa_bn_t * const pRes, const st_rsa_bn_t * const pA, const st_rsa_bn_t * const pB)
+{
+#if (FULL_ASSERTION_FLAG == FULL_ASSERTION_ACTIVE)
+	STATIC_ASSERT((bnCompare(pA, pB) >= 0), DEFAULT_EXIT_CODE);
+#endif
+
+	limbsSub(pRes->limbs, pA->limbs, pB->limbs, pA->used);
+	bnSetLength(pRes, pA->used);
+}/* bnSub */
+
+void
+bnAddWord(st_rsa_bn_t * const pRes, const st_rsa_bn_t * const pA, const uint64_t word)
+{
+	bnCopy(pRes, pA);
+
+	uint64_t carry = limbsAddWord(pRes->limbs, pRes->used, word);
+	if( (0x00u == pRes->used) || (carry) )
+	{
+#if (FULL_ASSERTION_FLAG == FULL_ASSERTION_ACTIVE)
+		STATIC_ASSERT((pRes->used < RSA_BN_MAX_LIMBS), DEFAULT_EXIT_CODE);
+#endif
+		pRes->limbs[pRes->used] = (pRes->used) ? (carry) : (word);
+		pRes->used += (0x00u != pRes->limbs[pRes->used]);
+	}
+	else;
+}/* bnAddWord */
+
+void
+bnSubWord(st_rsa_bn_t * const pRes, const st_rsa_bn_t * const pA, const uint64_t word)
+{
+	bnCopy(pRes, pA);
+
+#if (FULL_ASSERTION_FLAG == FULL_ASSERTION_ACTIVE)
+	STATIC_ASSERT(((pRes->used > 0x01u) || (pRes->limbs[0] >= word)), DEFAULT_EXIT_CODE);
+#endif
+
+	limbsSubWord(pRes->limbs, pRes->used, word);
+	pRes->used = limbsNormalize(pRes->limbs, pRes->used);
+}/* bnSubWord */
+
+void
+bnShiftRight(st_rsa_bn_t * const pRes, const st_rsa_bn_t * const pA, const uint32_t bits)
+{
+	/* Function data types */
+	const uint32_t limbShift = bits / RSA_BN_LIMB_BITS;
+	const uint32_t bitShift = bits % RSA_BN_LIMB_BITS;
+	uint32_t register i = 0x00u;
+	uint32_t len = 0x00u;
+
+	/* Function body */
+	if( (limbShift >= pA->used) )
+	{ bnZero(pRes); return; }
+	else;
+
+	len = pA->used - limbShift;
+	for(i = 0x00u; i < len; ++i)
+	{
+		uint64_t lo = pA->limbs[i + limbShift];
+		uint64_t hi = ((i + limbShift + 0x01u) < pA->used) ? (pA->limbs[i + limbShift + 0x01u]) : (0x00u);
+		pRes->limbs[i] = (bitShift) ? ((lo >> bitShift) | (hi << (64 - bitShift))) : (lo);
+	}
+	bnSetLength(pRes, len);
+}/* bnShiftRight */
+
+void
+bnMul(st_rsa_bn_t * const pRes, const st_rsa_bn_t * const pA, const st_rsa_bn_t * const pB)
+{
+	/* Function data types */
+	uint64_t prod[RSA_BN_WIDE_LIMBS];
+	uint32_t len = pA->used + pB->used;
+
+	/* Function body */
+	if( (0x00u == pA->used) || (0x00u == pB->used) )
+	{ bnZero(pRes); return; }
+	else;
+
+	if( (pA->used == pB->used) )
+	{
+		if( (pA == pB) ) { limbsSqr(prod, pA->limbs, pA->used); }
+		else { limbsMul(prod, pA->limbs, pB->limbs, pA->used); }
+	}
+	else
+	{ limbsMulSchool(prod, pA->limbs, pA->used, pB->limbs, pB->used); }
+
+	len = limbsNormalize(prod, len);
+
+#if (FULL_ASSERTION_FLAG == FULL_ASSERTION_ACTIVE)
+	STATIC_ASSERT((len <= RSA_BN_MAX_LIMBS), DEFAULT_EXIT_CODE);
+#endif
+
+	bnZero(pRes);
+	memcpy(pRes->limbs, prod, sizeof(uint64_t) * len);
+	pRes->used = len;
+}/* bnMul */
+
+void
+bnDivMod(st_rsa_bn_t * const pQuot, st_rsa_bn_t * const pRem,
+         const st_rsa_bn_t * const pA, const st_rsa_bn_t * const pM)
+{
+	/* Validating */
+#if (FULL_ASSERTION_FLAG == FULL_ASSERTION_ACTIVE)
+	STATIC_ASSERT((pM->used > 0x00u), DEFAULT_EXIT_CODE);
+#endif
+	/* Function data types */
+	uint64_t quot[RSA_BN_WIDE_LIMBS];
+	uint64_t rem[RSA_BN_WIDE_LIMBS];
+	const uint32_t qLen = (pA->used >= pM->used) ? (pA->used - pM->used + 0x01u) : (0x01u);
+
+	/* Function body */
+	limbsDivMod(quot, rem, pA->limbs, pA->used, pM->limbs, pM->used);
+
+	if( (NULL != pQuot) )
+	{
+		bnZero(pQuot);
+		memcpy(pQuot->limbs, quot, sizeof(uint64_t) * qLen);
+		pQuot->used = limbsNormalize(pQuot->limbs, qLen);
+	}
+	else;
+
+	bnZero(pRem);
+	memcpy(pRem->limbs, rem, sizeof(uint64_t) * pM->used);
+	pRem->used = limbsNormalize(pRem->limbs, pM->used);
+}/* bnDivMod */
+
+void
+bnMod(st_rsa_bn_t * const pRes, const st_rsa_bn_t * const pA, const st_rsa_bn_t * const pM)
+{
+	if( (bnCompare(pA, pM) < 0) )
+	{ bnCopy(pRes, pA); }
+	else
+	{ bnDivMod(NULL, pRes, pA, pM); }
+}/* bnMod */
+
+uint64_t
+bnModWord(const st_rsa_bn_t * const pA, const uint64_t word)
+{
+	/* Function data types */
+	uint64_t rem = 0x00u;
+	int32_t register i = (int32_t) pA->used - 0x01;
+
+	/* Function body */
+	for(; i >= 0; --i)
+	{ rem = (uint64_t) ((((uint128_t) rem << 64) | pA->limbs[i]) % word); }
+
+	return rem;
+}/* bnModWord */
+
+void
+bnMulMod(st_rsa_bn_t * const pRes, const st_rsa_bn_t * const pA,
+         const st_rsa_bn_t * const pB, const st_rsa_bn_t * const pM)
+{
+	/* Function data types */
+	uint64_t prod[RSA_BN_WIDE_LIMBS];
+	uint64_t rem[RSA_BN_WIDE_LIMBS];
+	uint32_t len = pA->used + pB->used;
+
+	/* Function body */
+	if( (0x00u == pA->used) || (0x00u == pB->used) )
+	{ bnZero(pRes); return; }
+	else;
+
+	limbsMulSchool(prod, pA->limbs, pA->used, pB->limbs, pB->used);
+	len = limbsNormalize(prod, len);
+	limbsDivMod(NULL, rem, prod, len, pM->limbs, pM->used);
+
+	bnZero(pRes);
+	memcpy(pRes->limbs, rem, sizeof(uint64_t) * pM->used);
+	pRes->used = limbsNormalize(pRes->limbs, pM->used);
+}/* bnMulMod */
+
+/*
+*--------------------------------------------------------------------------------------
+*- Montgomery Functions Implementation
+*--------------------------------------------------------------------------------------
+**/
+
+void
+bnMontInit(st_rsa_bn_mont_t * const pMont, const st_rsa_bn_t * const pN)
+{
+	/* Validating */
+#if (FULL_ASSERTION_FLAG == FULL_ASSERTION_ACTIVE)
+	STATIC_ASSERT((pN->used > 0x00u), DEFAULT_EXIT_CODE);
+	STATIC_ASSERT((pN->limbs[0] & 0x01u), DEFAULT_EXIT_CODE);
+#endif
+	/* Function data types */
+	uint64_t pow[RSA_BN_WIDE_LIMBS];
+	uint64_t rem[RSA_BN_WIDE_LIMBS];
+	const uint32_t len = pN->used;
+	uint64_t inv = pN->limbs[0];
+	uint8_t register i = 0x00u;
+
+	/* Function body */
+	/* Newton iterations, each one doubles the correct low bits (3 -> 96) */
+	for(; i < 0x05u; ++i)
+	{ inv *= 0x02u - (pN->limbs[0] * inv); }
+
+	bnCopy(&pMont->n, pN);
+	pMont->n0inv = 0x00u - inv;
+	pMont->len = len;
+
+	/* R mod n */
+	memset(pow, 0x00u, sizeof(uint64_t) * (len + 0x01u));
+	pow[len] = 0x01u;
+	limbsDivMod(NULL, rem, pow, len + 0x01u, pN->limbs, len);
+	bnZero(&pMont->one);
+	memcpy(pMont->one.limbs, rem, sizeof(uint64_t) * len);
+	pMont->one.used = limbsNormalize(pMont->one.limbs, len);
+
+	/* R^2 mod n */
+	memset(pow, 0x00u, sizeof(uint64_t) * ((len * 0x02u) + 0x01u));
+	pow[len * 0x02u] = 0x01u;
+	limbsDivMod(NULL, rem, pow, (len * 0x02u) + 0x01u, pN->limbs, len);
+	bnZero(&pMont->rr);
+	memcpy(pMont->rr.limbs, rem, sizeof(uint64_t) * len);
+	pMont->rr.used = limbsNormalize(pMont->rr.limbs, len);
+}/* bnMontInit */
+
+void
+bnMontMul(const st_rsa_bn_mont_t * const pMont, st_rsa_bn_t * const pRes,
+          const st_rsa_bn_t * const pA, const st_rsa_bn_t * const pB)
+{
+	uint64_t t[RSA_BN_WIDE_LIMBS];
+	const st_rsa_mod_kernels_t *pKernels = modGetKernels(pMont->len);
+
+	if( (NULL != pKernels) && (pA == pB) )
+	{ pKernels->pfMontSqr(pRes->limbs, pA->limbs, pMont->n.limbs, pMont->n0inv); }
+	else if( (NULL != pKernels) && (NULL != pKernels->pfMontMul) )
+	{ pKernels->pfMontMul(pRes->limbs, pA->limbs, pB->limbs, pMont->n.limbs, pMont->n0inv); }
+	else
+	{
+		if( (pA == pB) )
+		{ limbsSqr(t, pA->limbs, pMont->len); }
+		else
+		{ limbsMul(t, pA->limbs, pB->limbs, pMont->len); }
+		limbsMontRedc(pRes->limbs, t, pMont->n.limbs, pMont->n0inv, pMont->len);
+	}
+	bnSetLength(pRes, pMont->len);
+
+	RSA_STATS_ADD(montMultiplies, 0x01u);
+}/* bnMontMul */
+
+void
+bnMontSqr(const st_rsa_bn_mont_t * const pMont, st_rsa_bn_t * const pRes, const st_rsa_bn_t * const pA)
+{
+	uint64_t t[RSA_BN_WIDE_LIMBS];
+	const st_rsa_mod_kernels_t *pKernels = modGetKernels(pMont->len);
+
+	if( (NULL != pKernels) )
+	{ pKernels->pfMontSqr(pRes->limbs, pA->limbs, pMont->n.limbs, pMont->n0inv); }
+	else
+	{
+		limbsSqr(t, pA->limbs, pMont->len);
+		limbsMontRedc(pRes->limbs, t, pMont->n.limbs, pMont->n0inv, pMont->len);
+	}
+	bnSetLength(pRes, pMont->len);
+
+	RSA_STATS_ADD(montSquarings, 0x01u);
+}/* bnMontSqr */
+
+void
+bnMontToForm(const st_rsa_bn_mont_t * const pMont, st_rsa_bn_t * const pRes, const st_rsa_bn_t * const pA)
+{
+	st_rsa_bn_t reduced;
+
+	bnMod(&reduced, pA, &pMont->n);
+	bnMontMul(pMont, pRes, &reduced, &pMont->rr);
+}/* bnMontToForm */
+
+void
+bnMontFromForm(const st_rsa_bn_mont_t * const pMont, st_rsa_bn_t * const pRes, const st_rsa_bn_t * const pA)
+{
+	uint64_t t[RSA_BN_WIDE_LIMBS];
+
+	memset(t, 0x00u, sizeof(uint64_t) * ((pMont->len * 0x02u) + 0x01u));
+	memcpy(t, pA->limbs, sizeof(uint64_t) * pMont->len);
+	limbsMontRedc(pRes->limbs, t, pMont->n.limbs, pMont->n0inv, pMont->len);
+	bnSetLength(pRes, pMont->len);
+}/* bnMontFromForm */
+
+/*
+*--------------------------------------------------------------------------------------
+*- Number Theory Functions Implementation
+*--------------------------------------------------------------------------------------
+**/
+
+/**
+ * @brief Fills the odd powers table g, g^3, ..., g^(2 * tableSize - 1) in
+ * 			  the montgomery domain.
+ * @return Number of montgomery multiplications and squarings spent.
+ */
+static uint32_t
+expOddPowers(const st_rsa_bn_mont_t * const pMont, st_rsa_bn_t * const pTable,
+             const st_rsa_bn_t * const pBase, const uint32_t tableSize)
+{
+	/* Function data types */
+	st_rsa_bn_t baseSqr;
+	uint32_t register k = 0x00u;
+
+	/* Function body */
+	bnCopy(&pTable[0], pBase);
+	if( (tableSize <= 0x01u) )
+	{ return 0x00u; }
+	else;
+
+	bnMontSqr(pMont, &baseSqr, pBase);
+	for(k = 0x01u; k < tableSize; ++k)
+	{ bnMontMul(pMont, &pTable[k], &pTable[k - 0x01u], &baseSqr); }
+
+	return tableSize;
+}/* expOddPowers */
+
+/**
+ * @brief Longest window [top..low] of at most windowBits bits of the exponent
+ * 			  starting at the set bit `top` and ending with a set bit.
+ * @return The lowest bit of the window, its value is written to pValue.
+ */
+static int32_t
+expWindow(const st_rsa_bn_t * const pExp, const int32_t top,
+          const uint32_t windowBits, uint32_t * const pValue)
+{
+	/* Function data types */
+	int32_t low = ((top - (int32_t) windowBits + 0x01) > 0) ? (top - (int32_t) windowBits + 0x01) : (0);
+	uint32_t value = 0x00u;
+	uint32_t register k = 0x00u;
+
+	/* Function body */
+	while( (0x00u == bnTestBit(pExp, (uint32_t) low)) )
+	{ ++low; }
+
+	for(k = (uint32_t) top + 0x01u; k-- > (uint32_t) low;)
+	{ value = (value << 0x01u) | bnTestBit(pExp, k); }
+
+	*pValue = value;
+
+	return low;
+}/* expWindow */
+
+/**
+ * @brief Left-to-right sliding window exponentiation, base and result are
+ * 			  both in the montgomery domain.
+ * 				The odd powers g, g^3, ..., g^(2^k - 1) are precomputed, then every
+ * 				window of at most k bits starting and ending with a set bit costs a
+ * 				single multiplication, runs of zero bits only cost squarings.
+ */
+static void
+bnMontPow(const st_rsa_bn_mont_t * const pMont, st_rsa_bn_t * const pRes,
+          const st_rsa_bn_t * const pBase, const st_rsa_bn_t * const pExp,
+          st_rsa_bn_exp_stats_t * const pStats)
+{
+	/* Function data types */
+	st_rsa_bn_t table[0x01u << (RSA_EXP_MAX_WINDOW_BITS - 0x01u)];
+	st_rsa_bn_t acc;
+	const uint32_t bits = bnBitLength(pExp);
+	const uint32_t windowBits = RSA_EXP_WINDOW_BITS(bits);
+	const uint32_t tableSize = 0x01u << (windowBits - 0x01u);
+	uint64_t squarings = 0x00u;
+	uint64_t multiplies = 0x00u;
+	uint32_t value = 0x00u;
+	uint8_t started = 0x00u;
+	int32_t register i = (int32_t) bits - 0x01;
+	int32_t register j = 0x00;
+	uint32_t register k = 0x00u;
+
+	/* Function body */
+	/* Odd powers table, one squaring and tableSize - 1 multiplications */
+	if( (expOddPowers(pMont, table, pBase, tableSize) > 0x00u) )
+	{
+		++squarings;
+		multiplies += tableSize - 0x01u;
+	}
+	else;
+
+	bnCopy(&acc, &pMont->one);
+
+	while( (i >= 0) )
+	{
+		if( (0x00u == bnTestBit(pExp, (uint32_t) i)) )
+		{
+			bnMontSqr(pMont, &acc, &acc);
+			++squarings;
+			--i;
+			continue;
+		}
+		else;
+
+		j = expWindow(pExp, i, windowBits, &value);
+
+		if( (started) )
+		{
+			for(k = 0x00u; k <= (uint32_t) (i - j); ++k)
+			{ bnMontSqr(pMont, &acc, &acc); }
+			squarings += (uint32_t) (i - j) + 0x01u;
+
+			bnMontMul(pMont, &acc, &acc, &table[value >> 0x01u]);
+			++multiplies;
+		}
+		else
+		{
+			/* The leading window only loads the table entry */
+			bnCopy(&acc, &table[value >> 0x01u]);
+			started = 0x01u;
+		}
+
+		i = j - 0x01;
+	}
+
+	bnCopy(pRes, &acc);
+
+	RSA_STATS_ADD(powModCalls, 0x01u);
+
+	if( (NULL != pStats) )
+	{
+		pStats->squarings += squarings;
+		pStats->multiplies += multiplies;
+		pStats->windowBits = windowBits;
+	}
+	else;
+}/* bnMontPow */
+
+/**
+ * @brief pRes = pBase ^ pExp mod n, every step stays in the montgomery domain
+ * 			  and only the final result is converted back.
+ * 				The number of montgomery squarings and multiplications is added to
+ * 				pStats when it isn't NULL.
+ */
+void
+bnPowModStats(const st_rsa_bn_mont_t * const pMont, st_rsa_bn_t * const pRes,
+              const st_rsa_bn_t * const pBase, const st_rsa_bn_t * const pExp,
+              st_rsa_bn_exp_stats_t * const pStats)
+{
+	st_rsa_bn_t base;
+
+	bnMontToForm(pMont, &base, pBase);
+	bnMontPow(pMont, &base, &base, pExp, pStats);
+	bnMontFromForm(pMont, pRes, &base);
+}/* bnPowModStats */
+
+void
+bnPowMod(const st_rsa_bn_mont_t * const pMont, st_rsa_bn_t * const pRes,
+         const st_rsa_bn_t * const pBase, const st_rsa_bn_t * const pExp)
+{
+	bnPowModStats(pMont, pRes, pBase, pExp, NULL);
+}/* bnPowMod */
+
+/**
+ * @brief Recodes the exponent into the windows walked by bnMontPow(), the
+ * 			  plan is left unusable (windowBits 0) when the exponent needs more
+ * 				than RSA_BN_EXP_PLAN_MAX_WINDOWS windows.
+ */
+void
+bnExpPlanInit(st_rsa_bn_exp_plan_t * const pPlan, const st_rsa_bn_t * const pExp)
+{
+	/* Function data types */
+	const uint32_t bits = bnBitLength(pExp);
+	const uint32_t windowBits = RSA_EXP_WINDOW_BITS(bits);
+	uint32_t pending = 0x00u;
+	uint32_t value = 0x00u;
+	int32_t register i = (int32_t) bits - 0x01;
+	int32_t register j = 0x00;
+
+	/* Function body */
+	memset(pPlan, 0x00u, sizeof(st_rsa_bn_exp_plan_t));
+
+	while( (i >= 0) )
+	{
+		if( (0x00u == bnTestBit(pExp, (uint32_t) i)) )
+		{
+			++pending;
+			--i;
+			continue;
+		}
+		else if( (RSA_BN_EXP_PLAN_MAX_WINDOWS == pPlan->numOfWindows) )
+		{ return; }
+		else;
+
+		j = expWindow(pExp, i, windowBits, &value);
+
+		/* The leading window is loaded, the others square over their bits */
+		pPlan->squarings[pPlan->numOfWindows] = (pPlan->numOfWindows > 0x00u) ?
+		                                        ((uint16_t) (pending + (uint32_t) (i - j) + 0x01u)) : (0x00u);
+		pPlan->index[pPlan->numOfWindows] = (uint8_t) (value >> 0x01u);
+		++pPlan->numOfWindows;
+
+		pending = 0x00u;
+		i = j - 0x01;
+	}
+
+	pPlan->tailSquarings = pending;
+	pPlan->windowBits = windowBits;
+}/* bnExpPlanInit */
+
+/**
+ * @brief pRes = pBase ^ pExp mod n replaying the windows recoded by
+ * 			  bnExpPlanInit() for pExp, a plan that couldn't hold the exponent
+ * 				falls back to bnPowMod().
+ */
+void
+bnPowModPlan(const st_rsa_bn_mont_t * const pMont, st_rsa_bn_t * const pRes,
+             const st_rsa_bn_t * const pBase, const st_rsa_bn_t * const pExp,
+             const st_rsa_bn_exp_plan_t * const pPlan)
+{
+	/* Function data types */
+	st_rsa_bn_t table[0x01u << (RSA_EXP_MAX_WINDOW_BITS - 0x01u)];
+	st_rsa_bn_t acc;
+	uint32_t register w = 0x00u;
+	uint32_t register k = 0x00u;
+
+	/* Function body */
+	if( (0x00u == pPlan->windowBits) )
+	{
+		bnPowModStats(pMont, pRes, pBase, pExp, NULL);
+		return;
+	}
+	else;
+
+	bnMontToForm(pMont, &acc, pBase);
+	expOddPowers(pMont, table, &acc, 0x01u << (pPlan->windowBits - 0x01u));
+
+	if( (pPlan->numOfWindows > 0x00u) )
+	{ bnCopy(&acc, &table[pPlan->index[0]]); }
+	else
+	{ bnCopy(&acc, &pMont->one); }
+
+	for(w = 0x01u; w < pPlan->numOfWindows; ++w)
+	{
+		for(k = 0x00u; k < pPlan->squarings[w]; ++k)
+		{ bnMontSqr(pMont, &acc, &acc); }
+		bnMontMul(pMont, &acc, &acc, &table[pPlan->index[w]]);
+	}
+
+	for(k = 0x00u; k < pPlan->tailSquarings; ++k)
+	{ bnMontSqr(pMont, &acc, &acc); }
+
+	bnMontFromForm(pMont, pRes, &acc);
+
+	RSA_STATS_ADD(powModCalls, 0x01u);
+}/* bnPowModPlan */
+
+/**
+ * @brief Number of Miller-Rabin rounds giving an error below 2^-80 for
+ * 			  random candidates of the given size.
+ */
+_STATIC_INLINE uint32_t
+getMillerRabinRounds(const uint32_t bits)
+{
+	return (bits >= 3747u) ? (3u) : (bits >= 1345u) ? (4u) : (bits >= 476u) ? (5u) :
+	       (bits >= 400u) ? (6u) : (bits >= 347u) ? (7u) : (bits >= 308u) ? (8u) :
+	       (bits >= 55u) ? (27u) : (34u);
+}/* getMillerRabinRounds */
+
+/**
+ * @brief Trial division by the small primes followed by Miller-Rabin.
+ */
+en_PrimeNumbersStatus_t
+bnIsPrimeNumber(const st_rsa_bn_t * const pA)
+{
+	/* Function data types */
+	uint32_t register i = 0x00u;
+
+	/* Function body */
+	if( (bnBitLength(pA) <= 0x08u) )
+	{
+		for(i = 0x00u; i < BN_NUM_OF_TRIAL_PRIMES; ++i)
+		{
+			if( (bnIsWord(pA, bnTrialPrimes[i])) )
+			{ return numberIsPrime; }
+			else;
+		}
+		return numberNotPrime;
+	}
+	else;
+
+	for(i = 0x00u; i < BN_NUM_OF_TRIAL_PRIMES; ++i)
+	{
+		if( (0x00u == bnModWord(pA, bnTrialPrimes[i])) )
+		{ return numberNotPrime; }
+		else;
+	}
+
+	return bnMillerRabin(pA);
+}/* bnIsPrimeNumber */
+
+/**
+ * @brief Miller-Rabin primality test with random bases, the witness loop
+ * 			  runs in the montgomery domain. The candidate must be odd and have
+ * 				more than 8 bits, callers are expected to filter small factors.
+ */
+en_PrimeNumbersStatus_t
+bnMillerRabin(const st_rsa_bn_t * const pA)
+{
+	/* Validating */
+#if (FULL_ASSERTION_FLAG == FULL_ASSERTION_ACTIVE)
+	STATIC_ASSERT((pA->limbs[0] & 0x01u), DEFAULT_EXIT_CODE);
+	STATIC_ASSERT((bnBitLength(pA) > 0x08u), DEFAULT_EXIT_CODE);
+#endif
+	/* Function data types */
+	st_rsa_bn_mont_t mont;
+	st_rsa_bn_t nMinusOne;
+	st_rsa_bn_t montMinusOne;
+	st_rsa_bn_t t;
+	st_rsa_bn_t base;
+	st_rsa_bn_t B;
+	const uint32_t bits = bnBitLength(pA);
+	uint32_t rounds = getMillerRabinRounds(bits);
+	uint32_t s = 0x00u;
+	uint32_t register i = 0x00u;
+
+	/* Function body */
+	/* n - 1 = 2^s * t */
+	bnSubWord(&nMinusOne, pA, 0x01u);
+	while( (0x00u == bnTestBit(&nMinusOne, s)) )
+	{ ++s; }
+	bnShiftRight(&t, &nMinusOne, s);
+
+	bnMontInit(&mont, pA);
+	bnSub(&montMinusOne, pA, &mont.one);
+
+	while(rounds--)
+	{
+		RSA_STATS_ADD(mrRounds, 0x01u);
+
+		/* Random base in [2, n - 2] */
+		do
+		{ bnRandom(&base, bits - 0x01u, RSA_BN_RAND_TOP_ANY); }
+		while( (bnBitLength(&base) < 0x02u) );
+
+		bnMontToForm(&mont, &base, &base);
+		bnMontPow(&mont, &B, &base, &t, NULL);
+
+		if( (0x00u == bnCompare(&B, &mont.one)) || (0x00u == bnCompare(&B, &montMinusOne)) )
+		{ continue; }
+		else;
+
+		for(i = 0x01u; i < s; ++i)
+		{
+			bnMontSqr(&mont, &B, &B);
+			if( (0x00u == bnCompare(&B, &montMinusOne)) )
+			{ break; }
+			else if( (0x00u == bnCompare(&B, &mont.one)) )
+			{ return numberNotPrime; }
+			else;
+		}
+
+		if( (i == s) )
+		{ return numberNotPrime; }
+		else;
+	}
+
+	return numberIsPrime;
+}/* bnMillerRabin */
+
+/**
+ * @brief Number of trailing zero bits, 0 for zero.
+ */
+_STATIC_INLINE uint32_t
+bnTrailingZeros(const st_rsa_bn_t * const pA)
+{
+	/* Function data types */
+	uint32_t register i = 0x00u;
+
+	/* Function body */
+	for(i = 0x00u; i < pA->used; ++i)
+	{
+		if( (pA->limbs[i]) )
+		{ return (i * RSA_BN_LIMB_BITS) + (uint32_t) __builtin_ctzll(pA->limbs[i]); }
+		else;
+	}
+
+	return 0x00u;
+}/* bnTrailingZeros */
+
+/**
+ * @brief pX = pX / 2 mod m for an odd m and pX < m, an odd pX is made even
+ * 			  by adding m first and the carry out is shifted back in.
+ */
+static void
+bnHalveMod(st_rsa_bn_t * const pX, const st_rsa_bn_t * const pM)
+{
+	/* Function data types */
+	const uint32_t len = pM->used;
+	uint64_t carry = 0x00u;
+	uint32_t register i = 0x00u;
+
+	/* Function body */
+	if( (pX->limbs[0] & 0x01u) )
+	{ carry = limbsAdd(pX->limbs, pX->limbs, pM->limbs, len); }
+	else;
+
+	for(i = 0x00u; i < len; ++i)
+	{
+		uint64_t hi = ((i + 0x01u) < len) ? (pX->limbs[i + 0x01u]) : (carry);
+		pX->limbs[i] = (pX->limbs[i] >> 0x01u) | (hi << 63);
+	}
+	bnSetLength(pX, len);
+}/* bnHalveMod */
+
+/**
+ * @brief pRes = pA - pB mod m for pA, pB < m.
+ */
+static void
+bnSubMod(st_rsa_bn_t * const pRes, const st_rsa_bn_t * const pA,
+         const st_rsa_bn_t * const pB, const st_rsa_bn_t * const pM)
+{
+	/* Function data types */
+	st_rsa_bn_t diff;
+
+	/* Function body */
+	if( (bnCompare(pA, pB) >= 0) )
+	{ bnSub(pRes, pA, pB); }
+	else
+	{
+		bnSub(&diff, pM, pB);
+		bnAdd(pRes, &diff, pA);
+	}
+}/* bnSubMod */
+
+/**
+ * @brief Binary (Stein) greatest common divisor, the loop only shifts and
+ * 			  subtracts.
+ */
+void
+bnGetGCD(st_rsa_bn_t * const pRes, const st_rsa_bn_t * const pA, const st_rsa_bn_t * const pB)
+{
+	/* Function data types */
+	st_rsa_bn_t values[0x02u];
+	st_rsa_bn_t *pSmall = &values[0];
+	st_rsa_bn_t *pLarge = &values[1];
+	st_rsa_bn_t *pSwap = NULL;
+	uint32_t shift = 0x00u;
+	uint64_t iterations = 0x00u;
+
+	/* Function body */
+	if( (0x00u == pA->used) || (0x00u == pB->used) )
+	{
+		bnCopy(pRes, (pA->used) ? (pA) : (pB));
+		return;
+	}
+	else;
+
+	shift = bnTrailingZeros(pA);
+	if( (bnTrailingZeros(pB) < shift) )
+	{ shift = bnTrailingZeros(pB); }
+	else;
+
+	bnShiftRight(pSmall, pA, bnTrailingZeros(pA));
+	bnCopy(pLarge, pB);
+
+	/* Both odd from here, their difference is even and loses its low zeros */
+	do
+	{
+		++iterations;
+		bnShiftRight(pLarge, pLarge, bnTrailingZeros(pLarge));
+
+		if( (bnCompare(pSmall, pLarge) > 0) )
+		{
+			pSwap = pSmall;
+			pSmall = pLarge;
+			pLarge = pSwap;
+		}
+		else;
+
+		bnSub(pLarge, pLarge, pSmall);
+	}
+	while( (pLarge->used) );
+
+	/* pRes = pSmall * 2^shift */
+	bnFromWord(pLarge, 0x01u);
+	while( (shift--) )
+	{ bnAdd(pLarge, pLarge, pLarge); }
+	bnMul(pRes, pSmall, pLarge);
+
+	RSA_STATS_ADD(gcdIterations, iterations);
+}/* bnGetGCD */
+
+/**
+ * @brief Modular inverse for an odd modulus by the binary extended euclidean
+ * 			  algorithm, u = x1 * a and v = x2 * a (mod m) hold through the loop
+ * 				which only shifts, adds and subtracts.
+ * @return 1 when the inverse exists, 0 otherwise.
+ */
+static uint8_t
+bnModInverseOdd(st_rsa_bn_t * const pRes, const st_rsa_bn_t * const pA, const st_rsa_bn_t * const pM)
+{
+	/* Function data types */
+	st_rsa_bn_t u, v, x1, x2;
+	uint64_t iterations = 0x00u;
+	uint8_t inverseStatus = 0x01u;
+
+	/* Function body */
+	bnMod(&u, pA, pM);
+	bnCopy(&v, pM);
+	bnFromWord(&x1, 0x01u);
+	bnZero(&x2);
+
+	if( (0x00u == u.used) || (bnIsWord(pM, 0x01u)) )
+	{ return 0x00u; }
+	else;
+
+	while( (!bnIsWord(&u, 0x01u)) && (!bnIsWord(&v, 0x01u)) )
+	{
+		++iterations;
+
+		while( (0x00u == (u.limbs[0] & 0x01u)) )
+		{
+			bnShiftRight(&u, &u, 0x01u);
+			bnHalveMod(&x1, pM);
+		}
+		while( (0x00u == (v.limbs[0] & 0x01u)) )
+		{
+			bnShiftRight(&v, &v, 0x01u);
+			bnHalveMod(&x2, pM);
+		}
+
+		if( (bnCompare(&u, &v) >= 0) )
+		{
+			bnSub(&u, &u, &v);
+			bnSubMod(&x1, &x1, &x2, pM);
+		}
+		else
+		{
+			bnSub(&v, &v, &u);
+			bnSubMod(&x2, &x2, &x1, pM);
+		}
+
+		/* Equal odd values above one, they share a factor */
+		if( (0x00u == u.used) || (0x00u == v.used) )
+		{
+			inverseStatus = 0x00u;
+			break;
+		}
+		else;
+	}
+
+	RSA_STATS_ADD(gcdIterations, iterations);
+
+	if( (inverseStatus) )
+	{ bnCopy(pRes, (bnIsWord(&u, 0x01u)) ? (&x1) : (&x2)); }
+	else;
+
+	return inverseStatus;
+}/* bnModInverseOdd */
+
+/**
+ * @brief Modular inverse using the extended euclidean algorithm, the
+ * 			  bezout coefficient is kept reduced mod m so it never goes negative.
+ * 				Only used for an even modulus with a multi-limb operand.
+ * @return 1 when the inverse exists, 0 otherwise.
+ */
+static uint8_t
+bnModInverseEuclid(st_rsa_bn_t * const pRes, const st_rsa_bn_t * const pA, const st_rsa_bn_t * const pM)
+{
+	/* Function data types */
+	st_rsa_bn_t oldR, r, oldT, t, quot, rem, prod, next;
+
+	/* Function body */
+	bnCopy(&oldR, pM);
+	bnMod(&r, pA, pM);
+	bnZero(&oldT);
+	bnFromWord(&t, 0x01u);
+
+	while( (r.used) )
+	{
+		RSA_STATS_ADD(gcdIterations, 0x01u);
+		bnDivMod(&quot, &rem, &oldR, &r);
+		bnCopy(&oldR, &r);
+		bnCopy(&r, &rem);
+
+		/* next = (oldT - quot * t) mod m */
+		bnMod(&quot, &quot, pM);
+		bnMulMod(&prod, &quot, &t, pM);
+		bnSubMod(&next, &oldT, &prod, pM);
+		bnCopy(&oldT, &t);
+		bnCopy(&t, &next);
+	}
+
+	if( (!bnIsWord(&oldR, 0x01u)) )
+	{ return 0x00u; }
+	else;
+
+	bnCopy(pRes, &oldT);
+	return 0x01u;
+}/* bnModInverseEuclid */
+
+/**
+ * @brief Modular inverse of pA modulo pM.
+ * 				An odd modulus runs the binary extended euclidean algorithm. An even
+ * 				modulus (d = e^-1 mod phi) with a single word r = a mod m swaps the
+ * 				roles: with y = m^-1 mod r, found by the 64-bit binary inverse, and
+ * 				k = r - y, r^-1 mod m = (1 + k * m) / r = k * (m / r) + (1 + k * (m mod r)) / r.
+ * @return 1 when the inverse exists, 0 otherwise.
+ */
+uint8_t
+bnModInverse(st_rsa_bn_t * const pRes, const st_rsa_bn_t * const pA, const st_rsa_bn_t * const pM)
+{
+	/* Function data types */
+	st_rsa_bn_t r;
+	st_rsa_bn_t quot;
+	st_rsa_bn_t rem;
+	uint64_t k = 0x00u;
+
+	/* Function body */
+	if( (0x00u == pM->used) )
+	{ return 0x00u; }
+	else if( (pM->limbs[0] & 0x01u) )
+	{ return bnModInverseOdd(pRes, pA, pM); }
+	else;
+
+	bnMod(&r, pA, pM);
+	if( (0x00u == (r.limbs[0] & 0x01u)) )
+	{ return 0x00u; }
+	else if( (r.used > 0x01u) )
+	{ return bnModInverseEuclid(pRes, pA, pM); }
+	else if( (bnIsWord(&r, 0x01u)) )
+	{
+		bnCopy(pRes, &r);
+		return 0x01u;
+	}
+	else;
+
+	bnDivMod(&quot, &rem, pM, &r);
+	k = modInverse(rem.limbs[0], r.limbs[0]);
+	if( (0x00u == k) )
+	{ return 0x00u; }
+	else;
+
+	k = r.limbs[0] - k;
+	bnFromWord(&rem, (uint64_t) ((((uint128_t) k * rem.limbs[0]) + 0x01u) / r.limbs[0]));
+	bnFromWord(&r, k);
+	bnMul(pRes, &quot, &r);
+	bnAdd(pRes, pRes, &rem);
+
+	return 0x01u;
+}/* bnModInverse */
+
+/**
+ * @brief Inverts `count` values modulo the odd montgomery modulus with a
+ * 			  single modular inverse (montgomery's trick): the prefix products
+ * 				a0 * ... * ai are inverted once then peeled off from the last one,
+ * 				3 * (count - 1) montgomery multiplications. pRes must not alias pA.
+ * @return 1 when every value is invertible, 0 otherwise (pRes is then undefined).
+ */
+uint8_t
+bnModInverseBatch(const st_rsa_bn_mont_t * const pMont, st_rsa_bn_t * const pRes,
+                  const st_rsa_bn_t * const pA, const uint32_t count)
+{
+	/* Function data types */
+	st_rsa_bn_t inv;
+	st_rsa_bn_t tmp;
+	uint32_t register i = 0x00u;
+
+	/* Function body */
+	if( (0x00u == count) )
+	{ return 0x01u; }
+	else;
+
+	/* pRes[i] = a0 * ... * ai in the montgomery domain */
+	bnMontToForm(pMont, &pRes[0], &pA[0]);
+	for(i = 0x01u; i < count; ++i)
+	{
+		bnMontToForm(pMont, &tmp, &pA[i]);
+		bnMontMul(pMont, &pRes[i], &pRes[i - 0x01u], &tmp);
+	}
+
+	/* inv = (a0 * ... * an)^-1 in the montgomery domain */
+	bnMontFromForm(pMont, &tmp, &pRes[count - 0x01u]);
+	if( (0x00u == bnModInverse(&inv, &tmp, &pMont->n)) )
+	{ return 0x00u; }
+	else;
+	bnMontToForm(pMont, &inv, &inv);
+
+	for(i = count - 0x01u; i > 0x00u; --i)
+	{
+		/* ai^-1 = (a0 * ... * ai)^-1 * (a0 * ... * ai-1), then drop ai */
+		bnMontToForm(pMont, &tmp, &pA[i]);
+		bnMontMul(pMont, &pRes[i], &inv, &pRes[i - 0x01u]);
+		bnMontMul(pMont, &inv, &inv, &tmp);
+		bnMontFromForm(pMont, &pRes[i], &pRes[i]);
+	}
+	bnMontFromForm(pMont, &pRes[0], &inv);
+
+	return 0x01u;
+}/* bnModInverseBatch */
+
+/*
+*--------------------------------------------------------------------------------------
+*- Conversion Functions Implementation
+*--------------------------------------------------------------------------------------
+**/
+
+void
+bnGetRandomBytes(uint8_t * const pBuf, const uint32_t len)
+{
+	/* Function data types */
+	uint32_t filled = 0x00u;
+
+	/* Function body */
+	while( (filled < len) )
+	{
+		ssize_t got = getrandom(pBuf + filled, len - filled, 0x00u);
+		if( (got > 0) )
+		{ filled += (uint32_t) got; }
+		else
+		{
+#if (FULL_ASSERTION_FLAG == FULL_ASSERTION_ACTIVE)
+			STATIC_ASSERT((0), DEFAULT_EXIT_CODE);
+#endif
+			break;
+		}
+	}
+}/* bnGetRandomBytes */
+
+void
+bnRandom(st_rsa_bn_t * const pRes, const uint32_t bits, const uint8_t flags)
+{
+	/* Validating */
+#if (FULL_ASSERTION_FLAG == FULL_ASSERTION_ACTIVE)
+	STATIC_ASSERT((bits <= RSA_MAX_KEY_BITS), DEFAULT_EXIT_CODE);
+#endif
+	/* Function data types */
+	const uint32_t len = (bits + RSA_BN_LIMB_BITS - 0x01u) / RSA_BN_LIMB_BITS;
+	const uint32_t topBits = bits - ((len - 0x01u) * RSA_BN_LIMB_BITS);
+
+	/* Function body */
+	bnZero(pRes);
+	if( (0x00u == bits) )
+	{ return; }
+	else;
+
+	bnGetRandomBytes((uint8_t *) pRes->limbs, len * sizeof(uint64_t));
+	if( (topBits < RSA_BN_LIMB_BITS) )
+	{ pRes->limbs[len - 0x01u] &= (0x01ull << topBits) - 0x01u; }
+	else;
+
+	if( (flags & RSA_BN_RAND_TOP_ONE) || (flags & RSA_BN_RAND_TOP_TWO) )
+	{ pRes->limbs[len - 0x01u] |= 0x01ull << (topBits - 0x01u); }
+	else;
+	if( (flags & RSA_BN_RAND_TOP_TWO) && (bits >= 0x02u) )
+	{
+		const uint32_t bit = bits - 0x02u;
+		pRes->limbs[bit / RSA_BN_LIMB_BITS] |= 0x01ull << (bit % RSA_BN_LIMB_BITS);
+	}
+	else;
+	if( (flags & RSA_BN_RAND_ODD) )
+	{ pRes->limbs[0] |= 0x01u; }
+	else;
+
+	pRes->used = limbsNormalize(pRes->limbs, len);
+}/* bnRandom */
+
+/**
+ * @brief Loads a big endian byte string.
+ */
+void
+bnFromBytes(st_rsa_bn_t * const pRes, const uint8_t * const pBuf, const uint32_t len)
+{
+	uint32_t register i = 0x00u;
+
+#if (FULL_ASSERTION_FLAG == FULL_ASSERTION_ACTIVE)
+	STATIC_ASSERT((len <= (RSA_BN_MAX_LIMBS * sizeof(uint64_t))), DEFAULT_EXIT_CODE);
+#endif
+
+	bnZero(pRes);
+	for(; i < len; ++i)
+	{ pRes->limbs[i / sizeof(uint64_t)] |= (uint64_t) pBuf[len - 0x01u - i] << ((i % sizeof(uint64_t)) * 0x08u); }
+	pRes->used = limbsNormalize(pRes->limbs, (len + sizeof(uint64_t) - 0x01u) / sizeof(uint64_t));
+}/* bnFromBytes */
+
+/**
+ * @brief Stores a fixed width big endian byte string, the value must fit.
+ */
+void
+bnToBytes(uint8_t * const pBuf, const uint32_t len, const st_rsa_bn_t * const pA)
+{
+	uint32_t register i = 0x00u;
+
+	for(; i < len; ++i)
+	{
+		pBuf[len - 0x01u - i] = ((i / sizeof(uint64_t)) < pA->used) ?
+			((uint8_t) (pA->limbs[i / sizeof(uint64_t)] >> ((i % sizeof(uint64_t)) * 0x08u))) : (0x00u);
+	}
+}/* bnToBytes */
+
+void
+bnToHex(char * const pBuf, const uint32_t len, const st_rsa_bn_t * const pA)
+{
+	/* Function data types */
+	static const char hexDigits[] = "0123456789abcdef";
+	uint32_t digits = (bnBitLength(pA) + 0x03u) / 0x04u;
+	uint32_t register i = 0x00u;
+
+	/* Function body */
+	if( (0x00u == len) )
+	{ return; }
+	else;
+	if( (0x00u == digits) )
+	{ digits = 0x01u; }
+	else;
+	if( (digits >= len) )
+	{ digits = len - 0x01u; }
+	else;
+
+	for(; i < digits; ++i)
+	{
+		const uint32_t nibble = digits - 0x01u - i;
+		pBuf[i] = hexDigits[(pA->limbs[nibble / 16u] >> ((nibble % 16u) * 0x04u)) & 0x0Fu];
+	}
+	pBuf[digits] = '\0';
+}/* bnToHex */
+
+/**
+ * @brief Parses a big endian hex string, stops at the first character that
+ * 			  is not a hex digit.
+ * @return 0 when the string holds no digit or doesn't fit.
+ */
+uint8_t
+bnFromHex(st_rsa_bn_t * const pRes, const char * const pHex)
+{
+	/* Function data types */
+	uint32_t digits = 0x00u;
+	uint32_t register i = 0x00u;
+
+	/* Function body */
+	bnZero(pRes);
+
+	while( ((pHex[digits] >= '0') && (pHex[digits] <= '9')) ||
+	       ((pHex[digits] >= 'a') && (pHex[digits] <= 'f')) ||
+	       ((pHex[digits] >= 'A') && (pHex[digits] <= 'F')) )
+	{ ++digits; }
+
+	if( (0x00u == digits) || (digits > (RSA_BN_MAX_LIMBS * 16u)) )
+	{ return 0x00u; }
+	else;
+
+	for(i = 0x00u; i < digits; ++i)
+	{
+		const char c = pHex[digits - 0x01u - i];
+		const uint64_t nibble = (c <= '9') ? (uint64_t) (c - '0') :
+		                        (c <= 'F') ? (uint64_t) (c - 'A' + 10) : (uint64_t) (c - 'a' + 10);
+		pRes->limbs[i / 16u] |= nibble << ((i % 16u) * 0x04u);
+	}
+	pRes->used = limbsNormalize(pRes->limbs, RSA_BN_MAX_LIMBS);
+
+	return 0x01u;
+}/* bnFromHex */
@@ -0,0 +1,814 @@
+/**
+ * @file rsa_exec.c
+ * @author Mohamed ashraf (wx@wx.com)
+ * @brief rsa work-stealing executor program file
+ * @version 0.1
+ * @date 2023-01-01
+ *
+ * @copyright Copyright (c) Wx 2023
+ *
+ * @attention
+ *      Submitted jobs wait in a locked queue, every worker owns a bounded
+ *      Chase-Lev deque it pushes to and takes from at the bottom while the
+ *      idle workers steal from the top.
+ *      A block mode job is cut into up to RSA_JOB_MAX_SPLITS pieces claimed
+ *      through an atomic counter. The first piece a worker claims makes it
+ *      push the job back on its own deque, so idle workers steal the job and
+ *      claim the remaining pieces. Every deque entry and every running worker
+ *      holds a reference, the worker dropping the last one completes the job.
+ *      Idle workers sleep on a condition variable, `sleepers` tells the pushes
+ *      whether a wake up is needed.
+ *
+ */
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <unistd.h>
+
+#include "rsa_cfg.h"
+#include "rsa_prv.h"
+#include "rsa_int.h"
+#include "rsa_trace.h"
+
+/*
+*--------------------------------------------------------------------------------------
+*- Macros
+*--------------------------------------------------------------------------------------
+**/
+
+#define RSA_EXEC_MAX_WORKERS 				(0x40u)
+/** @brief Entries per deque (power of two), a full deque only stops the splitting */
+#define RSA_EXEC_DEQUE_SIZE 				(0x40u)
+/** @brief Keeps the deque ends and the shared counters on their own cache lines */
+#define RSA_EXEC_ALIGN 							(0x40u)
+
+/*
+*--------------------------------------------------------------------------------------
+*- Data types
+*--------------------------------------------------------------------------------------
+**/
+
+/**
+ * @brief Deque of one worker, entries [top, bottom) are live.
+*/
+typedef struct rsa_exec_deque
+{
+	int64_t top __attribute__((aligned(RSA_EXEC_ALIGN)));
+	int64_t bottom __attribute__((aligned(RSA_EXEC_ALIGN)));
+	rsa_job_t *pJobs[RSA_EXEC_DEQUE_SIZE];
+}st_rsa_exec_deque_t;
+
+typedef struct rsa_exec_worker
+{
+	st_rsa_exec_deque_t deque;
+	struct rsa_exec *pExec;
+	pthread_t thread;
+	uint32_t id;
+	uint32_t seed; 									/* Victim selection */
+}st_rsa_exec_worker_t;
+
+typedef struct rsa_exec
+{
+	uint32_t pending __attribute__((aligned(RSA_EXEC_ALIGN))); 	/* Submitted jobs not completed yet */
+	uint32_t sleepers; 							/* Workers waiting on `work` */
+	uint32_t waiters; 							/* Threads in rsa_job_wait() */
+	uint32_t queued; 								/* Jobs in the submission queue */
+	uint8_t stop;
+	pthread_mutex_t lock; 					/* Guards the submission queue and the sleeps */
+	pthread_cond_t work; 						/* Signaled when a job is queued or pushed */
+	pthread_cond_t done; 						/* Broadcast when a waited job completes */
+	rsa_job_t *pHead;
+	rsa_job_t *pTail;
+	rsa_allocator_t allocator;
+	st_rsa_exec_worker_t *pWorkers;
+	uint32_t numOfWorkers; 					/* Workers started */
+}st_rsa_exec_t;
+
+/*
+*--------------------------------------------------------------------------------------
+*- Private Functions Implementation
+*--------------------------------------------------------------------------------------
+**/
+
+/**
+ * @brief Owner side push at the bottom.
+ * @return 0 when the deque is full.
+ */
+static uint8_t
+dequePush(st_rsa_exec_deque_t * const pDeque, rsa_job_t * const pJob)
+{
+	/* Function data types */
+	const int64_t bottom = __atomic_load_n(&pDeque->bottom, __ATOMIC_RELAXED);
+	const int64_t top = __atomic_load_n(&pDeque->top, __ATOMIC_ACQUIRE);
+
+	/* Function body */
+	if( ((bottom - top) >= (int64_t) RSA_EXEC_DEQUE_SIZE) )
+	{ return 0x00u; }
+	else;
+
+	__atomic_store_n(&pDeque->pJobs[bottom & (RSA_EXEC_DEQUE_SIZE - 0x01u)], pJob, __ATOMIC_RELAXED);
+	/* Sequentially consistent against the `sleepers` check of a falling asleep worker */
+	__atomic_store_n(&pDeque->bottom, bottom + 0x01, __ATOMIC_SEQ_CST);
+
+	return 0x01u;
+}/* dequePush */
+
+/**
+ * @brief Owner side take at the bottom, races the thieves for the last entry.
+ * @return NULL when the deque is empty.
+ */
+static rsa_job_t *
+dequeTake(st_rsa_exec_deque_t * const pDeque)
+{
+	/* Function data types */
+	const int64_t bottom = __atomic_load_n(&pDeque->bottom, __ATOMIC_RELAXED) - 0x01;
+	int64_t top = 0x00;
+	rsa_job_t *pJob = NULL;
+
+	/* Function body */
+	__atomic_store_n(&pDeque->bottom, bottom, __ATOMIC_RELAXED);
+	__atomic_thread_fence(__ATOMIC_SEQ_CST);
+	top = __atomic_load_n(&pDeque->top, __ATOMIC_RELAXED);
+
+	if( (top > bottom) )
+	{
+		__atomic_store_n(&pDeque->bottom, bottom + 0x01, __ATOMIC_RELEASE);
+		return NULL;
+	}
+	else;
+
+	pJob = __atomic_load_n(&pDeque->pJobs[bottom & (RSA_EXEC_DEQUE_SIZE - 0x01u)], __ATOMIC_RELAXED);
+	if( (top == bottom) )
+	{
+		if( (0x00u == __atomic_compare_exchange_n(&pDeque->top, &top, top + 0x01, 0x00u,
+		                                          __ATOMIC_SEQ_CST, __ATOMIC_RELAXED)) )
+		{ pJob = NULL; }
+		else;
+
+		__atomic_store_n(&pDeque->bottom, bottom + 0x01, __ATOMIC_RELEASE);
+	}
+	else;
+
+	return pJob;
+}/* dequeTake */
+
+/**
+ * @brief Thief side steal at the top.
+ * @return NULL when the deque is empty or another thread won the entry.
+ */
+static rsa_job_t *
+dequeSteal(st_rsa_exec_deque_t * const pDeque)
+{
+	/* Function data types */
+	int64_t top = __atomic_load_n(&pDeque->top, __ATOMIC_ACQUIRE);
+	int64_t bottom = 0x00;
+	rsa_job_t *pJob = NULL;
+
+	/* Function body */
+	__atomic_thread_fence(__ATOMIC_SEQ_CST);
+	bottom = __atomic_load_n(&pDeque->bottom, __ATOMIC_ACQUIRE);
+
+	if( (top >= bottom) )
+	{ return NULL; }
+	else;
+
+	pJob = __atomic_load_n(&pDeque->pJobs[top & (RSA_EXEC_DEQUE_SIZE - 0x01u)], __ATOMIC_RELAXED);
+	if( (0x00u == __atomic_compare_exchange_n(&pDeque->top, &top, top + 0x01, 0x00u,
+	                                          __ATOMIC_SEQ_CST, __ATOMIC_RELAXED)) )
+	{ return NULL; }
+	else;
+
+	return pJob;
+}/* dequeSteal */
+
+_STATIC_INLINE uint8_t
+dequeIsEmpty(st_rsa_exec_deque_t * const pDeque)
+{
+	return (__atomic_load_n(&pDeque->top, __ATOMIC_SEQ_CST) >= __atomic_load_n(&pDeque->bottom, __ATOMIC_SEQ_CST));
+}/* dequeIsEmpty */
+
+/**
+ * @brief Pops the oldest submitted job.
+ * @return NULL when the submission queue is empty.
+ */
+static rsa_job_t *
+execDequeue(st_rsa_exec_t * const pExec)
+{
+	/* Function data types */
+	rsa_job_t *pJob = NULL;
+
+	/* Function body */
+	if( (0x00u == __atomic_load_n(&pExec->queued, __ATOMIC_RELAXED)) )
+	{ return NULL; }
+	else;
+
+	pthread_mutex_lock(&pExec->lock);
+	pJob = pExec->pHead;
+	if( (NULL != pJob) )
+	{
+		pExec->pHead = pJob->pNext;
+		if( (NULL == pExec->pHead) )
+		{ pExec->pTail = NULL; }
+		else;
+
+		__atomic_fetch_sub(&pExec->queued, 0x01u, __ATOMIC_RELAXED);
+	}
+	else;
+	pthread_mutex_unlock(&pExec->lock);
+
+	return pJob;
+}/* execDequeue */
+
+/**
+ * @brief Tries every other deque once, starting from a random victim.
+ */
+static rsa_job_t *
+execSteal(st_rsa_exec_worker_t * const pWorker)
+{
+	/* Function data types */
+	st_rsa_exec_t * const pExec = pWorker->pExec;
+	rsa_job_t *pJob = NULL;
+	const uint32_t numOfWorkers = __atomic_load_n(&pExec->numOfWorkers, __ATOMIC_ACQUIRE);
+	uint32_t victim = 0x00u;
+	uint32_t register i = 0x00u;
+
+	/* Function body */
+	pWorker->seed ^= pWorker->seed << 0x0Du;
+	pWorker->seed ^= pWorker->seed >> 0x11u;
+	pWorker->seed ^= pWorker->seed << 0x05u;
+
+	for(i = 0x00u; (NULL == pJob) && (i < numOfWorkers); ++i)
+	{
+		victim = (pWorker->seed + i) % numOfWorkers;
+		if( (victim != pWorker->id) )
+		{ pJob = dequeSteal(&pExec->pWorkers[victim].deque); }
+		else;
+	}
+
+	return pJob;
+}/* execSteal */
+
+/**
+ * @brief Wakes a sleeping worker after a push or a submission.
+ */
+_STATIC_INLINE void
+execWake(st_rsa_exec_t * const pExec)
+{
+	/* Function body */
+	if( (0x00u != __atomic_load_n(&pExec->sleepers, __ATOMIC_SEQ_CST)) )
+	{
+		pthread_mutex_lock(&pExec->lock);
+		pthread_cond_signal(&pExec->work);
+		pthread_mutex_unlock(&pExec->lock);
+	}
+	else;
+}/* execWake */
+
+/**
+ * @brief Sleeps until some work may be found.
+ * @return 1 when the executor is stopping and every job completed.
+ */
+static uint8_t
+execSleep(st_rsa_exec_t * const pExec)
+{
+	/* Function data types */
+	uint8_t exit = 0x00u;
+	uint8_t idle = 0x01u;
+	uint32_t register i = 0x00u;
+
+	/* Function body */
+	pthread_mutex_lock(&pExec->lock);
+	__atomic_fetch_add(&pExec->sleepers, 0x01u, __ATOMIC_SEQ_CST);
+
+	/* Checked after raising `sleepers`, a push made meanwhile either shows up here or wakes us */
+	for(i = 0x00u; (idle) && (i < __atomic_load_n(&pExec->numOfWorkers, __ATOMIC_ACQUIRE)); ++i)
+	{ idle = dequeIsEmpty(&pExec->pWorkers[i].deque); }
+
+	if( (NULL != pExec->pHead) || (0x00u == idle) )
+	{ ; }
+	else if( (pExec->stop) && (0x00u == __atomic_load_n(&pExec->pending, __ATOMIC_SEQ_CST)) )
+	{ exit = 0x01u; }
+	else
+	{ pthread_cond_wait(&pExec->work, &pExec->lock); }
+
+	__atomic_fetch_sub(&pExec->sleepers, 0x01u, __ATOMIC_SEQ_CST);
+	pthread_mutex_unlock(&pExec->lock);
+
+	return exit;
+}/* execSleep */
+
+/**
+ * @brief Runs one piece of a block mode job, pieces map to whole blocks on
+ * 			  both sides. Decrypted pieces are written at their full block
+ * 				offset and packed when the job completes.
+ */
+static void
+execRunSplit(rsa_job_t * const pJob, const uint32_t split)
+{
+	/* Function data types */
+	const uint64_t blockLen = pJob->pCtx->pub.modulusBytes;
+	const uint64_t payloadLen = blockLen - RSA_BLOCK_HEADER_BYTES - 0x01u;
+	const uint64_t inPieceLen = pJob->splitBlocks * ((rsaJobEncrypt == pJob->type) ? (payloadLen) : (blockLen));
+	const uint64_t outPieceLen = pJob->splitBlocks * ((rsaJobEncrypt == pJob->type) ? (blockLen) : (payloadLen));
+	const uint64_t inOffset = split * inPieceLen;
+	uint64_t inLen = pJob->inLen - inOffset;
+	en_rsa_status_t status = rsaStatusOk;
+	en_rsa_status_t expected = rsaStatusOk;
+
+	/* Function body */
+	if( (inLen > inPieceLen) )
+	{ inLen = inPieceLen; }
+	else;
+
+	if( (rsaJobEncrypt == pJob->type) )
+	{ status = rsa_ctx_encrypt_blocks(pJob->pCtx, pJob->pIn + inOffset, inLen, pJob->pOut + (split * outPieceLen)); }
+	else
+	{
+		status = rsa_ctx_decrypt_blocks(pJob->pCtx, pJob->pIn + inOffset, inLen,
+		                                pJob->pOut + (split * outPieceLen), &pJob->splitLens[split]);
+	}
+
+	if( (rsaStatusOk != status) )
+	{
+		__atomic_compare_exchange_n(&pJob->status, &expected, status, 0x00u,
+		                            __ATOMIC_RELAXED, __ATOMIC_RELAXED);
+	}
+	else;
+}/* execRunSplit */
+
+/**
+ * @brief Publishes the result of a job. The completion callback runs first,
+ * 			  nothing reads the job once it is marked done since the caller may
+ * 				free or reuse it right away.
+ */
+static void
+execComplete(st_rsa_exec_t * const pExec, rsa_job_t * const pJob)
+{
+	/* Function data types */
+	const rsa_job_done_t pfDone = pJob->pfDone;
+	void * const pUser = pJob->pUser;
+	const en_rsa_status_t status = __atomic_load_n(&pJob->status, __ATOMIC_RELAXED);
+	const uint64_t payloadLen = pJob->pCtx->pub.modulusBytes - RSA_BLOCK_HEADER_BYTES - 0x01u;
+	uint64_t msgLen = 0x00u;
+	uint32_t register i = 0x00u;
+
+	/* Function body */
+	if( (rsaJobDecrypt == pJob->type) )
+	{
+		/* Pieces only move down, so packing in order never overwrites a later piece */
+		for(i = 0x00u; (rsaStatusOk == status) && (i < pJob->numOfSplits); ++i)
+		{
+			memmove(pJob->pOut + msgLen, pJob->pOut + (i * pJob->splitBlocks * payloadLen), pJob->splitLens[i]);
+			msgLen += pJob->splitLens[i];
+		}
+
+		*pJob->pOutLen = msgLen;
+	}
+	else;
+
+	RSA_TRACE(traceEventJobDone, pJob->type, status);
+
+	if( (NULL != pfDone) )
+	{ pfDone(pJob, status, pUser); }
+	else;
+
+	__atomic_store_n(&pJob->done, 0x01u, __ATOMIC_SEQ_CST);
+	if( (0x00u != __atomic_load_n(&pExec->waiters, __ATOMIC_SEQ_CST)) )
+	{
+		pthread_mutex_lock(&pExec->lock);
+		pthread_cond_broadcast(&pExec->done);
+		pthread_mutex_unlock(&pExec->lock);
+	}
+	else;
+
+	/* The last job of a stopping executor lets the sleeping workers leave */
+	if( (0x01u == __atomic_fetch_sub(&pExec->pending, 0x01u, __ATOMIC_SEQ_CST)) &&
+	    (__atomic_load_n(&pExec->stop, __ATOMIC_SEQ_CST)) )
+	{
+		pthread_mutex_lock(&pExec->lock);
+		pthread_cond_broadcast(&pExec->work);
+		pthread_mutex_unlock(&pExec->lock);
+	}
+	else;
+}/* execComplete */
+
+/**
+ * @brief Works on a job taken from a deque or the submission queue, the
+ * 			  worker holds one reference on it.
+ */
+static void
+execRun(st_rsa_exec_worker_t * const pWorker, rsa_job_t * const pJob)
+{
+	/* Function data types */
+	uint8_t shared = 0x00u;
+	uint32_t split = 0x00u;
+	uint32_t searchThreads = 0x00u;
+	en_rsa_status_t status = rsaStatusOk;
+
+	/* Function body */
+	if( (rsaJobGenerate == pJob->type) )
+	{
+		/* The workers already run side by side, the primes are searched on
+		 * this one alone. The job owns the context until it is done. */
+		searchThreads = pJob->pCtx->searchThreads;
+		pJob->pCtx->searchThreads = 0x01u;
+		status = rsa_ctx_generate(pJob->pCtx, pJob->keyBits);
+		pJob->pCtx->searchThreads = searchThreads;
+		__atomic_store_n(&pJob->status, status, __ATOMIC_RELAXED);
+		execComplete(pWorker->pExec, pJob);
+		return;
+	}
+	else;
+
+	while( ((split = __atomic_fetch_add(&pJob->nextSplit, 0x01u, __ATOMIC_RELAXED)) < pJob->numOfSplits) )
+	{
+		/* Offers the pieces left to the idle workers */
+		if( (0x00u == shared) && ((split + 0x01u) < pJob->numOfSplits) )
+		{
+			shared = 0x01u;
+			__atomic_fetch_add(&pJob->refs, 0x01u, __ATOMIC_RELAXED);
+			if( (dequePush(&pWorker->deque, pJob)) )
+			{ execWake(pWorker->pExec); }
+			else
+			{ __atomic_fetch_sub(&pJob->refs, 0x01u, __ATOMIC_RELAXED); }
+		}
+		else;
+
+		execRunSplit(pJob, split);
+	}
+
+	if( (0x01u == __atomic_fetch_sub(&pJob->refs, 0x01u, __ATOMIC_ACQ_REL)) )
+	{ execComplete(pWorker->pExec, pJob); }
+	else;
+}/* execRun */
+
+static void *
+execWorker(void *pArg)
+{
+	/* Function data types */
+	st_rsa_exec_worker_t * const pWorker = (st_rsa_exec_worker_t *) pArg;
+	st_rsa_exec_t * const pExec = pWorker->pExec;
+	rsa_job_t *pJob = NULL;
+
+	/* Function body */
+	while(1)
+	{
+		pJob = dequeTake(&pWorker->deque);
+		if( (NULL == pJob) )
+		{ pJob = execDequeue(pExec); }
+		else;
+
+		if( (NULL == pJob) )
+		{ pJob = execSteal(pWorker); }
+		else;
+
+		if( (NULL != pJob) )
+		{ execRun(pWorker, pJob); }
+		else if( (execSleep(pExec)) )
+		{ break; }
+		else;
+	}
+
+	return NULL;
+}/* execWorker */
+
+/**
+ * @brief Queues a filled job control block.
+ */
+static void
+execSubmit(st_rsa_exec_t * const pExec, rsa_job_t * const pJob)
+{
+	/* Function body */
+	pJob->pExec = (rsa_exec_t *) pExec;
+	pJob->pNext = NULL;
+	pJob->status = rsaStatusOk;
+	pJob->done = 0x00u;
+	pJob->refs = 0x01u;
+	pJob->nextSplit = 0x00u;
+
+	__atomic_fetch_add(&pExec->pending, 0x01u, __ATOMIC_SEQ_CST);
+
+	pthread_mutex_lock(&pExec->lock);
+	if( (NULL != pExec->pTail) )
+	{ pExec->pTail->pNext = pJob; }
+	else
+	{ pExec->pHead = pJob; }
+	pExec->pTail = pJob;
+	__atomic_fetch_add(&pExec->queued, 0x01u, __ATOMIC_RELAXED);
+
+	if( (0x00u != pExec->sleepers) )
+	{ pthread_cond_signal(&pExec->work); }
+	else;
+	pthread_mutex_unlock(&pExec->lock);
+}/* execSubmit */
+
+/**
+ * @brief Cuts `numOfBlocks` blocks into pieces of at least RSA_EXEC_SPLIT_BLOCKS
+ * 			  blocks, without any empty piece.
+ */
+static void
+execSplit(rsa_job_t * const pJob, const uint64_t numOfBlocks)
+{
+	/* Function data types */
+	uint64_t numOfSplits = (numOfBlocks + RSA_EXEC_SPLIT_BLOCKS - 0x01u) / RSA_EXEC_SPLIT_BLOCKS;
+
+	/* Function body */
+	if( (numOfSplits > RSA_JOB_MAX_SPLITS) )
+	{ numOfSplits = RSA_JOB_MAX_SPLITS; }
+	else;
+
+	if( (0x00u == numOfSplits) )
+	{
+		pJob->splitBlocks = 0x00u;
+		pJob->numOfSplits = 0x00u;
+		return;
+	}
+	else;
+
+	pJob->splitBlocks = (numOfBlocks + numOfSplits - 0x01u) / numOfSplits;
+	pJob->numOfSplits = (uint32_t) ((numOfBlocks + pJob->splitBlocks - 0x01u) / pJob->splitBlocks);
+}/* execSplit */
+
+/**
+ * @brief Argument checks shared by the block mode submissions.
+ */
+static en_rsa_status_t
+execCheckBlockJob(const rsa_exec_t * const pExec, const rsa_job_t * const pJob, const rsa_ctx_t * const pCtx,
+                  const uint8_t * const pIn, const uint64_t inLen, const uint8_t * const pOut)
+{
+	/* Validating */
+	if( (NULL == pExec) || (NULL == pJob) || (NULL == pCtx) || ((NULL == pIn) && (inLen > 0x00u)) || (NULL == pOut) )
+	{ return rsaStatusNullArgument; }
+	else if( (0x00u == pCtx->keyReady) )
+	{ return rsaStatusNoKey; }
+	else if( (pCtx->pub.modulusBytes <= (RSA_BLOCK_HEADER_BYTES + 0x01u)) )
+	{ return rsaStatusInvalidKeySize; }
+	else;
+
+	return rsaStatusOk;
+}/* execCheckBlockJob */
+
+/*
+*--------------------------------------------------------------------------------------
+*- Public Functions Implementation
+*--------------------------------------------------------------------------------------
+**/
+
+/**
+ * @brief Starts an executor of `numOfWorkers` threads (0 uses every online
+ * 			  core). The allocator (NULL for the default one) only serves the
+ * 				executor itself, the jobs are owned by the caller.
+ * @return NULL when the allocation fails or no worker could be started.
+ */
+rsa_exec_t *
+rsa_exec_create(const uint32_t numOfWorkers, const rsa_allocator_t * const pAllocator)
+{
+	/* Function data types */
+	rsa_allocator_t allocator;
+	st_rsa_exec_t *pExec = NULL;
+	uint32_t workersCount = numOfWorkers;
+	uint32_t register i = 0x00u;
+
+	/* Validating */
+	allocator = (NULL != pAllocator) ? (*pAllocator) : (rsa_allocator_default());
+	if( (NULL == allocator.pfAlloc) || (NULL == allocator.pfFree) )
+	{ return NULL; }
+	else;
+
+	/* Function body */
+	if( (0x00u == workersCount) )
+	{
+		const long onlineCores = sysconf(_SC_NPROCESSORS_ONLN);
+		workersCount = (onlineCores > 0) ? ((uint32_t) onlineCores) : (0x01u);
+	}
+	else;
+
+	if( (workersCount > RSA_EXEC_MAX_WORKERS) )
+	{ workersCount = RSA_EXEC_MAX_WORKERS; }
+	else;
+
+	pExec = (st_rsa_exec_t *) allocator.pfAlloc(allocator.pUser, sizeof(st_rsa_exec_t), RSA_EXEC_ALIGN);
+	if( (NULL == pExec) )
+	{ return NULL; }
+	else;
+
+	memset(pExec, 0x00u, sizeof(st_rsa_exec_t));
+	pExec->pWorkers = (st_rsa_exec_worker_t *) allocator.pfAlloc(allocator.pUser,
+	                                                              workersCount * sizeof(st_rsa_exec_worker_t),
+	                                                              RSA_EXEC_ALIGN);
+	if( (NULL == pExec->pWorkers) )
+	{
+		allocator.pfFree(allocator.pUser, pExec);
+		return NULL;
+	}
+	else;
+
+	memset(pExec->pWorkers, 0x00u, workersCount * sizeof(st_rsa_exec_worker_t));
+	pExec->allocator = allocator;
+	pthread_mutex_init(&pExec->lock, NULL);
+	pthread_cond_init(&pExec->work, NULL);
+	pthread_cond_init(&pExec->done, NULL);
+
+	/* The running workers already scan the deques, numOfWorkers only counts started ones */
+	for(i = 0x00u; i < workersCount; ++i)
+	{
+		st_rsa_exec_worker_t * const pWorker = &pExec->pWorkers[pExec->numOfWorkers];
+
+		pWorker->pExec = pExec;
+		pWorker->id = pExec->numOfWorkers;
+		pWorker->seed = (pWorker->id * 0x9E3779B9u) | 0x01u;
+		if( (0x00 == pthread_create(&pWorker->thread, NULL, execWorker, pWorker)) )
+		{ __atomic_store_n(&pExec->numOfWorkers, pExec->numOfWorkers + 0x01u, __ATOMIC_RELEASE); }
+		else;
+	}
+
+	if( (0x00u == pExec->numOfWorkers) )
+	{
+		rsa_exec_destroy((rsa_exec_t *) pExec);
+		return NULL;
+	}
+	else;
+
+	return (rsa_exec_t *) pExec;
+}/* rsa_exec_create */
+
+/**
+ * @brief Completes every submitted job, then stops the workers and releases
+ * 			  the executor. No job may be submitted once it is called.
+ */
+void
+rsa_exec_destroy(rsa_exec_t * const pExec)
+{
+	/* Function data types */
+	st_rsa_exec_t * const pState = (st_rsa_exec_t *) pExec;
+	rsa_allocator_t allocator;
+	uint32_t register i = 0x00u;
+
+	/* Function body */
+	if( (NULL == pState) )
+	{ return; }
+	else;
+
+	pthread_mutex_lock(&pState->lock);
+	__atomic_store_n(&pState->stop, 0x01u, __ATOMIC_SEQ_CST);
+	pthread_cond_broadcast(&pState->work);
+	pthread_mutex_unlock(&pState->lock);
+
+	for(i = 0x00u; i < pState->numOfWorkers; ++i)
+	{ pthread_join(pState->pWorkers[i].thread, NULL); }
+
+	pthread_cond_destroy(&pState->done);
+	pthread_cond_destroy(&pState->work);
+	pthread_mutex_destroy(&pState->lock);
+
+	allocator = pState->allocator;
+	allocator.pfFree(allocator.pUser, pState->pWorkers);
+	allocator.pfFree(allocator.pUser, pState);
+}/* rsa_exec_destroy */
+
+/**
+ * @brief Queues the generation of a `keyBits` bits key into the context, the
+ * 			  context must not be used until the job is done.
+ * @return The argument check status, the job only runs on rsaStatusOk.
+ */
+en_rsa_status_t
+rsa_exec_submit_generate(rsa_exec_t * const pExec, rsa_job_t * const pJob, rsa_ctx_t * const pCtx,
+                         const uint32_t keyBits, const rsa_job_done_t pfDone, void * const pUser)
+{
+	/* Validating */
+	if( (NULL == pExec) || (NULL == pJob) || (NULL == pCtx) )
+	{ return rsaStatusNullArgument; }
+	else if( (keyBits < 0x10u) || (keyBits > RSA_MAX_KEY_BITS) )
+	{ return rsaStatusInvalidKeySize; }
+	else;
+
+	/* Function body */
+	memset(pJob, 0x00u, sizeof(rsa_job_t));
+	pJob->type = rsaJobGenerate;
+	pJob->pCtx = pCtx;
+	pJob->keyBits = keyBits;
+	pJob->pfDone = pfDone;
+	pJob->pUser = pUser;
+
+	execSubmit((st_rsa_exec_t *) pExec, pJob);
+
+	return rsaStatusOk;
+}/* rsa_exec_submit_generate */
+
+/**
+ * @brief Queues a block mode encryption, same contract as
+ * 			  rsa_ctx_encrypt_blocks(). The buffers must stay valid until the job
+ * 				is done.
+ */
+en_rsa_status_t
+rsa_exec_submit_encrypt(rsa_exec_t * const pExec, rsa_job_t * const pJob, const rsa_ctx_t * const pCtx,
+                        const uint8_t * const pMsg, const uint64_t msgLen, uint8_t * const pCipher,
+                        const rsa_job_done_t pfDone, void * const pUser)
+{
+	/* Function data types */
+	const en_rsa_status_t status = execCheckBlockJob(pExec, pJob, pCtx, pMsg, msgLen, pCipher);
+
+	/* Validating */
+	if( (rsaStatusOk != status) )
+	{ return status; }
+	else;
+
+	/* Function body */
+	memset(pJob, 0x00u, sizeof(rsa_job_t));
+	pJob->type = rsaJobEncrypt;
+	pJob->pCtx = (rsa_ctx_t *) pCtx;
+	pJob->pIn = pMsg;
+	pJob->inLen = msgLen;
+	pJob->pOut = pCipher;
+	pJob->pfDone = pfDone;
+	pJob->pUser = pUser;
+	execSplit(pJob, rsa_ctx_block_cipher_size(pCtx, msgLen) / pCtx->pub.modulusBytes);
+
+	execSubmit((st_rsa_exec_t *) pExec, pJob);
+
+	return rsaStatusOk;
+}/* rsa_exec_submit_encrypt */
+
+/**
+ * @brief Queues a block mode decryption, same contract as
+ * 			  rsa_ctx_decrypt_blocks(), the message length is stored through
+ * 				pMsgLen when the job completes.
+ */
+en_rsa_status_t
+rsa_exec_submit_decrypt(rsa_exec_t * const pExec, rsa_job_t * const pJob, const rsa_ctx_t * const pCtx,
+                        const uint8_t * const pCipher, const uint64_t cipherLen, uint8_t * const pMsg,
+                        uint64_t * const pMsgLen, const rsa_job_done_t pfDone, void * const pUser)
+{
+	/* Function data types */
+	const en_rsa_status_t status = execCheckBlockJob(pExec, pJob, pCtx, pCipher, cipherLen, pMsg);
+
+	/* Validating */
+	if( (rsaStatusOk != status) )
+	{ return status; }
+	else if( (NULL == pMsgLen) )
+	{ return rsaStatusNullArgument; }
+	else if( (0x00u != (cipherLen % pCtx->pub.modulusBytes)) )
+	{ return rsaStatusInvalidCipher; }
+	else;
+
+	/* Function body */
+	memset(pJob, 0x00u, sizeof(rsa_job_t));
+	pJob->type = rsaJobDecrypt;
+	pJob->pCtx = (rsa_ctx_t *) pCtx;
+	pJob->pIn = pCipher;
+	pJob->inLen = cipherLen;
+	pJob->pOut = pMsg;
+	pJob->pOutLen = pMsgLen;
+	pJob->pfDone = pfDone;
+	pJob->pUser = pUser;
+	execSplit(pJob, cipherLen / pCtx->pub.modulusBytes);
+
+	execSubmit((st_rsa_exec_t *) pExec, pJob);
+
+	return rsaStatusOk;
+}/* rsa_exec_submit_decrypt */
+
+/**
+ * @brief Polls a submitted job, once done its outputs are ready and the
+ * 			  control block can be reused.
+ */
+uint8_t
+rsa_job_done(const rsa_job_t * const pJob)
+{
+	return (NULL != pJob) ? ((uint8_t) __atomic_load_n(&pJob->done, __ATOMIC_ACQUIRE)) : (0x00u);
+}/* rsa_job_done */
+
+/**
+ * @brief Blocks until a submitted job is done, must not be called from a
+ * 			  completion callback.
+ * @return The job status.
+ */
+en_rsa_status_t
+rsa_job_wait(rsa_job_t * const pJob)
+{
+	/* Function data types */
+	st_rsa_exec_t *pExec = NULL;
+
+	/* Validating */
+	if( (NULL == pJob) )
+	{ return rsaStatusNullArgument; }
+	else;
+
+	/* Function body */
+	if( (0x00u == __atomic_load_n(&pJob->done, __ATOMIC_ACQUIRE)) )
+	{
+		pExec = (st_rsa_exec_t *) pJob->pExec;
+
+		pthread_mutex_lock(&pExec->lock);
+		__atomic_fetch_add(&pExec->waiters, 0x01u, __ATOMIC_SEQ_CST);
+		while( (0x00u == __atomic_load_n(&pJob->done, __ATOMIC_SEQ_CST)) )
+		{ pthread_cond_wait(&pExec->done, &pExec->lock); }
+		__atomic_fetch_sub(&pExec->waiters, 0x01u, __ATOMIC_SEQ_CST);
+		pthread_mutex_unlock(&pExec->lock);
+	}
+	else;
+
+	return __atomic_load_n(&pJob->status, __ATOMIC_RELAXED);
+}/* rsa_job_wait */
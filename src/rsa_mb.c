@@ -0,0 +1,679 @@
+/**
+ * @file rsa_mb.c
+ * @author Mohamed ashraf (wx@wx.com)
+ * @brief rsa multi-buffer montgomery program file
+ * @version 0.1
+ * @date 2023-01-01
+ *
+ * @copyright Copyright (c) Wx 2023
+ *
+ * @attention
+ *      The AVX2 kernels are compiled through the target attribute, the rest
+ *      of the library keeps the default instruction set and mbIsAvailable()
+ *      tells at runtime whether the kernels may be called.
+ *      The multiplication is the "almost montgomery" variant, results stay
+ *      below 2n and a single correction is done when leaving the domain.
+ *
+ */
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "rsa_cfg.h"
+#include "rsa_prv.h"
+#include "rsa_bn.h"
+#include "rsa_mb.h"
+#include "rsa_int.h"
+#include "rsa_stats.h"
+
+#if defined(__x86_64__)
+	#include <immintrin.h>
+	#define RSA_MB_AVX2_BUILD
+#endif
+
+/*
+*--------------------------------------------------------------------------------------
+*- Macros
+*--------------------------------------------------------------------------------------
+**/
+
+/**
+ * @brief Every outer iteration adds two 58-bit products to each accumulator,
+ * 			  the digits are carried before 31 iterations could overflow 64 bits.
+ */
+#define MB_NORMALIZE_INTERVAL 		(0x10u)
+
+#define MB_TARGET_AVX2 						__attribute__((target("avx2")))
+#define MB_TARGET_AVX512 					__attribute__((target("avx512f")))
+
+/*
+*--------------------------------------------------------------------------------------
+*- Private Functions Implementation
+*--------------------------------------------------------------------------------------
+**/
+
+/**
+ * @brief Splits a number into `digits` radix 2^29 digits, written with a
+ * 			  stride of `lanes` so lane `lane` of every digit vector is set.
+ */
+static void
+mbFromBn(uint64_t * const pDigits, const uint32_t lane, const uint32_t lanes,
+         const uint32_t digits, const st_rsa_bn_t * const pA)
+{
+	/* Function data types */
+	uint32_t register i = 0x00u;
+	uint32_t bit = 0x00u;
+
+	/* Function body */
+	for(i = 0x00u; i < digits; ++i, bit += RSA_MB_DIGIT_BITS)
+	{
+		const uint32_t limb = bit / RSA_BN_LIMB_BITS;
+		const uint32_t shift = bit % RSA_BN_LIMB_BITS;
+		uint64_t value = 0x00u;
+
+		if( (limb < RSA_BN_MAX_LIMBS) )
+		{
+			value = pA->limbs[limb] >> shift;
+			if( (shift > (RSA_BN_LIMB_BITS - RSA_MB_DIGIT_BITS)) && ((limb + 0x01u) < RSA_BN_MAX_LIMBS) )
+			{ value |= pA->limbs[limb + 0x01u] << (RSA_BN_LIMB_BITS - shift); }
+			else;
+		}
+		else;
+
+		pDigits[(i * lanes) + lane] = value & RSA_MB_DIGIT_MASK;
+	}
+}/* mbFromBn */
+
+/**
+ * @brief Inverse of mbFromBn(), the digits must be normalized.
+ */
+static void
+mbToBn(st_rsa_bn_t * const pRes, const uint64_t * const pDigits, const uint32_t lane,
+       const uint32_t lanes, const uint32_t digits)
+{
+	/* Function data types */
+	uint32_t register i = 0x00u;
+	uint32_t bit = 0x00u;
+
+	/* Function body */
+	bnZero(pRes);
+
+	for(i = 0x00u; i < digits; ++i, bit += RSA_MB_DIGIT_BITS)
+	{
+		const uint64_t value = pDigits[(i * lanes) + lane];
+		const uint32_t limb = bit / RSA_BN_LIMB_BITS;
+		const uint32_t shift = bit % RSA_BN_LIMB_BITS;
+
+		if( (limb < RSA_BN_MAX_LIMBS) )
+		{
+			pRes->limbs[limb] |= value << shift;
+			if( (shift > (RSA_BN_LIMB_BITS - RSA_MB_DIGIT_BITS)) && ((limb + 0x01u) < RSA_BN_MAX_LIMBS) )
+			{ pRes->limbs[limb + 0x01u] |= value >> (RSA_BN_LIMB_BITS - shift); }
+			else;
+		}
+		else;
+	}
+
+	for(pRes->used = RSA_BN_MAX_LIMBS; (pRes->used > 0x00u) && (0x00u == pRes->limbs[pRes->used - 0x01u]); --pRes->used);
+}/* mbToBn */
+
+#if defined(RSA_MB_AVX2_BUILD)
+
+/**
+ * @brief Carries every digit into the next one, lane by lane.
+ */
+MB_TARGET_AVX2 static void
+mbNormalizeAvx2(__m256i * const pT, const uint32_t digits)
+{
+	/* Function data types */
+	const __m256i mask = _mm256_set1_epi64x((long long) RSA_MB_DIGIT_MASK);
+	__m256i carry = _mm256_setzero_si256();
+	uint32_t register j = 0x00u;
+
+	/* Function body */
+	for(j = 0x00u; j < digits; ++j)
+	{
+		const __m256i t = _mm256_add_epi64(pT[j], carry);
+		carry = _mm256_srli_epi64(t, RSA_MB_DIGIT_BITS);
+		pT[j] = _mm256_and_si256(t, mask);
+	}
+}/* mbNormalizeAvx2 */
+
+/**
+ * @brief Four lanes almost montgomery multiplication, res = a * b * R^-1 mod n
+ * 			  with a, b < 2n and res < 2n. The accumulators are shifted down one
+ * 				digit per iteration, the two products and the shift share one pass.
+ * 				Every lane may have its own modulus.
+ */
+MB_TARGET_AVX2 static void
+mbMontMulAvx2(const __m256i * const pN, const __m256i n0inv, const uint32_t digits,
+              __m256i * const pRes, const __m256i * const pA, const __m256i * const pB)
+{
+	/* Function data types */
+	__m256i t[RSA_MB_MAX_DIGITS];
+	const __m256i mask = _mm256_set1_epi64x((long long) RSA_MB_DIGIT_MASK);
+	uint32_t register i = 0x00u;
+	uint32_t register j = 0x00u;
+
+	/* Function body */
+	for(j = 0x00u; j < digits; ++j)
+	{ t[j] = _mm256_setzero_si256(); }
+
+	for(i = 0x00u; i < digits; ++i)
+	{
+		const __m256i a = pA[i];
+		__m256i t0 = _mm256_add_epi64(t[0], _mm256_mul_epu32(a, pB[0]));
+		const __m256i m = _mm256_and_si256(_mm256_mul_epu32(_mm256_and_si256(t0, mask), n0inv), mask);
+
+		t0 = _mm256_add_epi64(t0, _mm256_mul_epu32(m, pN[0]));
+		t0 = _mm256_srli_epi64(t0, RSA_MB_DIGIT_BITS);
+
+		for(j = 0x01u; j < digits; ++j)
+		{
+			t[j - 0x01u] = _mm256_add_epi64(_mm256_add_epi64(t[j], _mm256_mul_epu32(a, pB[j])),
+			                                _mm256_mul_epu32(m, pN[j]));
+		}
+		t[digits - 0x01u] = _mm256_setzero_si256();
+		t[0] = _mm256_add_epi64(t[0], t0);
+
+		if( (0x00u == ((i + 0x01u) % MB_NORMALIZE_INTERVAL)) )
+		{ mbNormalizeAvx2(t, digits); }
+		else;
+	}
+
+	mbNormalizeAvx2(t, digits);
+
+	for(j = 0x00u; j < digits; ++j)
+	{ pRes[j] = t[j]; }
+}/* mbMontMulAvx2 */
+
+/**
+ * @brief Left-to-right binary exponentiation, every lane follows the same
+ * 			  exponent so the lanes never diverge.
+ */
+MB_TARGET_AVX2 static void
+mbPowModAvx2(const st_rsa_mb_mont_t * const pMbMont, uint64_t * const pDigits, const st_rsa_bn_t * const pExp)
+{
+	/* Function data types */
+	__m256i n[RSA_MB_MAX_DIGITS];
+	__m256i rr[RSA_MB_MAX_DIGITS];
+	__m256i base[RSA_MB_MAX_DIGITS];
+	__m256i acc[RSA_MB_MAX_DIGITS];
+	const __m256i n0inv = _mm256_set1_epi64x((long long) pMbMont->n0inv);
+	const uint32_t digits = pMbMont->digits;
+	int32_t register bit = (int32_t) bnBitLength(pExp) - 0x01;
+	uint32_t register j = 0x00u;
+
+	/* Function body */
+	for(j = 0x00u; j < digits; ++j)
+	{
+		n[j] = _mm256_set1_epi64x((long long) pMbMont->n[j]);
+		rr[j] = _mm256_set1_epi64x((long long) pMbMont->rr[j]);
+		base[j] = _mm256_loadu_si256((const __m256i *) &pDigits[j * RSA_MB_LANES]);
+	}
+
+	/* Entering the montgomery domain */
+	mbMontMulAvx2(n, n0inv, digits, base, base, rr);
+
+	for(j = 0x00u; j < digits; ++j)
+	{ acc[j] = base[j]; }
+
+	for(--bit; bit >= 0; --bit)
+	{
+		mbMontMulAvx2(n, n0inv, digits, acc, acc, acc);
+		if( (bnTestBit(pExp, (uint32_t) bit)) )
+		{ mbMontMulAvx2(n, n0inv, digits, acc, acc, base); }
+		else;
+	}
+
+	/* Leaving the domain, multiplying by 1 */
+	for(j = 0x00u; j < digits; ++j)
+	{ base[j] = _mm256_setzero_si256(); }
+	base[0] = _mm256_set1_epi64x(0x01);
+	mbMontMulAvx2(n, n0inv, digits, acc, acc, base);
+
+	for(j = 0x00u; j < digits; ++j)
+	{ _mm256_storeu_si256((__m256i *) &pDigits[j * RSA_MB_LANES], acc[j]); }
+}/* mbPowModAvx2 */
+
+/**
+ * @brief acc = 2 * acc mod 2n in the lanes set in `select`, an input below
+ * 			  2n stays below 2n. The doubling and the subtraction of 2n share
+ * 				one pass, the lanes left without borrow keep the difference.
+ */
+MB_TARGET_AVX2 static void
+mbModDoubleAvx2(__m256i * const pAcc, const __m256i * const pN2, const __m256i select, const uint32_t digits)
+{
+	/* Function data types */
+	__m256i doubled[RSA_MB_MAX_DIGITS];
+	__m256i reduced[RSA_MB_MAX_DIGITS];
+	const __m256i mask = _mm256_set1_epi64x((long long) RSA_MB_DIGIT_MASK);
+	__m256i carry = _mm256_setzero_si256();
+	__m256i borrow = _mm256_setzero_si256();
+	__m256i keep;
+	uint32_t register j = 0x00u;
+
+	/* Function body */
+	for(j = 0x00u; j < digits; ++j)
+	{
+		const __m256i x = _mm256_add_epi64(_mm256_slli_epi64(pAcc[j], 0x01), carry);
+		__m256i y;
+
+		carry = _mm256_srli_epi64(x, RSA_MB_DIGIT_BITS);
+		doubled[j] = _mm256_and_si256(x, mask);
+		y = _mm256_sub_epi64(_mm256_sub_epi64(doubled[j], pN2[j]), borrow);
+		borrow = _mm256_srli_epi64(y, 63);
+		reduced[j] = _mm256_and_si256(y, mask);
+	}
+
+	/* No borrow out of the top digit means 2 * acc >= 2n */
+	keep = _mm256_cmpeq_epi64(borrow, _mm256_setzero_si256());
+	for(j = 0x00u; j < digits; ++j)
+	{ pAcc[j] = _mm256_blendv_epi8(pAcc[j], _mm256_blendv_epi8(doubled[j], reduced[j], keep), select); }
+}/* mbModDoubleAvx2 */
+
+/**
+ * @brief Four lanes 2^e mod n, every lane has its own odd modulus and
+ * 			  exponent. The accumulators enter as R mod n and the multiplications
+ * 				by 2 are doublings, so they leave as 2^e * R mod n (below 2n) without
+ * 				any domain conversion.
+ */
+MB_TARGET_AVX2 static void
+mbPow2Avx2(uint64_t * const pAcc, const uint64_t * const pN, const uint64_t * const pN2,
+           const uint64_t * const pN0inv, const st_rsa_bn_t * const pExps,
+           const uint32_t digits, const uint32_t bits)
+{
+	/* Function data types */
+	__m256i n[RSA_MB_MAX_DIGITS];
+	__m256i n2[RSA_MB_MAX_DIGITS];
+	__m256i acc[RSA_MB_MAX_DIGITS];
+	const __m256i n0inv = _mm256_loadu_si256((const __m256i *) pN0inv);
+	int32_t register bit = (int32_t) bits - 0x01;
+	uint32_t register j = 0x00u;
+
+	/* Function body */
+	for(j = 0x00u; j < digits; ++j)
+	{
+		n[j] = _mm256_loadu_si256((const __m256i *) &pN[j * 0x04u]);
+		n2[j] = _mm256_loadu_si256((const __m256i *) &pN2[j * 0x04u]);
+		acc[j] = _mm256_loadu_si256((const __m256i *) &pAcc[j * 0x04u]);
+	}
+
+	for(; bit >= 0; --bit)
+	{
+		const __m256i select = _mm256_set_epi64x(-(long long) bnTestBit(&pExps[3], (uint32_t) bit),
+		                                         -(long long) bnTestBit(&pExps[2], (uint32_t) bit),
+		                                         -(long long) bnTestBit(&pExps[1], (uint32_t) bit),
+		                                         -(long long) bnTestBit(&pExps[0], (uint32_t) bit));
+
+		mbMontMulAvx2(n, n0inv, digits, acc, acc, acc);
+		if( (0x00 == _mm256_testz_si256(select, select)) )
+		{ mbModDoubleAvx2(acc, n2, select, digits); }
+		else;
+	}
+
+	for(j = 0x00u; j < digits; ++j)
+	{ _mm256_storeu_si256((__m256i *) &pAcc[j * 0x04u], acc[j]); }
+}/* mbPow2Avx2 */
+
+/**
+ * @brief AVX-512 counterpart of mbNormalizeAvx2(), eight lanes.
+ */
+MB_TARGET_AVX512 static void
+mbNormalizeAvx512(__m512i * const pT, const uint32_t digits)
+{
+	/* Function data types */
+	const __m512i mask = _mm512_set1_epi64((long long) RSA_MB_DIGIT_MASK);
+	__m512i carry = _mm512_setzero_si512();
+	uint32_t register j = 0x00u;
+
+	/* Function body */
+	for(j = 0x00u; j < digits; ++j)
+	{
+		const __m512i t = _mm512_add_epi64(pT[j], carry);
+		carry = _mm512_srli_epi64(t, RSA_MB_DIGIT_BITS);
+		pT[j] = _mm512_and_si512(t, mask);
+	}
+}/* mbNormalizeAvx512 */
+
+/**
+ * @brief AVX-512 counterpart of mbMontMulAvx2(), eight lanes.
+ */
+MB_TARGET_AVX512 static void
+mbMontMulAvx512(const __m512i * const pN, const __m512i n0inv, const uint32_t digits,
+                __m512i * const pRes, const __m512i * const pA, const __m512i * const pB)
+{
+	/* Function data types */
+	__m512i t[RSA_MB_MAX_DIGITS];
+	const __m512i mask = _mm512_set1_epi64((long long) RSA_MB_DIGIT_MASK);
+	uint32_t register i = 0x00u;
+	uint32_t register j = 0x00u;
+
+	/* Function body */
+	for(j = 0x00u; j < digits; ++j)
+	{ t[j] = _mm512_setzero_si512(); }
+
+	for(i = 0x00u; i < digits; ++i)
+	{
+		const __m512i a = pA[i];
+		__m512i t0 = _mm512_add_epi64(t[0], _mm512_mul_epu32(a, pB[0]));
+		const __m512i m = _mm512_and_si512(_mm512_mul_epu32(_mm512_and_si512(t0, mask), n0inv), mask);
+
+		t0 = _mm512_add_epi64(t0, _mm512_mul_epu32(m, pN[0]));
+		t0 = _mm512_srli_epi64(t0, RSA_MB_DIGIT_BITS);
+
+		for(j = 0x01u; j < digits; ++j)
+		{
+			t[j - 0x01u] = _mm512_add_epi64(_mm512_add_epi64(t[j], _mm512_mul_epu32(a, pB[j])),
+			                                _mm512_mul_epu32(m, pN[j]));
+		}
+		t[digits - 0x01u] = _mm512_setzero_si512();
+		t[0] = _mm512_add_epi64(t[0], t0);
+
+		if( (0x00u == ((i + 0x01u) % MB_NORMALIZE_INTERVAL)) )
+		{ mbNormalizeAvx512(t, digits); }
+		else;
+	}
+
+	mbNormalizeAvx512(t, digits);
+
+	for(j = 0x00u; j < digits; ++j)
+	{ pRes[j] = t[j]; }
+}/* mbMontMulAvx512 */
+
+/**
+ * @brief AVX-512 counterpart of mbModDoubleAvx2(), the lanes are picked
+ * 			  through mask registers.
+ */
+MB_TARGET_AVX512 static void
+mbModDoubleAvx512(__m512i * const pAcc, const __m512i * const pN2, const __mmask8 select, const uint32_t digits)
+{
+	/* Function data types */
+	__m512i doubled[RSA_MB_MAX_DIGITS];
+	__m512i reduced[RSA_MB_MAX_DIGITS];
+	const __m512i mask = _mm512_set1_epi64((long long) RSA_MB_DIGIT_MASK);
+	__m512i carry = _mm512_setzero_si512();
+	__m512i borrow = _mm512_setzero_si512();
+	__mmask8 keep = 0x00u;
+	uint32_t register j = 0x00u;
+
+	/* Function body */
+	for(j = 0x00u; j < digits; ++j)
+	{
+		const __m512i x = _mm512_add_epi64(_mm512_slli_epi64(pAcc[j], 0x01u), carry);
+		__m512i y;
+
+		carry = _mm512_srli_epi64(x, RSA_MB_DIGIT_BITS);
+		doubled[j] = _mm512_and_si512(x, mask);
+		y = _mm512_sub_epi64(_mm512_sub_epi64(doubled[j], pN2[j]), borrow);
+		borrow = _mm512_srli_epi64(y, 63u);
+		reduced[j] = _mm512_and_si512(y, mask);
+	}
+
+	keep = _mm512_cmpeq_epi64_mask(borrow, _mm512_setzero_si512());
+	for(j = 0x00u; j < digits; ++j)
+	{ pAcc[j] = _mm512_mask_blend_epi64(select, pAcc[j], _mm512_mask_blend_epi64(keep, doubled[j], reduced[j])); }
+}/* mbModDoubleAvx512 */
+
+/**
+ * @brief AVX-512 counterpart of mbPow2Avx2(), eight lanes.
+ */
+MB_TARGET_AVX512 static void
+mbPow2Avx512(uint64_t * const pAcc, const uint64_t * const pN, const uint64_t * const pN2,
+             const uint64_t * const pN0inv, const st_rsa_bn_t * const pExps,
+             const uint32_t digits, const uint32_t bits)
+{
+	/* Function data types */
+	__m512i n[RSA_MB_MAX_DIGITS];
+	__m512i n2[RSA_MB_MAX_DIGITS];
+	__m512i acc[RSA_MB_MAX_DIGITS];
+	const __m512i n0inv = _mm512_loadu_si512((const void *) pN0inv);
+	__mmask8 select = 0x00u;
+	int32_t register bit = (int32_t) bits - 0x01;
+	uint32_t register j = 0x00u;
+
+	/* Function body */
+	for(j = 0x00u; j < digits; ++j)
+	{
+		n[j] = _mm512_loadu_si512((const void *) &pN[j * 0x08u]);
+		n2[j] = _mm512_loadu_si512((const void *) &pN2[j * 0x08u]);
+		acc[j] = _mm512_loadu_si512((const void *) &pAcc[j * 0x08u]);
+	}
+
+	for(; bit >= 0; --bit)
+	{
+		for(select = 0x00u, j = 0x00u; j < 0x08u; ++j)
+		{ select |= (__mmask8) (bnTestBit(&pExps[j], (uint32_t) bit) << j); }
+
+		mbMontMulAvx512(n, n0inv, digits, acc, acc, acc);
+		if( (0x00u != select) )
+		{ mbModDoubleAvx512(acc, n2, select, digits); }
+		else;
+	}
+
+	for(j = 0x00u; j < digits; ++j)
+	{ _mm512_storeu_si512((void *) &pAcc[j * 0x08u], acc[j]); }
+}/* mbPow2Avx512 */
+
+#endif /* RSA_MB_AVX2_BUILD */
+
+/**
+ * @brief -n^-1 mod 2^29 of an odd n, newton iterations double the correct
+ * 			  low bits of the inverse starting from the 3 bits of n itself.
+ */
+_STATIC_INLINE uint64_t
+mbDigitInverse(const uint64_t n)
+{
+	/* Function data types */
+	uint64_t inv = n;
+	uint32_t register i = 0x00u;
+
+	/* Function body */
+	for(i = 0x00u; i < 0x04u; ++i)
+	{ inv *= 0x02u - (n * inv); }
+
+	return (0x00u - inv) & RSA_MB_DIGIT_MASK;
+}/* mbDigitInverse */
+
+/*
+*--------------------------------------------------------------------------------------
+*- Public Functions Implementation
+*--------------------------------------------------------------------------------------
+**/
+
+/**
+ * @brief Runtime CPU detection of the multi-buffer kernels.
+ */
+uint8_t
+mbIsAvailable(void)
+{
+#if defined(RSA_MB_AVX2_BUILD)
+	__builtin_cpu_init();
+	return (__builtin_cpu_supports("avx2")) ? (0x01u) : (0x00u);
+#else
+	return 0x00u;
+#endif
+}/* mbIsAvailable */
+
+/**
+ * @brief Lanes of the prime filter kernel the CPU can run, 8 with AVX-512,
+ * 			  4 with AVX2 and 0 when only the scalar tests are available.
+ */
+uint32_t
+mbPrimeLanes(void)
+{
+#if defined(RSA_MB_AVX2_BUILD) && (SIMD_PRIME_TEST_FLAG == SIMD_PRIME_TEST_ACTIVE)
+	__builtin_cpu_init();
+	if( (__builtin_cpu_supports("avx512f")) )
+	{ return 0x08u; }
+	else if( (__builtin_cpu_supports("avx2")) )
+	{ return 0x04u; }
+	else;
+#endif
+
+	return 0x00u;
+}/* mbPrimeLanes */
+
+/**
+ * @brief Converts the modulus to radix 2^29, R^2 mod n is computed with the
+ * 			  regular engine as 2^(2 * 29 * digits) mod n.
+ */
+void
+mbMontInit(st_rsa_mb_mont_t * const pMbMont, const st_rsa_bn_mont_t * const pMont)
+{
+	/* Validating */
+#if (FULL_ASSERTION_FLAG == FULL_ASSERTION_ACTIVE)
+	STATIC_ASSERT((pMbMont != NULL) && (pMont != NULL), DEFAULT_EXIT_CODE);
+#endif
+	/* Function data types */
+	uint64_t digits[RSA_MB_MAX_DIGITS * RSA_MB_LANES];
+	st_rsa_bn_t two;
+	st_rsa_bn_t exp;
+	st_rsa_bn_t rr;
+	uint32_t register i = 0x00u;
+
+	/* Function body */
+	memset(pMbMont, 0x00u, sizeof(*pMbMont));
+	bnCopy(&pMbMont->modulus, &pMont->n);
+	pMbMont->digits = ((bnBitLength(&pMont->n) + 0x02u) + RSA_MB_DIGIT_BITS - 0x01u) / RSA_MB_DIGIT_BITS;
+	pMbMont->n0inv = pMont->n0inv & RSA_MB_DIGIT_MASK;
+
+	bnFromWord(&two, 0x02u);
+	bnFromWord(&exp, 0x02u * RSA_MB_DIGIT_BITS * (uint64_t) pMbMont->digits);
+	bnPowMod(pMont, &rr, &two, &exp);
+
+	mbFromBn(digits, 0x00u, RSA_MB_LANES, pMbMont->digits, &pMont->n);
+	for(i = 0x00u; i < pMbMont->digits; ++i)
+	{ pMbMont->n[i] = digits[i * RSA_MB_LANES]; }
+
+	mbFromBn(digits, 0x00u, RSA_MB_LANES, pMbMont->digits, &rr);
+	for(i = 0x00u; i < pMbMont->digits; ++i)
+	{ pMbMont->rr[i] = digits[i * RSA_MB_LANES]; }
+}/* mbMontInit */
+
+/**
+ * @brief pRes[l] = pBase[l] ^ exp mod n for the RSA_MB_LANES lanes, the bases
+ * 			  must be reduced below n. Only valid when mbIsAvailable() is true.
+ */
+void
+mbPowMod(const st_rsa_mb_mont_t * const pMbMont, st_rsa_bn_t * const pRes,
+         const st_rsa_bn_t * const pBase, const st_rsa_bn_t * const pExp)
+{
+	/* Validating */
+#if (FULL_ASSERTION_FLAG == FULL_ASSERTION_ACTIVE)
+	STATIC_ASSERT((pExp->used > 0x00u), DEFAULT_EXIT_CODE);
+#endif
+	/* Function data types */
+	uint64_t digits[RSA_MB_MAX_DIGITS * RSA_MB_LANES];
+	uint32_t register lane = 0x00u;
+
+	/* Function body */
+	for(lane = 0x00u; lane < RSA_MB_LANES; ++lane)
+	{ mbFromBn(digits, lane, RSA_MB_LANES, pMbMont->digits, &pBase[lane]); }
+
+#if defined(RSA_MB_AVX2_BUILD)
+	mbPowModAvx2(pMbMont, digits, pExp);
+#else
+	#if (FULL_ASSERTION_FLAG == FULL_ASSERTION_ACTIVE)
+	STATIC_ASSERT((0x00u), DEFAULT_EXIT_CODE);
+	#endif
+#endif
+
+	/* The almost montgomery result may still be equal to n */
+	for(lane = 0x00u; lane < RSA_MB_LANES; ++lane)
+	{
+		mbToBn(&pRes[lane], digits, lane, RSA_MB_LANES, pMbMont->digits);
+		if( (bnCompare(&pRes[lane], &pMbMont->modulus) >= 0) )
+		{ bnSub(&pRes[lane], &pRes[lane], &pMbMont->modulus); }
+		else;
+	}
+
+	RSA_STATS_ADD(powModCalls, RSA_MB_LANES);
+}/* mbPowMod */
+
+/**
+ * @brief Base 2 fermat test of `count` odd candidates, mbPrimeLanes() at a
+ * 			  time. pPass[i] is 0 when 2 proves pCandidates[i] composite, a prime
+ * 				always passes. Only valid when mbPrimeLanes() is not 0.
+ */
+void
+mbFermatBase2(const st_rsa_bn_t * const pCandidates, uint8_t * const pPass, const uint32_t count)
+{
+	/* Function data types */
+	uint64_t n[RSA_MB_MAX_DIGITS * RSA_MB_MAX_PRIME_LANES];
+	uint64_t n2[RSA_MB_MAX_DIGITS * RSA_MB_MAX_PRIME_LANES];
+	uint64_t acc[RSA_MB_MAX_DIGITS * RSA_MB_MAX_PRIME_LANES];
+	uint64_t n0inv[RSA_MB_MAX_PRIME_LANES];
+	st_rsa_bn_t exps[RSA_MB_MAX_PRIME_LANES];
+	st_rsa_bn_t rModN[RSA_MB_MAX_PRIME_LANES];
+	st_rsa_bn_t value;
+	const uint32_t lanes = mbPrimeLanes();
+	const st_rsa_bn_t *pN = NULL;
+	uint32_t first = 0x00u;
+	uint32_t bits = 0x00u;
+	uint32_t digits = 0x00u;
+	uint32_t register lane = 0x00u;
+
+	/* Validating */
+#if (FULL_ASSERTION_FLAG == FULL_ASSERTION_ACTIVE)
+	STATIC_ASSERT((pCandidates != NULL) && (pPass != NULL) && (lanes > 0x00u), DEFAULT_EXIT_CODE);
+#endif
+
+	/* Function body */
+	for(first = 0x00u; first < count; first += lanes)
+	{
+		/* The spare lanes of the last group repeat its first candidate */
+		for(bits = 0x00u, lane = 0x00u; lane < lanes; ++lane)
+		{
+			pN = &pCandidates[((first + lane) < count) ? (first + lane) : (first)];
+			if( (bnBitLength(pN) > bits) )
+			{ bits = bnBitLength(pN); }
+			else;
+		}
+
+		/* R = 2^(29 * digits) must exceed 4n and fit a number */
+		digits = ((bits + 0x02u) + RSA_MB_DIGIT_BITS - 0x01u) / RSA_MB_DIGIT_BITS;
+#if (FULL_ASSERTION_FLAG == FULL_ASSERTION_ACTIVE)
+		STATIC_ASSERT(((RSA_MB_DIGIT_BITS * digits) < RSA_MAX_KEY_BITS), DEFAULT_EXIT_CODE);
+#endif
+
+		for(lane = 0x00u; lane < lanes; ++lane)
+		{
+			pN = &pCandidates[((first + lane) < count) ? (first + lane) : (first)];
+
+			mbFromBn(n, lane, lanes, digits, pN);
+			bnAdd(&value, pN, pN);
+			mbFromBn(n2, lane, lanes, digits, &value);
+			n0inv[lane] = mbDigitInverse(pN->limbs[0]);
+			bnSubWord(&exps[lane], pN, 0x01u);
+
+			/* R mod n, the montgomery form of 1 */
+			bnZero(&value);
+			value.limbs[(RSA_MB_DIGIT_BITS * digits) / RSA_BN_LIMB_BITS] = 0x01ull << ((RSA_MB_DIGIT_BITS * digits) % RSA_BN_LIMB_BITS);
+			value.used = ((RSA_MB_DIGIT_BITS * digits) / RSA_BN_LIMB_BITS) + 0x01u;
+			bnMod(&rModN[lane], &value, pN);
+			mbFromBn(acc, lane, lanes, digits, &rModN[lane]);
+		}
+
+#if defined(RSA_MB_AVX2_BUILD)
+		if( (0x08u == lanes) )
+		{ mbPow2Avx512(acc, n, n2, n0inv, exps, digits, bits); }
+		else
+		{ mbPow2Avx2(acc, n, n2, n0inv, exps, digits, bits); }
+#endif
+
+		/* A prime leaves as R mod n, 2^(n - 1) being 1 */
+		for(lane = 0x00u; (lane < lanes) && ((first + lane) < count); ++lane)
+		{
+			mbToBn(&value, acc, lane, lanes, digits);
+			if( (bnCompare(&value, &pCandidates[first + lane]) >= 0) )
+			{ bnSub(&value, &value, &pCandidates[first + lane]); }
+			else;
+
+			pPass[first + lane] = (0x00 == bnCompare(&value, &rModN[lane])) ? (0x01u) : (0x00u);
+		}
+	}
+
+	RSA_STATS_ADD(powModCalls, count);
+}/* mbFermatBase2 */
@@ -0,0 +1,104 @@
+/**
+ * @file rsa_mod.cpp
+ * @author Mohamed ashraf (wx@wx.com)
+ * @brief rsa fixed size montgomery kernels program file
+ * @version 0.1
+ * @date 2023-01-01
+ *
+ * @copyright Copyright (c) Wx 2023
+ *
+ * @attention
+ *      The only C++ translation unit, it instantiates rsa::modulus<Bits> for
+ *      the fixed sizes and exposes them to C as plain function pointers.
+ *      Built without exceptions and RTTI, it needs nothing from libstdc++.
+ *
+ */
+#include <stdint.h>
+#include <stddef.h>
+
+#include "rsa_cfg.h"
+#include "rsa_mod.h"
+#include "rsa_mod.hpp"
+
+/*
+*--------------------------------------------------------------------------------------
+*- Private Functions Implementation
+*--------------------------------------------------------------------------------------
+**/
+
+#if (FIXED_KERNELS_FLAG == FIXED_KERNELS_ACTIVE)
+template<uint32_t Bits>
+static void
+fixedMontMul(uint64_t * const pRes, const uint64_t * const pA, const uint64_t * const pB,
+             const uint64_t * const pN, const uint64_t n0inv)
+{
+	rsa::modulus<Bits>(pN, n0inv).mul(pRes, pA, pB);
+}/* fixedMontMul */
+
+template<uint32_t Bits>
+static void
+fixedMontSqr(uint64_t * const pRes, const uint64_t * const pA,
+             const uint64_t * const pN, const uint64_t n0inv)
+{
+	rsa::modulus<Bits>(pN, n0inv).sqr(pRes, pA);
+}/* fixedMontSqr */
+
+/** @brief The 1024 to 4096-bit moduli, the primes of their CRT halves and the
+ * 		primes of the 3 and 4 prime keys */
+#define RSA_MOD_KERNELS(_BITS) { rsa::modulus<_BITS>::limbs, fixedMontMul<_BITS>, fixedMontSqr<_BITS> }
+/** @brief Squaring only, the generic karatsuba multiplication beats the CIOS one */
+#define RSA_MOD_SQR_KERNEL(_BITS) { rsa::modulus<_BITS>::limbs, NULL, fixedMontSqr<_BITS> }
+
+static const st_rsa_mod_kernels_t modKernels[] =
+{
+	RSA_MOD_KERNELS(512u),
+	RSA_MOD_KERNELS(1024u),
+	RSA_MOD_KERNELS(1536u),
+	RSA_MOD_KERNELS(2048u),
+	RSA_MOD_KERNELS(3072u),
+	RSA_MOD_SQR_KERNEL(4096u),
+	RSA_MOD_KERNELS(256u),
+	RSA_MOD_KERNELS(384u),
+	RSA_MOD_KERNELS(704u),
+	RSA_MOD_KERNELS(768u),
+	RSA_MOD_KERNELS(1408u)
+};
+#endif
+
+/*
+*--------------------------------------------------------------------------------------
+*- Public Functions Implementation
+*--------------------------------------------------------------------------------------
+**/
+
+/**
+ * @brief Kernels of a `len` limbs modulus, NULL when the size has no fixed
+ * 			  kernels or they are compiled out.
+ */
+extern "C" const st_rsa_mod_kernels_t *
+modGetKernels(const uint32_t len)
+{
+#if (FIXED_KERNELS_FLAG == FIXED_KERNELS_ACTIVE)
+	/* Function body */
+	/* A jump table, called on every montgomery operation */
+	switch(len)
+	{
+		case rsa::modulus<512u>::limbs: 	return &modKernels[0];
+		case rsa::modulus<1024u>::limbs: 	return &modKernels[1];
+		case rsa::modulus<1536u>::limbs: 	return &modKernels[2];
+		case rsa::modulus<2048u>::limbs: 	return &modKernels[3];
+		case rsa::modulus<3072u>::limbs: 	return &modKernels[4];
+		case rsa::modulus<4096u>::limbs: 	return &modKernels[5];
+		case rsa::modulus<256u>::limbs: 	return &modKernels[6];
+		case rsa::modulus<384u>::limbs: 	return &modKernels[7];
+		case rsa::modulus<704u>::limbs: 	return &modKernels[8];
+		case rsa::modulus<768u>::limbs: 	return &modKernels[9];
+		case rsa::modulus<1408u>::limbs: 	return &modKernels[10];
+		default: 													return NULL;
+	}
+#else
+	(void) len;
+
+	return NULL;
+#endif
+}/* modGetKernels */
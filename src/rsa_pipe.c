@@ -0,0 +1,425 @@
+/**
+ * @file rsa_pipe.c
+ * @author Mohamed ashraf (wx@wx.com)
+ * @brief rsa file pipeline program file
+ * @version 0.1
+ * @date 2023-01-01
+ *
+ * @copyright Copyright (c) Wx 2023
+ *
+ * @attention
+ *      The calling thread reads the input in fixed size chunks into a ring
+ *      of slots, the workers turn every filled slot into block mode output
+ *      and a writer thread flushes the slots back in file order. The ring
+ *      size is fixed, so a slow writer stalls the reader instead of growing
+ *      the memory use.
+ *
+ */
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <unistd.h>
+
+#include "rsa_cfg.h"
+#include "rsa_prv.h"
+#include "rsa_int.h"
+#include "rsa_trace.h"
+
+/*
+*--------------------------------------------------------------------------------------
+*- Macros
+*--------------------------------------------------------------------------------------
+**/
+
+#define RSA_PIPE_MAX_WORKERS 				(0x40u)
+/** @brief Alignment of the ring buffers, keeps every buffer on its own cache lines */
+#define RSA_PIPE_ALIGN 							(0x40u)
+
+/*
+*--------------------------------------------------------------------------------------
+*- Data types
+*--------------------------------------------------------------------------------------
+**/
+
+typedef enum en_rsa_pipe_slot_state
+{
+	pipeSlotFree = 0x00u, 		/* Owned by the reader */
+	pipeSlotFilled, 					/* Waiting for a worker */
+	pipeSlotBusy, 						/* Owned by a worker */
+	pipeSlotDone 							/* Waiting for the writer */
+}en_rsa_pipe_slot_state_t;
+
+typedef struct rsa_pipe_slot
+{
+	uint8_t *pIn;
+	uint8_t *pOut;
+	uint64_t inLen;
+	uint64_t outLen;
+	en_rsa_pipe_slot_state_t state;
+}st_rsa_pipe_slot_t;
+
+/**
+ * @brief State shared by the stages of one file, chunk `seq` always lives
+ * 			  in slot `seq % numOfSlots`.
+*/
+typedef struct rsa_pipe
+{
+	const rsa_ctx_t *pCtx;
+	uint8_t decrypt;
+	FILE *pOutFile;
+	st_rsa_pipe_slot_t *pSlots;
+	uint32_t numOfSlots;
+	pthread_mutex_t lock; 					/* Guards everything below */
+	pthread_cond_t changed; 				/* Broadcast on every slot state change */
+	uint64_t readSeq; 							/* Chunks filled by the reader */
+	uint64_t workSeq; 							/* Chunks taken by the workers */
+	uint64_t writeSeq; 							/* Chunks flushed by the writer */
+	uint8_t eof;
+	en_rsa_status_t status; 				/* First failure of any stage */
+}st_rsa_pipe_t;
+
+/*
+*--------------------------------------------------------------------------------------
+*- Private Functions Implementation
+*--------------------------------------------------------------------------------------
+**/
+
+/**
+ * @brief Records the first failure and wakes every stage so they can leave.
+ */
+static void
+pipeFail(st_rsa_pipe_t * const pPipe, const en_rsa_status_t status)
+{
+	/* Function body */
+	pthread_mutex_lock(&pPipe->lock);
+	if( (rsaStatusOk == pPipe->status) )
+	{ pPipe->status = status; }
+	else;
+	pthread_cond_broadcast(&pPipe->changed);
+	pthread_mutex_unlock(&pPipe->lock);
+}/* pipeFail */
+
+static void *
+pipeWorker(void *pArg)
+{
+	/* Function data types */
+	st_rsa_pipe_t * const pPipe = (st_rsa_pipe_t *) pArg;
+	st_rsa_pipe_slot_t *pSlot = NULL;
+	en_rsa_status_t status = rsaStatusOk;
+	uint64_t seq = 0x00u;
+
+	/* Function body */
+	pthread_mutex_lock(&pPipe->lock);
+	while( (rsaStatusOk == pPipe->status) )
+	{
+		if( (pPipe->workSeq == pPipe->readSeq) )
+		{
+			if( (pPipe->eof) )
+			{ break; }
+			else;
+
+			pthread_cond_wait(&pPipe->changed, &pPipe->lock);
+			continue;
+		}
+		else;
+
+		pSlot = &pPipe->pSlots[pPipe->workSeq % pPipe->numOfSlots];
+		pSlot->state = pipeSlotBusy;
+		seq = pPipe->workSeq++;
+		pthread_mutex_unlock(&pPipe->lock);
+
+		RSA_TRACE(traceEventPipeChunk, seq, pSlot->inLen);
+
+		if( (pPipe->decrypt) )
+		{ status = rsa_ctx_decrypt_blocks(pPipe->pCtx, pSlot->pIn, pSlot->inLen, pSlot->pOut, &pSlot->outLen); }
+		else
+		{
+			pSlot->outLen = rsa_ctx_block_cipher_size(pPipe->pCtx, pSlot->inLen);
+			status = rsa_ctx_encrypt_blocks(pPipe->pCtx, pSlot->pIn, pSlot->inLen, pSlot->pOut);
+		}
+
+		pthread_mutex_lock(&pPipe->lock);
+		if( (rsaStatusOk == status) )
+		{ pSlot->state = pipeSlotDone; }
+		else if( (rsaStatusOk == pPipe->status) )
+		{ pPipe->status = status; }
+		else;
+		pthread_cond_broadcast(&pPipe->changed);
+	}
+	pthread_mutex_unlock(&pPipe->lock);
+
+	return NULL;
+}/* pipeWorker */
+
+static void *
+pipeWriter(void *pArg)
+{
+	/* Function data types */
+	st_rsa_pipe_t * const pPipe = (st_rsa_pipe_t *) pArg;
+	st_rsa_pipe_slot_t *pSlot = NULL;
+	uint8_t written = 0x00u;
+
+	/* Function body */
+	pthread_mutex_lock(&pPipe->lock);
+	while( (rsaStatusOk == pPipe->status) )
+	{
+		if( (pPipe->writeSeq == pPipe->readSeq) && (pPipe->eof) )
+		{ break; }
+		else;
+
+		pSlot = &pPipe->pSlots[pPipe->writeSeq % pPipe->numOfSlots];
+		if( (pPipe->writeSeq == pPipe->readSeq) || (pipeSlotDone != pSlot->state) )
+		{
+			pthread_cond_wait(&pPipe->changed, &pPipe->lock);
+			continue;
+		}
+		else;
+
+		pthread_mutex_unlock(&pPipe->lock);
+		written = (pSlot->outLen == fwrite(pSlot->pOut, 0x01u, pSlot->outLen, pPipe->pOutFile));
+		pthread_mutex_lock(&pPipe->lock);
+
+		if( (written) )
+		{
+			pSlot->state = pipeSlotFree;
+			++pPipe->writeSeq;
+		}
+		else if( (rsaStatusOk == pPipe->status) )
+		{ pPipe->status = rsaStatusIoError; }
+		else;
+		pthread_cond_broadcast(&pPipe->changed);
+	}
+	pthread_mutex_unlock(&pPipe->lock);
+
+	return NULL;
+}/* pipeWriter */
+
+/**
+ * @brief Reader stage, runs on the calling thread until the input ends or
+ * 			  any stage fails.
+ */
+static void
+pipeReader(st_rsa_pipe_t * const pPipe, FILE * const pInFile, const uint64_t chunkLen, const uint32_t blockLen)
+{
+	/* Function data types */
+	st_rsa_pipe_slot_t *pSlot = NULL;
+	uint64_t readLen = 0x00u;
+	uint8_t eof = 0x00u;
+
+	/* Function body */
+	pthread_mutex_lock(&pPipe->lock);
+	while( (rsaStatusOk == pPipe->status) && (0x00u == eof) )
+	{
+		pSlot = &pPipe->pSlots[pPipe->readSeq % pPipe->numOfSlots];
+		if( (pipeSlotFree != pSlot->state) )
+		{
+			pthread_cond_wait(&pPipe->changed, &pPipe->lock);
+			continue;
+		}
+		else;
+
+		pthread_mutex_unlock(&pPipe->lock);
+		readLen = fread(pSlot->pIn, 0x01u, chunkLen, pInFile);
+		eof = (readLen < chunkLen);
+
+		if( (eof) && (ferror(pInFile)) )
+		{ pipeFail(pPipe, rsaStatusIoError); }
+		else if( (pPipe->decrypt) && (0x00u != (readLen % blockLen)) )
+		{ pipeFail(pPipe, rsaStatusInvalidCipher); }
+		else;
+
+		pthread_mutex_lock(&pPipe->lock);
+		if( (readLen > 0x00u) )
+		{
+			pSlot->inLen = readLen;
+			pSlot->state = pipeSlotFilled;
+			++pPipe->readSeq;
+			pthread_cond_broadcast(&pPipe->changed);
+		}
+		else;
+	}
+	pPipe->eof = 0x01u;
+	pthread_cond_broadcast(&pPipe->changed);
+	pthread_mutex_unlock(&pPipe->lock);
+}/* pipeReader */
+
+static en_rsa_status_t
+pipeRun(const rsa_ctx_t * const pCtx, const char * const pInPath, const char * const pOutPath,
+        const uint32_t numOfWorkers, const uint8_t decrypt)
+{
+	/* Function data types */
+	st_rsa_pipe_t pipe;
+	pthread_t workers[RSA_PIPE_MAX_WORKERS];
+	pthread_t writer;
+	FILE *pInFile = NULL;
+	int outFd = -1;
+	rsa_arena_t ring;
+	rsa_allocator_t allocator;
+	void *pRing = NULL;
+	size_t ringLen = 0x00u;
+	size_t bufferLen = 0x00u;
+	uint32_t workersCount = numOfWorkers;
+	uint32_t started = 0x00u;
+	uint32_t blockLen = 0x00u;
+	uint64_t chunkLen = 0x00u;
+	uint8_t writerStarted = 0x00u;
+	uint32_t register i = 0x00u;
+
+	/* Validating */
+	if( (NULL == pCtx) || (NULL == pInPath) || (NULL == pOutPath) )
+	{ return rsaStatusNullArgument; }
+	else if( (0x00u == pCtx->keyReady) )
+	{ return rsaStatusNoKey; }
+	else if( (pCtx->pub.modulusBytes <= (RSA_BLOCK_HEADER_BYTES + 0x01u)) )
+	{ return rsaStatusInvalidKeySize; }
+	else;
+
+	/* Function body */
+	if( (0x00u == workersCount) )
+	{
+		const long onlineCores = sysconf(_SC_NPROCESSORS_ONLN);
+		workersCount = (onlineCores > 0) ? ((uint32_t) onlineCores) : (0x01u);
+	}
+	else;
+
+	if( (workersCount > RSA_PIPE_MAX_WORKERS) )
+	{ workersCount = RSA_PIPE_MAX_WORKERS; }
+	else;
+
+	/* Encryption chunks hold whole block payloads so every chunk maps to whole blocks */
+	blockLen = pCtx->pub.modulusBytes;
+	chunkLen = (decrypt) ? ((uint64_t) blockLen * RSA_PIPE_CHUNK_BLOCKS)
+	                     : ((uint64_t) (blockLen - RSA_BLOCK_HEADER_BYTES - 0x01u) * RSA_PIPE_CHUNK_BLOCKS);
+
+	memset(&pipe, 0x00u, sizeof(pipe));
+	pipe.pCtx = pCtx;
+	pipe.decrypt = decrypt;
+	pipe.numOfSlots = workersCount * RSA_PIPE_SLOTS_PER_WORKER;
+	pipe.status = rsaStatusOk;
+
+	pInFile = fopen(pInPath, "rb");
+	if( (NULL == pInFile) )
+	{ return rsaStatusIoError; }
+	else;
+
+	/* The output is plaintext when decrypting, keep it owner only like the key file */
+	outFd = open(pOutPath, O_WRONLY | O_CREAT | O_TRUNC, 0600);
+	pipe.pOutFile = (outFd >= 0) ? (fdopen(outFd, "wb")) : (NULL);
+	if( (NULL == pipe.pOutFile) )
+	{
+		if( (outFd >= 0) )
+		{ close(outFd); }
+		else;
+
+		fclose(pInFile);
+		return rsaStatusIoError;
+	}
+	else;
+
+	/* The ring is carved out of a single allocation, both directions fit a block multiple */
+	bufferLen = (size_t) blockLen * RSA_PIPE_CHUNK_BLOCKS;
+	ringLen = (pipe.numOfSlots * sizeof(st_rsa_pipe_slot_t)) + (pipe.numOfSlots * 0x02u * (bufferLen + RSA_PIPE_ALIGN));
+	allocator = getCtxAllocator(pCtx);
+	pRing = allocator.pfAlloc(allocator.pUser, ringLen, RSA_PIPE_ALIGN);
+	if( (NULL != pRing) )
+	{
+		rsa_arena_init(&ring, pRing, ringLen);
+		pipe.pSlots = (st_rsa_pipe_slot_t *) rsa_arena_alloc(&ring, pipe.numOfSlots * sizeof(st_rsa_pipe_slot_t), RSA_PIPE_ALIGN);
+		memset(pipe.pSlots, 0x00u, pipe.numOfSlots * sizeof(st_rsa_pipe_slot_t));
+		for(i = 0x00u; i < pipe.numOfSlots; ++i)
+		{
+			pipe.pSlots[i].pIn = (uint8_t *) rsa_arena_alloc(&ring, bufferLen, RSA_PIPE_ALIGN);
+			pipe.pSlots[i].pOut = (uint8_t *) rsa_arena_alloc(&ring, bufferLen, RSA_PIPE_ALIGN);
+		}
+	}
+	else
+	{ pipe.status = rsaStatusNoMemory; }
+
+	pthread_mutex_init(&pipe.lock, NULL);
+	pthread_cond_init(&pipe.changed, NULL);
+
+	if( (rsaStatusOk == pipe.status) )
+	{
+		writerStarted = (0x00 == pthread_create(&writer, NULL, pipeWriter, &pipe));
+		for(i = 0x00u; (writerStarted) && (i < workersCount); ++i)
+		{
+			if( (0x00 == pthread_create(&workers[started], NULL, pipeWorker, &pipe)) )
+			{ ++started; }
+			else;
+		}
+
+		if( (0x00u == started) )
+		{ pipeFail(&pipe, rsaStatusNoMemory); }
+		else;
+
+		pipeReader(&pipe, pInFile, chunkLen, blockLen);
+
+		for(i = 0x00u; i < started; ++i)
+		{ pthread_join(workers[i], NULL); }
+
+		if( (writerStarted) )
+		{ pthread_join(writer, NULL); }
+		else;
+	}
+	else;
+
+	pthread_cond_destroy(&pipe.changed);
+	pthread_mutex_destroy(&pipe.lock);
+
+	/* The output slots hold plaintext when decrypting */
+	if( (NULL != pRing) )
+	{
+		memset(pRing, 0x00u, ringLen);
+		allocator.pfFree(allocator.pUser, pRing);
+	}
+	else;
+
+	fclose(pInFile);
+	if( (0x00 != fclose(pipe.pOutFile)) && (rsaStatusOk == pipe.status) )
+	{ pipe.status = rsaStatusIoError; }
+	else;
+
+	/* A failed run must not leave a truncated output behind */
+	if( (rsaStatusOk != pipe.status) )
+	{ remove(pOutPath); }
+	else;
+
+#if (DEBUGGING_FLAG == DEBUGGING_ACTIVE)
+	win64_dbg_msg("Pipeline: %llu chunks, %u workers, %u slots of %llu bytes, status %u",
+	              (unsigned long long) pipe.writeSeq, started, pipe.numOfSlots,
+	              (unsigned long long) chunkLen, pipe.status);
+#endif
+
+	return pipe.status;
+}/* pipeRun */
+
+/*
+*--------------------------------------------------------------------------------------
+*- Public Functions Implementation
+*--------------------------------------------------------------------------------------
+**/
+
+/**
+ * @brief Encrypts a file of any size in block mode, `numOfWorkers` crypto
+ * 			  threads (0 uses every online core) run next to the reader and writer.
+ */
+en_rsa_status_t
+rsa_pipe_encrypt_file(const rsa_ctx_t * const pCtx, const char * const pInPath,
+                      const char * const pOutPath, const uint32_t numOfWorkers)
+{
+	return pipeRun(pCtx, pInPath, pOutPath, numOfWorkers, 0x00u);
+}/* rsa_pipe_encrypt_file */
+
+/**
+ * @brief Decrypts a file written by rsa_pipe_encrypt_file(), the output is
+ * 			  removed if any block fails to decrypt.
+ */
+en_rsa_status_t
+rsa_pipe_decrypt_file(const rsa_ctx_t * const pCtx, const char * const pInPath,
+                      const char * const pOutPath, const uint32_t numOfWorkers)
+{
+	return pipeRun(pCtx, pInPath, pOutPath, numOfWorkers, 0x01u);
+}/* rsa_pipe_decrypt_file */
@@ -0,0 +1,412 @@
+/**
+ * @file rsa_pool.c
+ * @author Mohamed ashraf (wx@wx.com)
+ * @brief rsa background key pool program file
+ * @version 0.1
+ * @date 2023-01-01
+ *
+ * @copyright Copyright (c) Wx 2023
+ *
+ * @attention
+ *      Generator threads fill a bounded multi-producer multi-consumer ring of
+ *      ready contexts, every cell carries a sequence number telling whether it
+ *      is ready to be written or read, so both ends only use atomics.
+ *      `planned` counts the ready keys plus the ones being generated, a
+ *      generator reserves a key by raising it up to the high watermark and
+ *      the ring is sized above it, so a push never finds the ring full.
+ *      Idle generators sleep on a semaphore posted by rsa_pool_take() when
+ *      `planned` drops below the low watermark, sem_post() takes no lock so
+ *      the take path stays lock-free.
+ *
+ */
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <semaphore.h>
+
+#include "rsa_cfg.h"
+#include "rsa_prv.h"
+#include "rsa_int.h"
+#include "rsa_trace.h"
+
+/*
+*--------------------------------------------------------------------------------------
+*- Macros
+*--------------------------------------------------------------------------------------
+**/
+
+/** @brief Keeps the producer and consumer positions on their own cache lines */
+#define RSA_POOL_ALIGN 							(0x40u)
+#define RSA_POOL_MAX_THREADS 				(0x10u)
+
+/*
+*--------------------------------------------------------------------------------------
+*- Data types
+*--------------------------------------------------------------------------------------
+**/
+
+/**
+ * @brief Ring cell, seq == pos when free for the push of position pos and
+ * 			  seq == pos + 1 once it holds the key of that position.
+*/
+typedef struct rsa_pool_cell
+{
+	uint64_t seq;
+	rsa_ctx_t *pCtx;
+}st_rsa_pool_cell_t;
+
+typedef struct rsa_pool
+{
+	uint64_t pushPos __attribute__((aligned(RSA_POOL_ALIGN)));
+	uint64_t takePos __attribute__((aligned(RSA_POOL_ALIGN)));
+	uint32_t ready __attribute__((aligned(RSA_POOL_ALIGN))); 	/* Keys in the ring */
+	uint32_t planned; 							/* Keys in the ring or being generated */
+	uint8_t stop;
+	st_rsa_pool_cell_t *pCells;
+	uint32_t mask; 									/* Number of cells - 1 */
+	rsa_pool_cfg_t cfg;
+	rsa_allocator_t allocator;
+	sem_t refill; 									/* Posted when `planned` drops below the low watermark */
+	pthread_t threads[RSA_POOL_MAX_THREADS];
+	uint32_t numOfThreads; 					/* Generators started */
+}st_rsa_pool_t;
+
+/*
+*--------------------------------------------------------------------------------------
+*- Private Functions Implementation
+*--------------------------------------------------------------------------------------
+**/
+
+/**
+ * @brief Pushes a ready key, the reservation made through `planned`
+ * 			  guarantees a free cell.
+ */
+static void
+poolPush(st_rsa_pool_t * const pPool, rsa_ctx_t * const pCtx)
+{
+	/* Function data types */
+	st_rsa_pool_cell_t *pCell = NULL;
+	uint64_t pos = __atomic_load_n(&pPool->pushPos, __ATOMIC_RELAXED);
+	uint64_t seq = 0x00u;
+
+	/* Function body */
+	while(1)
+	{
+		pCell = &pPool->pCells[pos & pPool->mask];
+		seq = __atomic_load_n(&pCell->seq, __ATOMIC_ACQUIRE);
+
+		if( (seq == pos) )
+		{
+			if( (__atomic_compare_exchange_n(&pPool->pushPos, &pos, pos + 0x01u, 0x00u,
+			                                 __ATOMIC_RELAXED, __ATOMIC_RELAXED)) )
+			{ break; }
+			else;
+		}
+		else
+		{ pos = __atomic_load_n(&pPool->pushPos, __ATOMIC_RELAXED); }
+	}
+
+	pCell->pCtx = pCtx;
+	__atomic_store_n(&pCell->seq, pos + 0x01u, __ATOMIC_RELEASE);
+	__atomic_fetch_add(&pPool->ready, 0x01u, __ATOMIC_RELEASE);
+}/* poolPush */
+
+/**
+ * @brief Pops the oldest ready key.
+ * @return NULL when the ring is empty.
+ */
+static rsa_ctx_t *
+poolPop(st_rsa_pool_t * const pPool)
+{
+	/* Function data types */
+	st_rsa_pool_cell_t *pCell = NULL;
+	rsa_ctx_t *pCtx = NULL;
+	uint64_t pos = __atomic_load_n(&pPool->takePos, __ATOMIC_RELAXED);
+	uint64_t seq = 0x00u;
+
+	/* Function body */
+	while(1)
+	{
+		pCell = &pPool->pCells[pos & pPool->mask];
+		seq = __atomic_load_n(&pCell->seq, __ATOMIC_ACQUIRE);
+
+		if( (seq == (pos + 0x01u)) )
+		{
+			if( (__atomic_compare_exchange_n(&pPool->takePos, &pos, pos + 0x01u, 0x00u,
+			                                 __ATOMIC_RELAXED, __ATOMIC_RELAXED)) )
+			{ break; }
+			else;
+		}
+		else if( ((int64_t) (seq - (pos + 0x01u)) < 0x00) )
+		{ return NULL; }
+		else
+		{ pos = __atomic_load_n(&pPool->takePos, __ATOMIC_RELAXED); }
+	}
+
+	pCtx = pCell->pCtx;
+	/* The cell is free again for the push one lap later */
+	__atomic_store_n(&pCell->seq, pos + pPool->mask + 0x01u, __ATOMIC_RELEASE);
+	__atomic_fetch_sub(&pPool->ready, 0x01u, __ATOMIC_RELAXED);
+
+	return pCtx;
+}/* poolPop */
+
+/**
+ * @brief Reserves the generation of one key while the planned keys are
+ * 			  below the high watermark.
+ */
+static uint8_t
+poolReserve(st_rsa_pool_t * const pPool)
+{
+	/* Function data types */
+	uint32_t planned = __atomic_load_n(&pPool->planned, __ATOMIC_RELAXED);
+
+	/* Function body */
+	while( (planned < pPool->cfg.highWatermark) )
+	{
+		if( (__atomic_compare_exchange_n(&pPool->planned, &planned, planned + 0x01u, 0x00u,
+		                                 __ATOMIC_RELAXED, __ATOMIC_RELAXED)) )
+		{ return 0x01u; }
+		else;
+	}
+
+	return 0x00u;
+}/* poolReserve */
+
+static void *
+poolGenerator(void *pArg)
+{
+	/* Function data types */
+	st_rsa_pool_t * const pPool = (st_rsa_pool_t *) pArg;
+	rsa_ctx_t *pCtx = NULL;
+	en_rsa_status_t status = rsaStatusOk;
+
+	/* Function body */
+	while( (0x00u == __atomic_load_n(&pPool->stop, __ATOMIC_ACQUIRE)) )
+	{
+		if( (0x00u == poolReserve(pPool)) )
+		{
+			sem_wait(&pPool->refill);
+			continue;
+		}
+		else;
+
+		pCtx = rsa_ctx_create_with(&pPool->allocator);
+		status = (NULL != pCtx) ? (rsa_ctx_set_public_exponent(pCtx, pPool->cfg.publicExponent)) : (rsaStatusNoMemory);
+		if( (rsaStatusOk == status) )
+		{ status = rsa_ctx_set_num_of_primes(pCtx, pPool->cfg.numOfPrimes); }
+		else;
+		/* The generators already run side by side, each key is searched on one thread */
+		if( (rsaStatusOk == status) )
+		{ status = rsa_ctx_set_search_threads(pCtx, 0x01u); }
+		else;
+		if( (rsaStatusOk == status) )
+		{ status = rsa_ctx_generate(pCtx, pPool->cfg.keyBits); }
+		else;
+
+		/* A failed key gives its reservation back and is tried again */
+		if( (rsaStatusOk != status) )
+		{
+			rsa_ctx_destroy(pCtx);
+			__atomic_fetch_sub(&pPool->planned, 0x01u, __ATOMIC_RELAXED);
+			continue;
+		}
+		else;
+
+		poolPush(pPool, pCtx);
+	}
+
+	return NULL;
+}/* poolGenerator */
+
+/*
+*--------------------------------------------------------------------------------------
+*- Public Functions Implementation
+*--------------------------------------------------------------------------------------
+**/
+
+/**
+ * @brief Pool settings for `keyBits` keys, the other fields take the
+ * 			  RSA_POOL_* defaults.
+ */
+rsa_pool_cfg_t
+rsa_pool_cfg_default(const uint32_t keyBits)
+{
+	/* Function data types */
+	rsa_pool_cfg_t cfg;
+
+	/* Function body */
+	memset(&cfg, 0x00u, sizeof(cfg));
+	cfg.keyBits = keyBits;
+	cfg.lowWatermark = RSA_POOL_LOW_WATERMARK;
+	cfg.highWatermark = RSA_POOL_HIGH_WATERMARK;
+	cfg.numOfThreads = RSA_POOL_THREADS;
+	cfg.publicExponent = RSA_PUBLIC_EXPONENT;
+	cfg.numOfPrimes = RSA_NUM_OF_PRIMES;
+	cfg.pAllocator = NULL;
+
+	return cfg;
+}/* rsa_pool_cfg_default */
+
+/**
+ * @brief Creates a key pool and starts its generators, which fill it up to
+ * 			  the high watermark right away. The allocator (NULL for the default
+ * 				one) serves the pool and every pooled context, it is called from the
+ * 				generator threads so it must be thread safe.
+ * @return NULL on invalid settings or when no generator could be started.
+ */
+rsa_pool_t *
+rsa_pool_create(const rsa_pool_cfg_t * const pCfg)
+{
+	/* Function data types */
+	rsa_allocator_t allocator;
+	st_rsa_pool_t *pPool = NULL;
+	uint32_t numOfCells = 0x01u;
+	uint32_t register i = 0x00u;
+
+	/* Validating */
+	if( (NULL == pCfg) )
+	{ return NULL; }
+	else if( (pCfg->numOfPrimes < 0x02u) || (pCfg->numOfPrimes > RSA_MAX_PRIMES) ||
+	         (pCfg->keyBits < (pCfg->numOfPrimes * 0x08u)) || (pCfg->keyBits > RSA_MAX_KEY_BITS) ||
+	         (0x00u == pCfg->lowWatermark) || (pCfg->lowWatermark > pCfg->highWatermark) ||
+	         (0x00u == pCfg->numOfThreads) || (pCfg->numOfThreads > RSA_POOL_MAX_THREADS) ||
+	         (pCfg->publicExponent < 0x03u) || (0x00u == (pCfg->publicExponent & 0x01u)) )
+	{ return NULL; }
+	else;
+
+	allocator = (NULL != pCfg->pAllocator) ? (*pCfg->pAllocator) : (rsa_allocator_default());
+	if( (NULL == allocator.pfAlloc) || (NULL == allocator.pfFree) )
+	{ return NULL; }
+	else;
+
+	/* Function body */
+	while( (numOfCells < pCfg->highWatermark) )
+	{ numOfCells <<= 0x01u; }
+
+	pPool = (st_rsa_pool_t *) allocator.pfAlloc(allocator.pUser, sizeof(st_rsa_pool_t), RSA_POOL_ALIGN);
+	if( (NULL == pPool) )
+	{ return NULL; }
+	else;
+
+	memset(pPool, 0x00u, sizeof(st_rsa_pool_t));
+	pPool->pCells = (st_rsa_pool_cell_t *) allocator.pfAlloc(allocator.pUser, numOfCells * sizeof(st_rsa_pool_cell_t),
+	                                                          RSA_POOL_ALIGN);
+	if( (NULL == pPool->pCells) )
+	{
+		allocator.pfFree(allocator.pUser, pPool);
+		return NULL;
+	}
+	else;
+
+	for(i = 0x00u; i < numOfCells; ++i)
+	{
+		pPool->pCells[i].seq = i;
+		pPool->pCells[i].pCtx = NULL;
+	}
+
+	pPool->mask = numOfCells - 0x01u;
+	pPool->cfg = *pCfg;
+	pPool->cfg.pAllocator = NULL;
+	pPool->allocator = allocator;
+	sem_init(&pPool->refill, 0x00, 0x00u);
+
+	for(i = 0x00u; i < pCfg->numOfThreads; ++i)
+	{
+		if( (0x00 == pthread_create(&pPool->threads[pPool->numOfThreads], NULL, poolGenerator, pPool)) )
+		{ ++pPool->numOfThreads; }
+		else;
+	}
+
+	if( (0x00u == pPool->numOfThreads) )
+	{
+		rsa_pool_destroy((rsa_pool_t *) pPool);
+		return NULL;
+	}
+	else;
+
+	return (rsa_pool_t *) pPool;
+}/* rsa_pool_create */
+
+/**
+ * @brief Stops the generators, a generator in the middle of a key finishes
+ * 			  it first, then releases the keys left in the pool.
+ */
+void
+rsa_pool_destroy(rsa_pool_t * const pPool)
+{
+	/* Function data types */
+	st_rsa_pool_t * const pState = (st_rsa_pool_t *) pPool;
+	rsa_allocator_t allocator;
+	uint32_t register i = 0x00u;
+
+	/* Function body */
+	if( (NULL == pState) )
+	{ return; }
+	else;
+
+	__atomic_store_n(&pState->stop, 0x01u, __ATOMIC_RELEASE);
+	for(i = 0x00u; i < pState->numOfThreads; ++i)
+	{ sem_post(&pState->refill); }
+
+	for(i = 0x00u; i < pState->numOfThreads; ++i)
+	{ pthread_join(pState->threads[i], NULL); }
+
+	for(i = 0x00u; i <= pState->mask; ++i)
+	{ rsa_ctx_destroy(poolPop(pState)); }
+
+	sem_destroy(&pState->refill);
+
+	allocator = pState->allocator;
+	allocator.pfFree(allocator.pUser, pState->pCells);
+	allocator.pfFree(allocator.pUser, pState);
+}/* rsa_pool_destroy */
+
+/**
+ * @brief Hands over a pre-generated key without blocking, the caller owns
+ * 			  the context and releases it with rsa_ctx_destroy(). Crossing the
+ * 				low watermark wakes the generators.
+ * @return NULL when the pool is empty, the caller may then fall back to
+ * 				 rsa_ctx_generate().
+ */
+rsa_ctx_t *
+rsa_pool_take(rsa_pool_t * const pPool)
+{
+	/* Function data types */
+	st_rsa_pool_t * const pState = (st_rsa_pool_t *) pPool;
+	rsa_ctx_t *pCtx = NULL;
+	uint32_t register i = 0x00u;
+
+	/* Validating */
+	if( (NULL == pState) )
+	{ return NULL; }
+	else;
+
+	/* Function body */
+	pCtx = poolPop(pState);
+	if( (NULL == pCtx) )
+	{ return NULL; }
+	else;
+
+	if( (pState->cfg.lowWatermark == __atomic_fetch_sub(&pState->planned, 0x01u, __ATOMIC_RELAXED)) )
+	{
+		for(i = 0x00u; i < pState->numOfThreads; ++i)
+		{ sem_post(&pState->refill); }
+	}
+	else;
+
+	RSA_TRACE(traceEventPoolTake, __atomic_load_n(&pState->ready, __ATOMIC_RELAXED), 0x00u);
+
+	return pCtx;
+}/* rsa_pool_take */
+
+/**
+ * @brief Keys ready to be taken, a snapshot that can change right away.
+ */
+uint32_t
+rsa_pool_available(const rsa_pool_t * const pPool)
+{
+	return (NULL != pPool) ? (__atomic_load_n(&((const st_rsa_pool_t *) pPool)->ready, __ATOMIC_RELAXED)) : (0x00u);
+}/* rsa_pool_available */
@@ -17,11 +17,20 @@
 #include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
-#include <math.h>
+#include <fcntl.h>
+#include <unistd.h>
 
 #include "rsa_cfg.h"
 #include "rsa_prv.h"
 #include "rsa_int.h"
+#include "rsa_mont.h"
+#include "rsa_bn.h"
+#include "rsa_mb.h"
+#include "rsa_prime.h"
+#include "rsa_arith.h"
+#include "rsa_trace.h"
+#include "rsa_stats.h"
+#include "rsa_sha256.h"
 
 /*
 *--------------------------------------------------------------------------------------
@@ -29,7 +38,10 @@
 *--------------------------------------------------------------------------------------
 **/
 
-
+/** @brief Size of the buffer used to print a multi-precision number in hex */
+#define RSA_HEX_BUFFER_SIZE 			((RSA_MAX_KEY_BITS / 0x04u) + 0x01u)
+/** @brief First line of the key files */
+#define RSA_KEY_FILE_MAGIC 				"rsa-c-lib key v1"
 
 /*
 *--------------------------------------------------------------------------------------
@@ -37,7 +49,12 @@
 *--------------------------------------------------------------------------------------
 **/
 
-static volatile st_rsa_t my_rsa_lib = {0};
+/** @brief DER DigestInfo header of a SHA-256 hash, RFC 8017 section 9.2 */
+static const uint8_t signatureDigestInfo[RSA_SIGNATURE_DIGEST_INFO_BYTES] =
+{
+	0x30u, 0x31u, 0x30u, 0x0Du, 0x06u, 0x09u, 0x60u, 0x86u, 0x48u, 0x01u,
+	0x65u, 0x03u, 0x04u, 0x02u, 0x01u, 0x05u, 0x00u, 0x04u, 0x20u
+};
 
 /*
 *--------------------------------------------------------------------------------------
@@ -45,28 +62,1010 @@ static volatile st_rsa_t my_rsa_lib = {0};
 *--------------------------------------------------------------------------------------
 **/
 
+/**
+ * @brief Allocates an empty key context from the default allocator.
+ * @return NULL when the allocation fails.
+ */
+rsa_ctx_t *
+rsa_ctx_create(void)
+{
+	return rsa_ctx_create_with(NULL);
+}/* rsa_ctx_create */
+
+/**
+ * @brief Allocates an empty key context from `pAllocator` (NULL for the
+ * 			  default one), the context is 64-byte aligned as required by the
+ * 			  multi-precision numbers it holds. The allocator is kept by the
+ * 			  context and used again to release it.
+ * @return NULL when the allocation fails.
+ */
+rsa_ctx_t *
+rsa_ctx_create_with(const rsa_allocator_t * const pAllocator)
+{
+	/* Function data types */
+	const rsa_allocator_t allocator = (NULL != pAllocator) ? (*pAllocator) : (rsa_allocator_default());
+	st_rsa_t *pCtx = NULL;
+
+	/* Validating */
+	if( (NULL == allocator.pfAlloc) || (NULL == allocator.pfFree) )
+	{ return NULL; }
+	else;
+
+	/* Function body */
+	pCtx = (st_rsa_t *) allocator.pfAlloc(allocator.pUser, sizeof(st_rsa_t), __alignof__(st_rsa_t));
+	if( (NULL == pCtx) )
+	{ return NULL; }
+	else;
+
+	memset(pCtx, 0x00u, sizeof(st_rsa_t));
+	pCtx->allocator = allocator;
+	pCtx->publicExponent = RSA_PUBLIC_EXPONENT;
+	pCtx->numOfPrimes = RSA_NUM_OF_PRIMES;
+	pCtx->searchThreads = RSA_PRIME_SEARCH_THREADS;
+
+	return (rsa_ctx_t *) pCtx;
+}/* rsa_ctx_create_with */
+
+/**
+ * @brief Wipes the key material before releasing the context.
+ */
+void
+rsa_ctx_destroy(rsa_ctx_t * const pCtx)
+{
+	/* Function data types */
+	volatile uint8_t *pBytes = (volatile uint8_t *) pCtx;
+	rsa_allocator_t allocator;
+	uint64_t register i = 0x00u;
+
+	/* Function body */
+	if( (NULL == pCtx) )
+	{ return; }
+	else;
+
+	rsa_ctx_disable_byte_table(pCtx);
+	allocator = pCtx->allocator;
+
+	for(i = 0x00u; i < sizeof(st_rsa_t); ++i)
+	{ pBytes[i] = 0x00u; }
+
+	allocator.pfFree(allocator.pUser, pCtx);
+}/* rsa_ctx_destroy */
+
+/**
+ * @brief Sets the public exponent of the keys generated into the context
+ * 			  from now on, the current key is kept.
+ */
+en_rsa_status_t
+rsa_ctx_set_public_exponent(rsa_ctx_t * const pCtx, const uint64_t e)
+{
+	/* Validating */
+	if( (NULL == pCtx) )
+	{ return rsaStatusNullArgument; }
+	else if( (e < 0x03u) || (0x00u == (e & 0x01u)) )
+	{ return rsaStatusInvalidArgument; }
+	else;
+
+	/* Function body */
+	pCtx->publicExponent = e;
+
+	return rsaStatusOk;
+}/* rsa_ctx_set_public_exponent */
+
+/**
+ * @brief Sets the number of primes, 2 to RSA_MAX_PRIMES, of the keys
+ * 			  generated into the context from now on, the current key is kept.
+ */
+en_rsa_status_t
+rsa_ctx_set_num_of_primes(rsa_ctx_t * const pCtx, const uint32_t numOfPrimes)
+{
+	/* Validating */
+	if( (NULL == pCtx) )
+	{ return rsaStatusNullArgument; }
+	else if( (numOfPrimes < 0x02u) || (numOfPrimes > RSA_MAX_PRIMES) )
+	{ return rsaStatusInvalidArgument; }
+	else;
+
+	/* Function body */
+	pCtx->numOfPrimes = numOfPrimes;
+
+	return rsaStatusOk;
+}/* rsa_ctx_set_num_of_primes */
+
+/**
+ * @brief Sets the number of threads, up to RSA_PRIME_MAX_THREADS, searching
+ * 			  the primes of the keys generated into the context from now on.
+ * 				0 uses every online core and 1 keeps the search on the caller thread.
+ */
+en_rsa_status_t
+rsa_ctx_set_search_threads(rsa_ctx_t * const pCtx, const uint32_t numOfThreads)
+{
+	/* Validating */
+	if( (NULL == pCtx) )
+	{ return rsaStatusNullArgument; }
+	else if( (numOfThreads > RSA_PRIME_MAX_THREADS) )
+	{ return rsaStatusInvalidArgument; }
+	else;
+
+	/* Function body */
+	pCtx->searchThreads = numOfThreads;
+
+	return rsaStatusOk;
+}/* rsa_ctx_set_search_threads */
+
+/**
+ * @brief Generates a fresh key pair of `keyBits` bits into the context,
+ * 			  any previous key is overwritten. The key has the number of primes
+ * 				set by rsa_ctx_set_num_of_primes(), each of at least 8 bits.
+ */
+en_rsa_status_t
+rsa_ctx_generate(rsa_ctx_t * const pCtx, const uint32_t keyBits)
+{
+	/* Function data types */
+	st_rsa_bn_t primeNumbers[RSA_MAX_PRIMES];
+	const uint64_t startNs = RSA_STATS_TIME_NS();
+	uint8_t inverseStatus = 0x00u;
+
+	/* Validating */
+	if( (NULL == pCtx) )
+	{ return rsaStatusNullArgument; }
+	else if( (keyBits < (pCtx->numOfPrimes * 0x08u)) || (keyBits > RSA_MAX_KEY_BITS) )
+	{ return rsaStatusInvalidKeySize; }
+	else;
+
+	/* Function body */
+	pCtx->keyReady = 0x00u;
+	rsa_ctx_disable_byte_table(pCtx);
+
+	/* Primes making phi share a factor with the public exponent are dropped */
+	do
+	{ getKeyPrimeNumbers(primeNumbers, keyBits, pCtx->numOfPrimes, pCtx->searchThreads); }
+	while( (0x00u == getPublicKeyParams(pCtx, primeNumbers, pCtx->numOfPrimes)) );
+
+	inverseStatus = getPrivateKeyParams(pCtx, primeNumbers, pCtx->numOfPrimes);
+
+	if( (0x01u != inverseStatus) )
+	{ return rsaStatusKeyFailure; }
+	else;
+
+	pCtx->keyReady = 0x01u;
+	statsRecordKeygen(startNs);
+
+	return rsaStatusOk;
+}/* rsa_ctx_generate */
+
+/**
+ * @brief Size in bytes of the ciphertext of a `msgLen` bytes message,
+ * 			  0 when the context holds no key.
+ */
+uint64_t
+rsa_ctx_cipher_size(const rsa_ctx_t * const pCtx, const uint64_t msgLen)
+{
+	return ( (NULL != pCtx) && (pCtx->keyReady) ) ? (msgLen * pCtx->pub.modulusBytes) : (0x00u);
+}/* rsa_ctx_cipher_size */
+
+/**
+ * @brief Encrypts `msgLen` bytes into pCipher, which must hold
+ * 			  rsa_ctx_cipher_size() bytes.
+ */
+en_rsa_status_t
+rsa_ctx_encrypt(const rsa_ctx_t * const pCtx, const uint8_t * const pMsg,
+                const uint64_t msgLen, uint8_t * const pCipher)
+{
+	/* Validating */
+	if( (NULL == pCtx) || (NULL == pMsg) || (NULL == pCipher) )
+	{ return rsaStatusNullArgument; }
+	else if( (0x00u == pCtx->keyReady) )
+	{ return rsaStatusNoKey; }
+	else;
+
+	/* Function body */
+	if( (NULL != pCtx->pByteTable) )
+	{ byteTableEncoder(pCtx, pMsg, msgLen, pCipher); }
+	else
+	{ stringEncoder(&pCtx->pub, pMsg, msgLen, pCipher); }
+
+	return rsaStatusOk;
+}/* rsa_ctx_encrypt */
+
+/**
+ * @brief Decrypts the ciphertext of a `msgLen` bytes message into pMsg.
+ * @return rsaStatusInvalidCipher when a block is not below n or doesn't
+ * 				 decrypt to a byte, pMsg is then left partly written.
+ */
+en_rsa_status_t
+rsa_ctx_decrypt(const rsa_ctx_t * const pCtx, const uint8_t * const pCipher,
+                const uint64_t msgLen, uint8_t * const pMsg)
+{
+	/* Function data types */
+	uint8_t status = 0x00u;
+
+	/* Validating */
+	if( (NULL == pCtx) || (NULL == pCipher) || (NULL == pMsg) )
+	{ return rsaStatusNullArgument; }
+	else if( (0x00u == pCtx->keyReady) )
+	{ return rsaStatusNoKey; }
+	else;
+
+	/* Function body */
+	if( (NULL != pCtx->pByteTable) )
+	{ status = byteTableDecoder(pCtx, pCipher, msgLen, pMsg); }
+	else
+	{ status = stringDecoder(pCtx, pCipher, msgLen, pMsg); }
+
+	if( (0x00u == status) )
+	{ return rsaStatusInvalidCipher; }
+	else;
+
+	return rsaStatusOk;
+}/* rsa_ctx_decrypt */
+
+/**
+ * @brief Encrypts `numOfMsgs` independent messages, message i is encrypted
+ * 			  into ppCiphers[i] which must hold rsa_ctx_cipher_size(pMsgLens[i]).
+ * 				The bytes of all the messages are encrypted RSA_MB_LANES at a time,
+ * 				one per SIMD lane, when the CPU supports the multi-buffer kernels,
+ * 				or copied from the byte table when the context has one.
+ */
+en_rsa_status_t
+rsa_ctx_encrypt_batch(const rsa_ctx_t * const pCtx, const uint8_t * const * const ppMsgs,
+                      const uint64_t * const pMsgLens, const uint32_t numOfMsgs,
+                      uint8_t * const * const ppCiphers)
+{
+	/* Function data types */
+	st_rsa_bn_t bases[RSA_MB_LANES];
+	st_rsa_bn_t results[RSA_MB_LANES];
+	uint8_t *pLaneCipher[RSA_MB_LANES];
+	uint32_t lanes = 0x00u;
+	uint32_t register i = 0x00u;
+	uint32_t register lane = 0x00u;
+	uint64_t register j = 0x00u;
+
+	/* Validating */
+	if( (NULL == pCtx) || (NULL == ppMsgs) || (NULL == pMsgLens) || (NULL == ppCiphers) )
+	{ return rsaStatusNullArgument; }
+	else if( (0x00u == pCtx->keyReady) )
+	{ return rsaStatusNoKey; }
+	else;
+
+	for(i = 0x00u; i < numOfMsgs; ++i)
+	{
+		if( ((NULL == ppMsgs[i]) || (NULL == ppCiphers[i])) && (pMsgLens[i] > 0x00u) )
+		{ return rsaStatusNullArgument; }
+		else;
+	}
+
+	/* Function body */
+	if( (NULL != pCtx->pByteTable) )
+	{
+		for(i = 0x00u; i < numOfMsgs; ++i)
+		{ byteTableEncoder(pCtx, ppMsgs[i], pMsgLens[i], ppCiphers[i]); }
+
+		return rsaStatusOk;
+	}
+	else;
+
+	/* Single word moduli already run on the 64-bit montgomery fast path */
+	if( (0x01u == pCtx->math_parameters.n.used) || (0x00u == mbIsAvailable()) )
+	{
+		for(i = 0x00u; i < numOfMsgs; ++i)
+		{ stringEncoder(&pCtx->pub, ppMsgs[i], pMsgLens[i], ppCiphers[i]); }
+
+		return rsaStatusOk;
+	}
+	else;
+
+	/* The bytes of every message are gathered into the lanes as one stream */
+	for(i = 0x00u; i < numOfMsgs; ++i)
+	{
+		RSA_STATS_ADD(bytesEncrypted, pMsgLens[i]);
+		for(j = 0x00u; j < pMsgLens[i]; ++j)
+		{
+			bnFromWord(&bases[lanes], ppMsgs[i][j]);
+			pLaneCipher[lanes] = ppCiphers[i] + (j * pCtx->pub.modulusBytes);
+
+			if( (++lanes == RSA_MB_LANES) )
+			{
+				mbPowMod(&pCtx->mbN, results, bases, &pCtx->pub.e);
+				for(lane = 0x00u; lane < RSA_MB_LANES; ++lane)
+				{ bnToBytes(pLaneCipher[lane], pCtx->pub.modulusBytes, &results[lane]); }
+				lanes = 0x00u;
+			}
+			else;
+		}
+	}
+
+	/* Tail, a single byte is cheaper on the scalar engine, otherwise the idle
+	 * lanes are fed with zero and their results dropped */
+	if( (0x01u == lanes) )
+	{ pubkeyEncrypter(&pCtx->pub, (uint8_t) bases[0].limbs[0], pLaneCipher[0]); }
+	else if( (lanes > 0x01u) )
+	{
+		for(lane = lanes; lane < RSA_MB_LANES; ++lane)
+		{ bnZero(&bases[lane]); }
+
+		mbPowMod(&pCtx->mbN, results, bases, &pCtx->pub.e);
+		for(lane = 0x00u; lane < lanes; ++lane)
+		{ bnToBytes(pLaneCipher[lane], pCtx->pub.modulusBytes, &results[lane]); }
+	}
+	else;
+
+	return rsaStatusOk;
+}/* rsa_ctx_encrypt_batch */
+
+/**
+ * @brief Precomputes the ciphertexts of the 256 byte values under the current
+ * 			  key, rsa_ctx_encrypt(), rsa_ctx_encrypt_batch() and rsa_ctx_decrypt()
+ * 				then copy and look up whole blocks instead of running one
+ * 				exponentiation per byte. The table takes 256 blocks of the modulus
+ * 				size from the context allocator and is dropped by the next key
+ * 				generated or loaded into the context.
+ */
+en_rsa_status_t
+rsa_ctx_enable_byte_table(rsa_ctx_t * const pCtx)
+{
+	/* Function data types */
+	uint8_t values[RSA_BYTE_TABLE_ENTRIES];
+	const uint8_t *pValues = values;
+	const uint64_t valuesLen = RSA_BYTE_TABLE_ENTRIES;
+	rsa_allocator_t allocator;
+	st_rsa_byte_table_t *pTable = NULL;
+	uint32_t blockLen = 0x00u;
+	uint32_t slot = 0x00u;
+	uint32_t register i = 0x00u;
+
+	/* Validating */
+	if( (NULL == pCtx) )
+	{ return rsaStatusNullArgument; }
+	else if( (0x00u == pCtx->keyReady) )
+	{ return rsaStatusNoKey; }
+	else if( (NULL != pCtx->pByteTable) )
+	{ return rsaStatusOk; }
+	else;
+
+	/* Function body */
+	blockLen = pCtx->pub.modulusBytes;
+	allocator = getCtxAllocator(pCtx);
+	pTable = (st_rsa_byte_table_t *) allocator.pfAlloc(allocator.pUser,
+	                                                    sizeof(st_rsa_byte_table_t) + (RSA_BYTE_TABLE_ENTRIES * blockLen),
+	                                                    __alignof__(st_rsa_byte_table_t));
+	if( (NULL == pTable) )
+	{ return rsaStatusNoMemory; }
+	else;
+
+	memset(pTable->index, 0x00u, sizeof(pTable->index));
+	pTable->pBlocks = (uint8_t *) (pTable + 0x01u);
+
+	/* The 256 values are encrypted as one message on the batch engine */
+	for(i = 0x00u; i < RSA_BYTE_TABLE_ENTRIES; ++i)
+	{ values[i] = (uint8_t) i; }
+	(void) rsa_ctx_encrypt_batch(pCtx, &pValues, &valuesLen, 0x01u, &pTable->pBlocks);
+
+	/* n is above 255 and the key permutes [0, n), so the blocks are distinct */
+	for(i = 0x00u; i < RSA_BYTE_TABLE_ENTRIES; ++i)
+	{
+		slot = byteTableSlot(pTable->pBlocks + (i * blockLen), blockLen);
+		while( (0x00u != pTable->index[slot]) )
+		{ slot = (slot + 0x01u) & (RSA_BYTE_TABLE_SLOTS - 0x01u); }
+
+		pTable->index[slot] = (uint16_t) (i + 0x01u);
+	}
+
+	pCtx->pByteTable = pTable;
+
+	return rsaStatusOk;
+}/* rsa_ctx_enable_byte_table */
+
+/**
+ * @brief Releases the byte table of the context, the byte-wise format goes
+ * 			  back to one exponentiation per byte.
+ */
+void
+rsa_ctx_disable_byte_table(rsa_ctx_t * const pCtx)
+{
+	/* Function data types */
+	rsa_allocator_t allocator;
+
+	/* Validating */
+	if( (NULL == pCtx) || (NULL == pCtx->pByteTable) )
+	{ return; }
+	else;
+
+	/* Function body */
+	allocator = getCtxAllocator(pCtx);
+	allocator.pfFree(allocator.pUser, pCtx->pByteTable);
+	pCtx->pByteTable = NULL;
+}/* rsa_ctx_disable_byte_table */
+
+/**
+ * @brief Writes the key to a text file, the primes and e are stored in hex
+ * 			  and everything else is derived again by rsa_ctx_load(). The primes
+ * 				past p and q of a multi-prime key follow in `r` lines. The file
+ * 				carries the private key and is created readable by its owner only.
+ */
+en_rsa_status_t
+rsa_ctx_save(const rsa_ctx_t * const pCtx, const char * const pPath)
+{
+	/* Function data types */
+	char hexBuffer[RSA_HEX_BUFFER_SIZE];
+	FILE *pFile = NULL;
+	int written = 0;
+	int fd = -1;
+	uint32_t register i = 0x00u;
+
+	/* Validating */
+	if( (NULL == pCtx) || (NULL == pPath) )
+	{ return rsaStatusNullArgument; }
+	else if( (0x00u == pCtx->keyReady) )
+	{ return rsaStatusNoKey; }
+	else;
+
+	/* Function body */
+	fd = open(pPath, O_WRONLY | O_CREAT | O_TRUNC, 0600);
+	pFile = (fd >= 0) ? (fdopen(fd, "w")) : (NULL);
+	if( (NULL == pFile) )
+	{
+		if( (fd >= 0) )
+		{ close(fd); }
+		else;
+
+		return rsaStatusIoError;
+	}
+	else;
+
+	written = fprintf(pFile, "%s\nbits %u\n", RSA_KEY_FILE_MAGIC, bnBitLength(&pCtx->math_parameters.n));
+	bnToHex(hexBuffer, RSA_HEX_BUFFER_SIZE, &pCtx->pub.e);
+	written = (written > 0) ? fprintf(pFile, "e %s\n", hexBuffer) : (written);
+	bnToHex(hexBuffer, RSA_HEX_BUFFER_SIZE, &pCtx->crt_parameters.p);
+	written = (written > 0) ? fprintf(pFile, "p %s\n", hexBuffer) : (written);
+	bnToHex(hexBuffer, RSA_HEX_BUFFER_SIZE, &pCtx->crt_parameters.q);
+	written = (written > 0) ? fprintf(pFile, "q %s\n", hexBuffer) : (written);
+	for(i = 0x02u; i < pCtx->crt_parameters.numOfPrimes; ++i)
+	{
+		bnToHex(hexBuffer, RSA_HEX_BUFFER_SIZE, &pCtx->crt_parameters.others[i - 0x02u].r);
+		written = (written > 0) ? fprintf(pFile, "r %s\n", hexBuffer) : (written);
+	}
+
+	if( (0x00 != fclose(pFile)) || (written <= 0) )
+	{ return rsaStatusIoError; }
+	else;
+
+	return rsaStatusOk;
+}/* rsa_ctx_save */
+
+/**
+ * @brief Loads a key written by rsa_ctx_save() into the context.
+ * @return rsaStatusInvalidKeyFile when a field is missing or a factor isn't prime.
+ */
+en_rsa_status_t
+rsa_ctx_load(rsa_ctx_t * const pCtx, const char * const pPath)
+{
+	/* Function data types */
+	char line[RSA_HEX_BUFFER_SIZE + 0x10u];
+	st_rsa_bn_t primeNumbers[RSA_MAX_PRIMES];
+	st_rsa_bn_t e;
+	uint8_t fields = 0x00u;
+	uint32_t numOfPrimes = 0x02u;
+	uint32_t keyBits = 0x00u;
+	FILE *pFile = NULL;
+	uint32_t register i = 0x00u;
+
+	/* Validating */
+	if( (NULL == pCtx) || (NULL == pPath) )
+	{ return rsaStatusNullArgument; }
+	else;
+
+	/* Function body */
+	pFile = fopen(pPath, "r");
+	if( (NULL == pFile) )
+	{ return rsaStatusIoError; }
+	else;
+
+	pCtx->keyReady = 0x00u;
+	rsa_ctx_disable_byte_table(pCtx);
+
+	if( (NULL == fgets(line, sizeof(line), pFile)) || (0x00 != strncmp(line, RSA_KEY_FILE_MAGIC, strlen(RSA_KEY_FILE_MAGIC))) )
+	{ fclose(pFile); return rsaStatusInvalidKeyFile; }
+	else;
+
+	while( (NULL != fgets(line, sizeof(line), pFile)) )
+	{
+		if( (0x00 == strncmp(line, "e ", 0x02u)) )
+		{ fields |= (bnFromHex(&e, line + 0x02u)) ? (0x01u) : (0x00u); }
+		else if( (0x00 == strncmp(line, "p ", 0x02u)) )
+		{ fields |= (bnFromHex(&primeNumbers[0], line + 0x02u)) ? (0x02u) : (0x00u); }
+		else if( (0x00 == strncmp(line, "q ", 0x02u)) )
+		{ fields |= (bnFromHex(&primeNumbers[1], line + 0x02u)) ? (0x04u) : (0x00u); }
+		else if( (0x00 == strncmp(line, "r ", 0x02u)) )
+		{
+			/* A prime past RSA_MAX_PRIMES leaves its bit set */
+			if( (numOfPrimes < RSA_MAX_PRIMES) && (bnFromHex(&primeNumbers[numOfPrimes], line + 0x02u)) )
+			{ ++numOfPrimes; }
+			else
+			{ fields |= 0x08u; }
+		}
+		else;
+	}
+	fclose(pFile);
+
+	if( (0x07u != fields) || (bnBitLength(&e) < 0x02u) )
+	{ return rsaStatusInvalidKeyFile; }
+	else;
+
+	/* A composite factor would only surface later as a decryption or signing failure */
+	for(i = 0x00u; i < numOfPrimes; ++i)
+	{
+		if( (0x00u == (primeNumbers[i].limbs[0] & 0x01u)) || (bnIsWord(&primeNumbers[i], 0x01u)) ||
+		    (numberIsPrime != testPrimeCandidate(&primeNumbers[i])) )
+		{ return rsaStatusInvalidKeyFile; }
+		else;
+
+		keyBits += bnBitLength(&primeNumbers[i]);
+	}
+
+	if( (keyBits > RSA_MAX_KEY_BITS) )
+	{ return rsaStatusInvalidKeyFile; }
+	else;
+
+	setKeyParams(pCtx, primeNumbers, numOfPrimes, &e);
+
+	if( (0x01u != getPrivateKeyParams(pCtx, primeNumbers, numOfPrimes)) )
+	{ return rsaStatusInvalidKeyFile; }
+	else;
+
+	pCtx->keyReady = 0x01u;
+
+	return rsaStatusOk;
+}/* rsa_ctx_load */
+
+/**
+ * @brief Size in bytes of the block mode ciphertext of a `msgLen` bytes
+ * 			  message, 0 when the context holds no key or the key is too small
+ * 				to carry a payload.
+ */
+uint64_t
+rsa_ctx_block_cipher_size(const rsa_ctx_t * const pCtx, const uint64_t msgLen)
+{
+	return ( (NULL != pCtx) && (pCtx->keyReady) ) ? (blockCipherSize(&pCtx->pub, msgLen)) : (0x00u);
+}/* rsa_ctx_block_cipher_size */
+
+/**
+ * @brief Packs the message into blocks of up to k - 3 bytes, pCipher must
+ * 			  hold rsa_ctx_block_cipher_size() bytes.
+ */
+en_rsa_status_t
+rsa_ctx_encrypt_blocks(const rsa_ctx_t * const pCtx, const uint8_t * const pMsg,
+                       const uint64_t msgLen, uint8_t * const pCipher)
+{
+	/* Validating */
+	if( (NULL == pCtx) || ((NULL == pMsg) && (msgLen > 0x00u)) || (NULL == pCipher) )
+	{ return rsaStatusNullArgument; }
+	else if( (0x00u == pCtx->keyReady) )
+	{ return rsaStatusNoKey; }
+	else if( (pCtx->pub.modulusBytes <= (RSA_BLOCK_HEADER_BYTES + 0x01u)) )
+	{ return rsaStatusInvalidKeySize; }
+	else;
+
+	/* Function body */
+	blockEncoder(&pCtx->pub, pMsg, msgLen, pCipher);
+
+	return rsaStatusOk;
+}/* rsa_ctx_encrypt_blocks */
+
+/**
+ * @brief Decrypts block mode ciphertext, pMsg must hold `cipherLen` bytes
+ * 			  and the message length is returned through pMsgLen.
+ */
+en_rsa_status_t
+rsa_ctx_decrypt_blocks(const rsa_ctx_t * const pCtx, const uint8_t * const pCipher,
+                       const uint64_t cipherLen, uint8_t * const pMsg, uint64_t * const pMsgLen)
+{
+	/* Function data types */
+	uint8_t block[RSA_MAX_KEY_BITS / 0x08u];
+	uint64_t offset = 0x00u;
+	uint64_t msgLen = 0x00u;
+	uint32_t payloadLen = 0x00u;
+
+	/* Validating */
+	if( (NULL == pCtx) || ((NULL == pCipher) && (cipherLen > 0x00u)) || (NULL == pMsg) || (NULL == pMsgLen) )
+	{ return rsaStatusNullArgument; }
+	else if( (0x00u == pCtx->keyReady) )
+	{ return rsaStatusNoKey; }
+	else if( (pCtx->pub.modulusBytes <= (RSA_BLOCK_HEADER_BYTES + 0x01u)) )
+	{ return rsaStatusInvalidKeySize; }
+	else if( (0x00u != (cipherLen % pCtx->pub.modulusBytes)) )
+	{ return rsaStatusInvalidCipher; }
+	else;
+
+	/* Function body */
+	*pMsgLen = 0x00u;
+
+	for(offset = 0x00u; offset < cipherLen; offset += pCtx->pub.modulusBytes)
+	{
+		if( (0x00u == privkeyBlockDecrypter(pCtx, pCipher + offset, block)) )
+		{
+			RSA_TRACE(traceEventBlockDecrypt, cipherLen, rsaStatusInvalidCipher);
+			return rsaStatusInvalidCipher;
+		}
+		else;
+
+		payloadLen = ((uint32_t) block[0] << 0x08u) | block[1];
+		if( (payloadLen > (pCtx->pub.modulusBytes - RSA_BLOCK_HEADER_BYTES - 0x01u)) )
+		{
+			RSA_TRACE(traceEventBlockDecrypt, cipherLen, rsaStatusInvalidCipher);
+			return rsaStatusInvalidCipher;
+		}
+		else;
+
+		memcpy(pMsg + msgLen, block + RSA_BLOCK_HEADER_BYTES, payloadLen);
+		msgLen += payloadLen;
+	}
+
+	*pMsgLen = msgLen;
+
+	RSA_TRACE(traceEventBlockDecrypt, cipherLen, rsaStatusOk);
+	RSA_STATS_ADD(bytesDecrypted, msgLen);
+
+	return rsaStatusOk;
+}/* rsa_ctx_decrypt_blocks */
+
+/**
+ * @brief Copies the public half of the context key into a handle allocated
+ * 			  from the context allocator. The handle holds n, e and their
+ * 				precomputation, it outlives the context and encrypts without it.
+ * @return NULL when the context holds no key or the allocation fails.
+ */
+rsa_pubkey_t *
+rsa_pubkey_create(const rsa_ctx_t * const pCtx)
+{
+	/* Function data types */
+	st_rsa_pubkey_t *pKey = NULL;
+	rsa_allocator_t allocator;
+
+	/* Validating */
+	if( (NULL == pCtx) || (0x00u == pCtx->keyReady) )
+	{ return NULL; }
+	else;
+
+	/* Function body */
+	allocator = getCtxAllocator(pCtx);
+	pKey = (st_rsa_pubkey_t *) allocator.pfAlloc(allocator.pUser, sizeof(st_rsa_pubkey_t),
+	                                             __alignof__(st_rsa_pubkey_t));
+	if( (NULL == pKey) )
+	{ return NULL; }
+	else;
+
+	pKey->pub = pCtx->pub;
+	pKey->mbN = pCtx->mbN;
+	pKey->allocator = allocator;
+
+	return (rsa_pubkey_t *) pKey;
+}/* rsa_pubkey_create */
+
+void
+rsa_pubkey_destroy(rsa_pubkey_t * const pKey)
+{
+	/* Validating */
+	if( (NULL == pKey) )
+	{ return; }
+	else;
+
+	/* Function body */
+	pKey->allocator.pfFree(pKey->allocator.pUser, pKey);
+}/* rsa_pubkey_destroy */
+
+/**
+ * @brief Same as rsa_ctx_block_cipher_size() for the key of the handle.
+ */
+uint64_t
+rsa_pubkey_block_cipher_size(const rsa_pubkey_t * const pKey, const uint64_t msgLen)
+{
+	return (NULL != pKey) ? (blockCipherSize(&pKey->pub, msgLen)) : (0x00u);
+}/* rsa_pubkey_block_cipher_size */
+
+/**
+ * @brief Block mode encryption under the handle key, the ciphertext is the
+ * 			  one rsa_ctx_encrypt_blocks() produces and the key context decrypts it.
+ */
+en_rsa_status_t
+rsa_pubkey_encrypt_blocks(const rsa_pubkey_t * const pKey, const uint8_t * const pMsg,
+                          const uint64_t msgLen, uint8_t * const pCipher)
+{
+	/* Validating */
+	if( (NULL == pKey) || ((NULL == pMsg) && (msgLen > 0x00u)) || (NULL == pCipher) )
+	{ return rsaStatusNullArgument; }
+	else if( (pKey->pub.modulusBytes <= (RSA_BLOCK_HEADER_BYTES + 0x01u)) )
+	{ return rsaStatusInvalidKeySize; }
+	else;
+
+	/* Function body */
+	blockEncoder(&pKey->pub, pMsg, msgLen, pCipher);
+
+	return rsaStatusOk;
+}/* rsa_pubkey_encrypt_blocks */
+
+/**
+ * @brief Size in bytes of the signatures of the context key, 0 when the
+ * 			  context holds no key or the key is too small to sign.
+ */
+uint64_t
+rsa_ctx_signature_size(const rsa_ctx_t * const pCtx)
+{
+	/* Validating */
+	if( (NULL == pCtx) || (0x00u == pCtx->keyReady) || (pCtx->pub.modulusBytes < RSA_SIGNATURE_MIN_BYTES) )
+	{ return 0x00u; }
+	else;
+
+	/* Function body */
+	return pCtx->pub.modulusBytes;
+}/* rsa_ctx_signature_size */
+
+/**
+ * @brief Signs the message into pSig, rsa_ctx_signature_size() bytes.
+ * 				The CRT result is opened again with e before it is released, a
+ * 				faulty exponentiation would otherwise leak a factor of n.
+ * @return rsaStatusKeyFailure when the check fails, pSig is left untouched.
+ */
+en_rsa_status_t
+rsa_ctx_sign(const rsa_ctx_t * const pCtx, const uint8_t * const pMsg,
+             const uint64_t msgLen, uint8_t * const pSig)
+{
+	/* Function data types */
+	uint8_t encoded[RSA_MAX_KEY_BITS / 0x08u];
+	st_rsa_bn_t message;
+	st_rsa_bn_t signature;
+	st_rsa_bn_t opened;
+
+	/* Validating */
+	if( (NULL == pCtx) || ((NULL == pMsg) && (msgLen > 0x00u)) || (NULL == pSig) )
+	{ return rsaStatusNullArgument; }
+	else if( (0x00u == pCtx->keyReady) )
+	{ return rsaStatusNoKey; }
+	else if( (pCtx->pub.modulusBytes < RSA_SIGNATURE_MIN_BYTES) )
+	{ return rsaStatusInvalidKeySize; }
+	else;
+
+	/* Function body */
+	signatureEncoder(pCtx->pub.modulusBytes, pMsg, msgLen, encoded);
+	bnFromBytes(&message, encoded, pCtx->pub.modulusBytes);
+
+	privkeyOperation(pCtx, &signature, &message);
+	bnPowModPlan(&pCtx->pub.montN, &opened, &signature, &pCtx->pub.e, &pCtx->pub.ePlan);
+	if( (0x00u != bnCompare(&opened, &message)) )
+	{ return rsaStatusKeyFailure; }
+	else;
+
+	bnToBytes(pSig, pCtx->pub.modulusBytes, &signature);
+
+	return rsaStatusOk;
+}/* rsa_ctx_sign */
+
+/**
+ * @brief Verifies a rsa_ctx_sign() signature of the message under the
+ * 			  context key.
+ * @return rsaStatusInvalidSignature when the signature doesn't match.
+ */
+en_rsa_status_t
+rsa_ctx_verify(const rsa_ctx_t * const pCtx, const uint8_t * const pMsg,
+               const uint64_t msgLen, const uint8_t * const pSig)
+{
+	/* Validating */
+	if( (NULL == pCtx) || ((NULL == pMsg) && (msgLen > 0x00u)) || (NULL == pSig) )
+	{ return rsaStatusNullArgument; }
+	else if( (0x00u == pCtx->keyReady) )
+	{ return rsaStatusNoKey; }
+	else;
+
+	/* Function body */
+	return pubkeyVerifier(&pCtx->pub, pMsg, msgLen, pSig);
+}/* rsa_ctx_verify */
+
+/**
+ * @brief Same as rsa_ctx_verify() under the key of the handle.
+ */
+en_rsa_status_t
+rsa_pubkey_verify(const rsa_pubkey_t * const pKey, const uint8_t * const pMsg,
+                  const uint64_t msgLen, const uint8_t * const pSig)
+{
+	/* Validating */
+	if( (NULL == pKey) || ((NULL == pMsg) && (msgLen > 0x00u)) || (NULL == pSig) )
+	{ return rsaStatusNullArgument; }
+	else;
+
+	/* Function body */
+	return pubkeyVerifier(&pKey->pub, pMsg, msgLen, pSig);
+}/* rsa_pubkey_verify */
+
+/**
+ * @brief Verifies `numOfItems` signatures, ppSigs[i] signs ppMsgs[i] under
+ * 			  ppKeys[i] and its status is written to pResults[i]. The keys may
+ * 				repeat, within a window of RSA_VERIFY_BATCH_WINDOW items the
+ * 				signatures sharing a handle are opened RSA_MB_LANES at a time when
+ * 				the CPU supports the multi-buffer kernels, so the per key
+ * 				precomputation and the lanes are shared by the whole group.
+ * @return rsaStatusOk when every item verifies, rsaStatusInvalidSignature
+ * 				 otherwise, pResults tells the items apart.
+ */
+en_rsa_status_t
+rsa_pubkey_verify_batch(const rsa_pubkey_t * const * const ppKeys, const uint8_t * const * const ppMsgs,
+                        const uint64_t * const pMsgLens, const uint8_t * const * const ppSigs,
+                        const uint32_t numOfItems, en_rsa_status_t * const pResults)
+{
+	/* Function data types */
+	st_rsa_bn_t bases[RSA_MB_LANES];
+	st_rsa_bn_t results[RSA_MB_LANES];
+	uint32_t laneItems[RSA_MB_LANES];
+	uint8_t pending[RSA_VERIFY_BATCH_WINDOW];
+	const st_rsa_pubkey_t *pKey = NULL;
+	const uint8_t useLanes = mbIsAvailable();
+	en_rsa_status_t status = rsaStatusOk;
+	uint32_t windowStart = 0x00u;
+	uint32_t windowLen = 0x00u;
+	uint32_t lanes = 0x00u;
+	uint32_t item = 0x00u;
+	uint32_t register i = 0x00u;
+	uint32_t register j = 0x00u;
+	uint32_t register lane = 0x00u;
+
+	/* Validating */
+	if( (NULL == ppKeys) || (NULL == ppMsgs) || (NULL == pMsgLens) || (NULL == ppSigs) || (NULL == pResults) )
+	{ return rsaStatusNullArgument; }
+	else;
+
+	/* Function body */
+	for(windowStart = 0x00u; windowStart < numOfItems; windowStart += windowLen)
+	{
+		windowLen = numOfItems - windowStart;
+		if( (windowLen > RSA_VERIFY_BATCH_WINDOW) )
+		{ windowLen = RSA_VERIFY_BATCH_WINDOW; }
+		else;
+
+		/* The items that can't verify are settled before the lanes are grouped */
+		for(i = 0x00u; i < windowLen; ++i)
+		{
+			item = windowStart + i;
+			if( (NULL == ppKeys[item]) || (NULL == ppSigs[item]) || ((NULL == ppMsgs[item]) && (pMsgLens[item] > 0x00u)) )
+			{ pResults[item] = rsaStatusNullArgument; }
+			else
+			{ pResults[item] = signatureLoader(&ppKeys[item]->pub, ppSigs[item], &bases[0]); }
+
+			pending[i] = (rsaStatusOk == pResults[item]) ? (0x01u) : (0x00u);
+		}
+
+		for(i = 0x00u; i < windowLen; ++i)
+		{
+			if( (0x00u == pending[i]) )
+			{ continue; }
+			else;
+
+			/* Gathering the next pending items of the same key */
+			pKey = ppKeys[windowStart + i];
+			lanes = 0x00u;
+			for(j = i; (j < windowLen) && (lanes < RSA_MB_LANES); ++j)
+			{
+				if( (0x01u == pending[j]) && (pKey == ppKeys[windowStart + j]) )
+				{
+					laneItems[lanes++] = windowStart + j;
+					pending[j] = 0x00u;
+				}
+				else;
+			}
+
+			if( (0x00u == useLanes) || (lanes < 0x02u) )
+			{
+				for(lane = 0x00u; lane < lanes; ++lane)
+				{
+					item = laneItems[lane];
+					pResults[item] = pubkeyVerifier(&pKey->pub, ppMsgs[item], pMsgLens[item], ppSigs[item]);
+				}
+			}
+			else
+			{
+				/* The idle lanes are fed with zero and their results dropped */
+				for(lane = 0x00u; lane < RSA_MB_LANES; ++lane)
+				{
+					if( (lane < lanes) )
+					{ bnFromBytes(&bases[lane], ppSigs[laneItems[lane]], pKey->pub.modulusBytes); }
+					else
+					{ bnZero(&bases[lane]); }
+				}
+
+				mbPowMod(&pKey->mbN, results, bases, &pKey->pub.e);
+				for(lane = 0x00u; lane < lanes; ++lane)
+				{
+					item = laneItems[lane];
+					pResults[item] = signatureChecker(&pKey->pub, &results[lane], ppMsgs[item], pMsgLens[item]);
+				}
+			}
+		}
+	}
+
+	for(i = 0x00u; i < numOfItems; ++i)
+	{
+		if( (rsaStatusOk != pResults[i]) )
+		{ status = rsaStatusInvalidSignature; }
+		else;
+	}
+
+	return status;
+}/* rsa_pubkey_verify_batch */
+
+/**
+ * @brief Demo round trip of a string through a RSA_KEY_BITS key.
+ */
 void 
 generate_keys(const uint8_t * const pString)
 {
 	/* Validating */
 #if (FULL_ASSERTION_FLAG == FULL_ASSERTION_ACTIVE)
 	STATIC_ASSERT((pString != NULL), DEFAULT_EXIT_CODE);	
+	STATIC_ASSERT((RSA_KEY_BITS >= 0x10u) && (RSA_KEY_BITS <= RSA_MAX_KEY_BITS), DEFAULT_EXIT_CODE);	
 #endif
 
 	/* Function data types */
-	uint64_t primeNumberA = getPrimeNumber();
-	uint64_t primeNumberB = getPrimeNumber();
+	const uint64_t strLen = strlen((const char *) pString);
+	rsa_ctx_t *pCtx = rsa_ctx_create();
+	uint8_t *encryptedMsg = NULL;
+	uint8_t *decryptedMsg = NULL;
+	uint64_t cipherLen = 0x00u;
+	uint64_t decryptedLen = 0x00u;
+	en_rsa_status_t status = rsaStatusNoMemory;
 
 	/* Function body */
-	getPublicKeyParams(primeNumberA, primeNumberB);
-	getPrivateKeyParams(primeNumberA, primeNumberB);
+	if( (NULL != pCtx) )
+	{ status = rsa_ctx_generate(pCtx, RSA_KEY_BITS); }
+	else;
 
 #if (DEBUGGING_FLAG == DEBUGGING_ACTIVE)
 	win64_dbg_msg("data string: %s", pString);
 #endif
 
-	uint64_t *encryptedMsg = stringEncoder(pString);
+	/**
+	 * @attention The message buffers come from the context allocator, pass an
+	 * 					  arena to rsa_ctx_create_with() to keep the demo off the heap.
+	 */
+	if( (rsaStatusOk == status) )
+	{
+		cipherLen = rsa_ctx_block_cipher_size(pCtx, strLen);
+		encryptedMsg = (uint8_t *) pCtx->allocator.pfAlloc(pCtx->allocator.pUser, cipherLen, 0x01u);
+		decryptedMsg = (uint8_t *) pCtx->allocator.pfAlloc(pCtx->allocator.pUser, cipherLen + 0x01u, 0x01u);
+		status = ( (NULL != encryptedMsg) && (NULL != decryptedMsg) ) ? (rsaStatusOk) : (rsaStatusNoMemory);
+	}
+	else;
+
+	if( (rsaStatusOk == status) )
+	{
+		rsa_ctx_encrypt_blocks(pCtx, pString, strLen, encryptedMsg);
+		status = rsa_ctx_decrypt_blocks(pCtx, encryptedMsg, cipherLen, decryptedMsg, &decryptedLen);
+		decryptedMsg[decryptedLen] = '\0';
+
+#if (DEBUGGING_FLAG == DEBUGGING_ACTIVE)
+		win64_dbg_msg("Encrypted message (%llu blocks): \n", (unsigned long long) (cipherLen / pCtx->pub.modulusBytes));
+		printStrArrHex(encryptedMsg, cipherLen);
+#endif
 
+#if (FULL_ASSERTION_FLAG == FULL_ASSERTION_ACTIVE)
+		STATIC_ASSERT((rsaStatusOk == status) && (decryptedLen == strLen), DEFAULT_EXIT_CODE);
+		STATIC_ASSERT((0x00u == memcmp(decryptedMsg, pString, strLen)), DEFAULT_EXIT_CODE);
+#endif
+
+#if (DEBUGGING_FLAG == DEBUGGING_ACTIVE)
+		win64_dbg_msg("decrypted string: %s", decryptedMsg);
+#endif
+	}
+	else
+	{
+#if (DEBUGGING_FLAG == DEBUGGING_ACTIVE)
+		win64_dbg_msg("generate_keys failed, status: %d", (int) status);
+#endif
+	}
+
+	if( (NULL != pCtx) )
+	{
+		pCtx->allocator.pfFree(pCtx->allocator.pUser, encryptedMsg);
+		pCtx->allocator.pfFree(pCtx->allocator.pUser, decryptedMsg);
+	}
+	else;
+	rsa_ctx_destroy(pCtx);
 }
 
 /*
@@ -75,320 +1074,800 @@ generate_keys(const uint8_t * const pString)
  *--------------------------------------------------------------------------------------
 **/
 
-_STATIC_INLINE uint64_t 
-mulMod(uint64_t a, uint64_t b, const uint64_t mod)
-{
-	uint64_t res = 0, c; // return (a * b) % mod, avoiding overflow errors while doing modular multiplication.
-	for (b %= mod; a; a & 1 ? b >= mod - res ? res -= mod : 0, res += b : 0, a >>= 1, (c = b) >= mod - b ? c -= mod : 0, b += c);
-	return res % mod;
-}/* mulMod */
 
-_STATIC_INLINE uint64_t 
-powMod(uint64_t n, uint64_t exp, const uint64_t mod)
+/**
+ * @brief Primality test of the sieve survivors, primes fitting a single
+ * 			  word use the 64-bit montgomery test.
+ */
+_STATIC_INLINE en_PrimeNumbersStatus_t
+testPrimeCandidate(const st_rsa_bn_t * const pCandidate)
 {
-	uint64_t res = 1; // return (n ^ exp) % mod
-	for (n %= mod; exp; exp & 1 ? res = mulMod(res, n, mod) : 0, n = mulMod(n, n, mod), exp >>= 1);
-	return res;
-}/* powMod */
+	if( (bnBitLength(pCandidate) < RSA_BN_LIMB_BITS) )
+	{ return isPrimeNumber(pCandidate->limbs[0]); }
+	else
+	{ return bnMillerRabin(pCandidate); }
+}/* testPrimeCandidate */
 
 /**
- * @brief Miller-Rabin primality test function (it should be a deterministic version).
- * 			  Using the 'repeated squaring' method the algorithm time complexity
- * 				T = `O(k log^3(n))`; k: number of rounds, n: the passed number.
+ * @brief Generates `numOfPrimes` distinct random primes, pPrimes[i] having
+ * 			  exactly pBits[i] bits with the two top bits set, so the product of
+ * 				two such primes has exactly the sum of their bits. The primes are
+ * 				searched concurrently on `numOfThreads` threads, 0 for every core.
  */
-_STATIC_INLINE en_PrimeNumbersStatus_t
-isPrimeNumber(uint64_t primeNumber)
+_STATIC_INLINE void
+getPrimeNumbers(st_rsa_bn_t * const pPrimes, const uint32_t * const pBits, const uint32_t numOfPrimes,
+                const uint32_t numOfThreads)
 {
 	/* Validating */
 #if (FULL_ASSERTION_FLAG == FULL_ASSERTION_ACTIVE)
-	STATIC_ASSERT((primeNumber > 0x02u), DEFAULT_EXIT_CODE);	
+	STATIC_ASSERT((pPrimes != NULL) && (pBits != NULL), DEFAULT_EXIT_CODE);
 #endif
 	/* Function data types */
-	en_PrimeNumbersStatus_t primeNumberStatus = numberIsPrime;
-	const uint8_t numOfPrimes = 9; 
-	uint8_t PrimeNumbers[] = {2, 3, 5, 7, 11, 13, 17, 19, 23};
-	uint64_t t = 0x00u;
-	uint64_t B = 0x00u;
-	uint32_t register s = 0x00u;
+	st_rsa_prime_stats_t stats = {0};
 
 	/* Function body */
-	if (primeNumber > PrimeNumbers[numOfPrimes - 0x01u]) 
-	{
-		for (t = primeNumber - 1; ~t & 0x01u; t >>= 0x01u, ++s);
-
-		uint64_t register i = 0x00u;
-		for (; i < numOfPrimes && primeNumberStatus; ++i) 
-		{
-			B = powMod(PrimeNumbers[i], t, primeNumber);
-			if (B != 1) 
-			{
-				uint32_t b = s;
-				for (; b-- && (primeNumberStatus = B + 0x01u != primeNumber);)
-				{ B = mulMod(B, B, primeNumber); }
-
-				primeNumberStatus = !primeNumberStatus;
-			}
-			else {;}
-		}
-	}
-	else {;}
+	primeSearch(pPrimes, pBits, numOfPrimes, numOfThreads, testPrimeCandidate, &stats);
 
 #if (DEBUGGING_FLAG == DEBUGGING_ACTIVE)
-	if( (numberIsPrime == primeNumberStatus) )
-	{ win64_dbg_msg("Number `%llu` is prime.", primeNumber); }
-	else
-	{ win64_dbg_msg("Number `%llu` isn't prime.", primeNumber);}
+	win64_dbg_msg("Generated %u primes (candidates: %llu, sieved: %llu, fermat rejected: %llu, mr tested: %llu, windows: %llu)",
+	              numOfPrimes, (unsigned long long) stats.candidates, (unsigned long long) stats.sieved,
+	              (unsigned long long) stats.fermatRejected, (unsigned long long) stats.mrTested,
+	              (unsigned long long) stats.windows);
+#else
+	(void) stats;
 #endif
+}/* getPrimeNumbers */
 
-	return primeNumberStatus; 
-}/* isPrimeNumber */
-
-_STATIC_INLINE uint64_t
-getPrimeNumber(void)
+/**
+ * @brief Generates the `numOfPrimes` distinct primes of a `keyBits` bits
+ * 			  key, the bits are split evenly with the spare ones on the last
+ * 				primes. Past two primes the product may fall a bit short of
+ * 				keyBits, the primes are then drawn again.
+ */
+_STATIC_INLINE void
+getKeyPrimeNumbers(st_rsa_bn_t * const pPrimes, const uint32_t keyBits, const uint32_t numOfPrimes,
+                   const uint32_t numOfThreads)
 {
+	/* Validating */
+#if (FULL_ASSERTION_FLAG == FULL_ASSERTION_ACTIVE)
+	STATIC_ASSERT((numOfPrimes >= 0x02u) && (numOfPrimes <= RSA_MAX_PRIMES), DEFAULT_EXIT_CODE);
+#endif
 	/* Function data types */
-	static uint64_t randNumber = 0xFFFFFFFFFFFFFu;
-	uint64_t primeNumber = 0;
-	en_PrimeNumbersStatus_t numberStatus = numberNotPrime;
+	uint32_t primeBits[RSA_MAX_PRIMES];
+	st_rsa_bn_t n;
+	uint32_t register i = 0x00u;
 
 	/* Function body */
-	/**
-	 * @brief Generating prime numbers using simple checker.
-	 * 
-	 */
-	while(numberNotPrime == numberStatus)
+	for(i = 0x00u; i < numOfPrimes; ++i)
+	{ primeBits[i] = (keyBits / numOfPrimes) + ((i >= (numOfPrimes - (keyBits % numOfPrimes))) ? (0x01u) : (0x00u)); }
+
+	do
 	{
-		numberStatus = isPrimeNumber(randNumber);
+		getPrimeNumbers(pPrimes, primeBits, numOfPrimes, numOfThreads);
 
-		if( (numberNotPrime == numberStatus) )
-		{
-			--randNumber;
-		}	
-		else
-		{
-			primeNumber = randNumber;
-			break;
-		}
+		bnCopy(&n, &pPrimes[0]);
+		for(i = 0x01u; i < numOfPrimes; ++i)
+		{ bnMul(&n, &n, &pPrimes[i]); }
 	}
-	--randNumber;
-
-#if (DEBUGGING_FLAG == DEBUGGING_ACTIVE)
-	win64_dbg_msg("Generated prime: %llu", primeNumber);
-#endif
-
-	return primeNumber;
-}/* getPrimeNumber */
+	while( (bnBitLength(&n) != keyBits) );
+}/* getKeyPrimeNumbers */
 
+/**
+ * @brief Computes phi into the context and picks e for the primes.
+ * @return 0 when the configured e is below phi but not co-prime to it.
+ */
 _STATIC_INLINE uint64_t 
-getEncryptionModulus(const uint64_t PrimeNumberA, 
-                     const uint64_t PrimeNumberB)
+getEncryptionModulus(st_rsa_t * const pCtx, const st_rsa_bn_t * const pPrimes, const uint32_t numOfPrimes)
 {
 	/* Validating */
 #if (FULL_ASSERTION_FLAG == FULL_ASSERTION_ACTIVE)
-	STATIC_ASSERT((PrimeNumberA > 0), DEFAULT_EXIT_CODE);
-	STATIC_ASSERT((PrimeNumberB > 0), DEFAULT_EXIT_CODE);
+	STATIC_ASSERT((pPrimes[0].used > 0) && (pPrimes[1].used > 0), DEFAULT_EXIT_CODE);
 #endif
 	/* Function data types */
 	uint64_t encryptionModulus = 0x00u;
-	uint64_t phi = (PrimeNumberA - 0x01u) * (PrimeNumberB - 0x01u);
-	uint64_t gcd = 0x00u;
+	st_rsa_bn_t phi;
+	st_rsa_bn_t tempA;
+	st_rsa_bn_t gcd;
+	uint32_t register i = 0x00u;
 
 	/* Function body */
+	bnSubWord(&phi, &pPrimes[0], 0x01u);
+	for(i = 0x01u; i < numOfPrimes; ++i)
+	{
+		bnSubWord(&tempA, &pPrimes[i], 0x01u);
+		bnMul(&phi, &phi, &tempA);
+	}
+
 	/**
 	 * @brief Encryption modulus also referred as 'e', it is the modulus needed
-	 * 			  for encrypting and decrypting the message.
+	 * 			  for encrypting and decrypting the message. The configured one is
+	 * 				kept whenever it is below phi, it must then be co-prime to phi or
+	 * 				the primes are rejected.
 	 */
+	bnFromWord(&tempA, pCtx->publicExponent);
+	if( (bnCompare(&tempA, &phi) < 0) )
+	{
+		bnGetGCD(&gcd, &tempA, &phi);
+		encryptionModulus = (bnIsWord(&gcd, 0x01u)) ? (pCtx->publicExponent) : (0x00u);
+		bnCopy(&pCtx->math_parameters.phi, &phi);
+
+		return encryptionModulus;
+	}
+	else;
+
+	/* Keys too small for it use the smallest e co-prime to phi */
 	encryptionModulus = 0x02u;
 	
-	while(encryptionModulus < phi)
+	while( (phi.used > 0x01u) || (encryptionModulus < phi.limbs[0]) )
 	{
 		/**
 		 * @brief The encryption modulus must be co-prime to phi,
 		 * 			  and smaller than phi.
 		 */
-		gcd = getGCD(encryptionModulus, phi);
-		if( (0x01u == gcd) )
+		if( (0x01u == phi.used) )
+		{ bnFromWord(&gcd, getGCD(encryptionModulus, phi.limbs[0])); }
+		else
+		{
+			bnFromWord(&tempA, encryptionModulus);
+			bnGetGCD(&gcd, &tempA, &phi);
+		}
+
+		if( (bnIsWord(&gcd, 0x01u)) )
 		{ break; }
 		else
 		{ ++encryptionModulus; }
 	}
 
-	my_rsa_lib.math_parameters.phi = phi;
+	bnCopy(&pCtx->math_parameters.phi, &phi);
 
 #if (DEBUGGING_FLAG == DEBUGGING_ACTIVE)
 	win64_dbg_msg("Encryption modulus: %llu", encryptionModulus);
 #endif
 
 #if (FULL_ASSERTION_FLAG == FULL_ASSERTION_ACTIVE)
-	STATIC_ASSERT((my_rsa_lib.math_parameters.phi == phi), DEFAULT_EXIT_CODE);
+	STATIC_ASSERT((0x00u == bnCompare(&pCtx->math_parameters.phi, &phi)), DEFAULT_EXIT_CODE);
 #endif
 
 	return encryptionModulus;
 }/* getEncryptionModulus */
 
-_STATIC_INLINE void
-getPublicKeyParams(const uint64_t PrimeNumberA, 
-             			 const uint64_t PrimeNumberB)
+/**
+ * @brief Picks e for the primes and sets the public key parameters.
+ * @return 0 when the configured e isn't co-prime to phi, 1 otherwise.
+ */
+_STATIC_INLINE uint8_t
+getPublicKeyParams(st_rsa_t * const pCtx, const st_rsa_bn_t * const pPrimes, const uint32_t numOfPrimes)
 {
 	/* Validating */
 #if (FULL_ASSERTION_FLAG == FULL_ASSERTION_ACTIVE)
-	STATIC_ASSERT((PrimeNumberA > 0), DEFAULT_EXIT_CODE);
-	STATIC_ASSERT((PrimeNumberB > 0), DEFAULT_EXIT_CODE);
+	STATIC_ASSERT((pPrimes[0].used > 0) && (pPrimes[1].used > 0), DEFAULT_EXIT_CODE);
 #endif
 
-	uint64_t n = PrimeNumberA * PrimeNumberB;
-	uint64_t e = getEncryptionModulus(PrimeNumberA, PrimeNumberB);
+	uint64_t e = getEncryptionModulus(pCtx, pPrimes, numOfPrimes);
+	st_rsa_bn_t encryptionModulus;
+	uint32_t keyBits = 0x00u;
+	uint32_t register i = 0x00u;
+
+	if( (0x00u == e) )
+	{ return 0x00u; }
+	else;
 
-	my_rsa_lib.math_parameters.n = n;
-	my_rsa_lib.math_parameters.e = e;
+	bnFromWord(&encryptionModulus, e);
+	setKeyParams(pCtx, pPrimes, numOfPrimes, &encryptionModulus);
 
 #if (DEBUGGING_FLAG == DEBUGGING_ACTIVE)
-	win64_dbg_msg("n: %llu, e: %llu", n, e);
+	char hexBuffer[RSA_HEX_BUFFER_SIZE];
+	bnToHex(hexBuffer, RSA_HEX_BUFFER_SIZE, &pCtx->math_parameters.n);
+	win64_dbg_msg("n: %s, e: %llu", hexBuffer, e);
 #endif
 
 #if (FULL_ASSERTION_FLAG == FULL_ASSERTION_ACTIVE)
-	STATIC_ASSERT((my_rsa_lib.math_parameters.n == n), DEFAULT_EXIT_CODE);
-	STATIC_ASSERT((my_rsa_lib.math_parameters.e == e), DEFAULT_EXIT_CODE);
+	for(i = 0x00u; i < numOfPrimes; ++i)
+	{ keyBits += bnBitLength(&pPrimes[i]); }
+
+	STATIC_ASSERT((bnBitLength(&pCtx->math_parameters.n) == keyBits), DEFAULT_EXIT_CODE);
+	STATIC_ASSERT((bnIsWord(&pCtx->pub.e, e)), DEFAULT_EXIT_CODE);
+#else
+	(void) keyBits;
+	(void) i;
 #endif
 
+	return 0x01u;
 }/* getPublicKey */
 
-_FORCE_INLINE
-_FORCE_CONST
+/**
+ * @brief Sets n, phi, e and the public contexts from the primes and e,
+ * 			  together with the window layout of e used by every encryption.
+ */
 _STATIC_INLINE void
-getPrivateKeyParams(const uint64_t PrimeNumberA, 
-              			const uint64_t PrimeNumberB)
+setKeyParams(st_rsa_t * const pCtx, const st_rsa_bn_t * const pPrimes,
+             const uint32_t numOfPrimes, const st_rsa_bn_t * const pE)
+{
+	/* Function data types */
+	st_rsa_bn_t tempA;
+	uint32_t register i = 0x00u;
+
+	/* Function body */
+	bnSubWord(&pCtx->math_parameters.phi, &pPrimes[0], 0x01u);
+	bnCopy(&pCtx->math_parameters.n, &pPrimes[0]);
+	for(i = 0x01u; i < numOfPrimes; ++i)
+	{
+		bnSubWord(&tempA, &pPrimes[i], 0x01u);
+		bnMul(&pCtx->math_parameters.phi, &pCtx->math_parameters.phi, &tempA);
+		bnMul(&pCtx->math_parameters.n, &pCtx->math_parameters.n, &pPrimes[i]);
+	}
+
+	bnCopy(&pCtx->pub.e, pE);
+	bnExpPlanInit(&pCtx->pub.ePlan, pE);
+	bnMontInit(&pCtx->pub.montN, &pCtx->math_parameters.n);
+	mbMontInit(&pCtx->mbN, &pCtx->pub.montN);
+	pCtx->pub.modulusBytes = (bnBitLength(&pCtx->math_parameters.n) + 0x07u) / 0x08u;
+}/* setKeyParams */
+
+/**
+ * @brief Derives d and the CRT parameters, d mod (p - 1), d mod (q - 1) and
+ * 			  q^-1 mod p, together with the montgomery contexts of both primes.
+ * 				Every other prime r of a multi-prime key gets d mod (r - 1), the
+ * 				inverse of the product of the primes before it and its context.
+ * @return 1 when all the inverses exist, 0 otherwise.
+ */
+_STATIC_INLINE uint8_t
+getPrivateKeyParams(st_rsa_t * const pCtx, const st_rsa_bn_t * const pPrimes, const uint32_t numOfPrimes)
 {
 	/* Validating */
 #if (FULL_ASSERTION_FLAG == FULL_ASSERTION_ACTIVE)
-	STATIC_ASSERT((PrimeNumberA > 0), DEFAULT_EXIT_CODE);
-	STATIC_ASSERT((PrimeNumberB > 0), DEFAULT_EXIT_CODE);
-	STATIC_ASSERT((my_rsa_lib.math_parameters.phi > 0), DEFAULT_EXIT_CODE);
-	STATIC_ASSERT((my_rsa_lib.math_parameters.e > 0), DEFAULT_EXIT_CODE);
+	STATIC_ASSERT((pPrimes[0].used > 0) && (pPrimes[1].used > 0), DEFAULT_EXIT_CODE);
+	STATIC_ASSERT((numOfPrimes >= 0x02u) && (numOfPrimes <= RSA_MAX_PRIMES), DEFAULT_EXIT_CODE);
+	STATIC_ASSERT((pCtx->math_parameters.phi.used > 0), DEFAULT_EXIT_CODE);
+	STATIC_ASSERT((pCtx->pub.e.used > 0), DEFAULT_EXIT_CODE);
 #endif
 
-	uint64_t k = 0x02u;
-	uint64_t phi = my_rsa_lib.math_parameters.phi;
-	uint64_t e = my_rsa_lib.math_parameters.e;
+	/* Function data types */
+	struct rsa_crt_parameters * const pCrt = &pCtx->crt_parameters;
+	struct rsa_crt_prime *pOther = NULL;
+	st_rsa_bn_t primeMinusOne;
+	st_rsa_bn_t product;
+	uint8_t inverseStatus = 0x00u;
+	uint32_t register i = 0x00u;
+
+	/* Function body */
+	/**
+	 * @brief The private exponent is the inverse of e modulo phi,
+	 * 			  d * e = 1 + k * phi for some k.
+	 */
+	inverseStatus = bnModInverse(&pCtx->math_parameters.d,
+	                             &pCtx->pub.e,
+	                             &pCtx->math_parameters.phi);
+
+	bnCopy(&pCrt->p, &pPrimes[0]);
+	bnCopy(&pCrt->q, &pPrimes[1]);
+
+	bnSubWord(&primeMinusOne, &pPrimes[0], 0x01u);
+	bnMod(&pCrt->dP, &pCtx->math_parameters.d, &primeMinusOne);
+	bnSubWord(&primeMinusOne, &pPrimes[1], 0x01u);
+	bnMod(&pCrt->dQ, &pCtx->math_parameters.d, &primeMinusOne);
+
+	inverseStatus &= bnModInverse(&pCrt->qInv, &pPrimes[1], &pPrimes[0]);
+
+	bnMontInit(&pCrt->montP, &pPrimes[0]);
+	bnMontInit(&pCrt->montQ, &pPrimes[1]);
 
-	uint64_t d = (uint64_t) (( 0x01u + (k * phi)) / (double)e);
-	my_rsa_lib.math_parameters.d = d;
+	bnMul(&product, &pPrimes[0], &pPrimes[1]);
+	for(i = 0x02u; i < numOfPrimes; ++i)
+	{
+		pOther = &pCrt->others[i - 0x02u];
+		bnCopy(&pOther->r, &pPrimes[i]);
+		bnSubWord(&primeMinusOne, &pPrimes[i], 0x01u);
+		bnMod(&pOther->d, &pCtx->math_parameters.d, &primeMinusOne);
+		inverseStatus &= bnModInverse(&pOther->t, &product, &pPrimes[i]);
+		bnMontInit(&pOther->montR, &pPrimes[i]);
+		bnMul(&product, &product, &pPrimes[i]);
+	}
+
+	/* The slots of a previous key with more primes are wiped */
+	if( (numOfPrimes < RSA_MAX_PRIMES) )
+	{ memset(&pCrt->others[numOfPrimes - 0x02u], 0x00u, (RSA_MAX_PRIMES - numOfPrimes) * sizeof(pCrt->others[0])); }
+	else;
+	pCrt->numOfPrimes = numOfPrimes;
 
 #if (DEBUGGING_FLAG == DEBUGGING_ACTIVE)
-	win64_dbg_msg("d: %llu, k: %llu", d, k);
+	win64_dbg_msg("d: %u bits, dP: %u bits, dQ: %u bits, primes: %u", bnBitLength(&pCtx->math_parameters.d),
+	              bnBitLength(&pCrt->dP), bnBitLength(&pCrt->dQ), numOfPrimes);
 #endif
 
-#if (FULL_ASSERTION_FLAG == FULL_ASSERTION_ACTIVE)
-	STATIC_ASSERT((my_rsa_lib.math_parameters.d == d), DEFAULT_EXIT_CODE);
-#endif
+	return inverseStatus;
 }/* getPrivateKey */
 
-_STATIC_INLINE uint64_t
-getGCD(uint64_t numA, uint64_t numB)
+
+/**
+ * @brief Encrypts every byte of the message on its own, each ciphertext is
+ * 			  stored as a fixed width big endian block of `modulusBytes` bytes.
+ */
+_STATIC_INLINE void
+stringEncoder(const st_rsa_pub_t * const pPub, const uint8_t * const pString,
+              const uint64_t strLen, uint8_t * const pEncryptedString)
 {
+	/* Validating */
 #if (FULL_ASSERTION_FLAG == FULL_ASSERTION_ACTIVE)
-	STATIC_ASSERT((numA != 0), DEFAULT_EXIT_CODE);
-	STATIC_ASSERT((numB != 0), DEFAULT_EXIT_CODE);
+	STATIC_ASSERT((pString != NULL), DEFAULT_EXIT_CODE);	
+	STATIC_ASSERT((pEncryptedString != NULL), DEFAULT_EXIT_CODE);	
 #endif
 
 	/* Function data types */
-	uint64_t tempVar = 0x00u;
-	uint64_t tempA = numA;
-	uint64_t tempB = numB;
+	const uint32_t blockLen = pPub->modulusBytes;
+	uint64_t register i = 0x00u;
 
 	/* Function body */
-	while(1)
-	{
-		tempVar = tempA % tempB;
+	for(i = 0x00u; i < strLen; ++i)
+	{ pubkeyEncrypter(pPub, pString[i], pEncryptedString + (i * blockLen)); }
 
-		if( (0x00u == tempVar) )
-		{ break; }
-		else;
+	RSA_STATS_ADD(bytesEncrypted, strLen);
+
+	RSA_TRACE(traceEventEncrypt, strLen, blockLen * strLen);
+}/* stringEncoder */
+
+/**
+ * @brief Encrypts a single letter, the result is written to pCipher as a
+ * 			  `modulusBytes` big endian block.
+ */
+_STATIC_INLINE void
+pubkeyEncrypter(const st_rsa_pub_t * const pPub, const uint8_t Letter, uint8_t * const pCipher)
+{
+	/* Validating */
+#if (FULL_ASSERTION_FLAG == FULL_ASSERTION_ACTIVE)
+	STATIC_ASSERT((pCipher != NULL), DEFAULT_EXIT_CODE);	
+#endif
+
+	st_rsa_bn_t message;
+	st_rsa_bn_t encrypted;
 
-		tempA = tempB;
-		tempB = tempVar;
+	if( (0x01u == pPub->montN.n.used) )
+	{
+		bnFromWord(&encrypted, powMod(Letter, pPub->e.limbs[0], pPub->montN.n.limbs[0]));
+	}
+	else
+	{
+		bnFromWord(&message, Letter);
+		bnPowModPlan(&pPub->montN, &encrypted, &message, &pPub->e, &pPub->ePlan);
 	}
 
-#if (DEBUGGING_FLAG == DEBUGGING_ACTIVE)
-	win64_dbg_msg("GCD of `%llu`, `%llu` is `%llu`", numA, numB, tempB);
+	bnToBytes(pCipher, pPub->modulusBytes, &encrypted);
+
+	RSA_TRACE(traceEventEncryptLetter, Letter, pPub->modulusBytes);
+}/* pubkeyEncrypter */
+
+/**
+ * @brief Decrypts the fixed width ciphertext blocks produced by stringEncoder().
+ * @return 0 when a block doesn't decrypt to a byte.
+ */
+_STATIC_INLINE uint8_t
+stringDecoder(const st_rsa_t * const pCtx, const uint8_t * const pEncryptedString,
+              const uint64_t strLen, uint8_t * const pDecryptedString)
+{
+	/* Validating */
+#if (FULL_ASSERTION_FLAG == FULL_ASSERTION_ACTIVE)
+	STATIC_ASSERT((pEncryptedString != NULL), DEFAULT_EXIT_CODE);	
+	STATIC_ASSERT((pDecryptedString != NULL), DEFAULT_EXIT_CODE);	
 #endif
 
-	return tempB;
-}/* getGCD */
+	/* Function data types */
+	const uint32_t blockLen = pCtx->pub.modulusBytes;
+	uint64_t register i = 0x00u;
+
+	/* Function body */
+	for(i = 0x00u; i < strLen; ++i)
+	{
+		if( (0x00u == privkeyDecrypter(pCtx, pEncryptedString + (i * blockLen), pDecryptedString + i)) )
+		{ return 0x00u; }
+		else;
+	}
+
+	RSA_STATS_ADD(bytesDecrypted, strLen);
+
+	return 0x01u;
+}/* stringDecoder */
+
+/**
+ * @brief Index slot of a ciphertext block, hashed from its last 8 bytes which
+ * 			  are uniform for a ciphertext below n.
+ */
+_STATIC_INLINE uint32_t
+byteTableSlot(const uint8_t * const pBlock, const uint32_t blockLen)
+{
+	/* Function data types */
+	uint64_t key = 0x00u;
+	uint32_t register i = 0x00u;
+
+	/* Function body */
+	if( (blockLen >= 0x08u) )
+	{ memcpy(&key, pBlock + blockLen - 0x08u, sizeof(key)); }
+	else
+	{
+		for(i = 0x00u; i < blockLen; ++i)
+		{ key = (key << 0x08u) | pBlock[i]; }
+	}
+
+	return (uint32_t) ((key * RSA_BYTE_TABLE_HASH_MULTIPLIER) >> (64u - RSA_BYTE_TABLE_SLOT_BITS));
+}/* byteTableSlot */
 
-_STATIC_INLINE uint64_t *
-stringEncoder(const uint8_t * const pString)
+/**
+ * @brief stringEncoder() through the byte table, every byte copies its
+ * 			  precomputed block.
+ */
+_STATIC_INLINE void
+byteTableEncoder(const st_rsa_t * const pCtx, const uint8_t * const pString,
+                 const uint64_t strLen, uint8_t * const pEncryptedString)
 {
 	/* Validating */
 #if (FULL_ASSERTION_FLAG == FULL_ASSERTION_ACTIVE)
-	STATIC_ASSERT((pString != NULL), DEFAULT_EXIT_CODE);	
+	STATIC_ASSERT((pString != NULL) || (0x00u == strLen), DEFAULT_EXIT_CODE);
+	STATIC_ASSERT((pEncryptedString != NULL) || (0x00u == strLen), DEFAULT_EXIT_CODE);
 #endif
 
 	/* Function data types */
-	uint64_t strLen = strlen(pString);
+	const uint8_t * const pBlocks = pCtx->pByteTable->pBlocks;
+	const uint32_t blockLen = pCtx->pub.modulusBytes;
+	uint64_t register i = 0x00u;
 
-	/**
-	 * @attention This method is using dynamic memory allocation (heap)
-	 * 					  which is not suitable for all systems such as embedded system.
-	 */
-	uint64_t *pEncryptedString = (uint64_t *) malloc(sizeof(uint64_t) * strLen);
+	/* Function body */
+	for(i = 0x00u; i < strLen; ++i)
+	{ memcpy(pEncryptedString + (i * blockLen), pBlocks + (pString[i] * blockLen), blockLen); }
+
+	RSA_STATS_ADD(bytesEncrypted, strLen);
 
+	RSA_TRACE(traceEventEncrypt, strLen, blockLen * strLen);
+}/* byteTableEncoder */
+
+/**
+ * @brief stringDecoder() through the byte table, a block is looked up by its
+ * 			  hash and compared in full. The table holds the ciphertext of every
+ * 				byte, so a block missing from it doesn't decrypt to a byte.
+ * @return 0 when a block is missing from the table.
+ */
+_STATIC_INLINE uint8_t
+byteTableDecoder(const st_rsa_t * const pCtx, const uint8_t * const pEncryptedString,
+                 const uint64_t strLen, uint8_t * const pDecryptedString)
+{
+	/* Validating */
 #if (FULL_ASSERTION_FLAG == FULL_ASSERTION_ACTIVE)
-	STATIC_ASSERT((pEncryptedString != NULL), DEFAULT_EXIT_CODE);	
+	STATIC_ASSERT((pEncryptedString != NULL) || (0x00u == strLen), DEFAULT_EXIT_CODE);
+	STATIC_ASSERT((pDecryptedString != NULL) || (0x00u == strLen), DEFAULT_EXIT_CODE);
 #endif
 
-	if( (pEncryptedString != NULL) )
+	/* Function data types */
+	const st_rsa_byte_table_t * const pTable = pCtx->pByteTable;
+	const uint32_t blockLen = pCtx->pub.modulusBytes;
+	const uint8_t *pBlock = NULL;
+	uint32_t slot = 0x00u;
+	uint32_t entry = 0x00u;
+	uint64_t register i = 0x00u;
+
+	/* Function body */
+	for(i = 0x00u; i < strLen; ++i)
 	{
-		uint64_t register i = 0x00u;
+		pBlock = pEncryptedString + (i * blockLen);
+		slot = byteTableSlot(pBlock, blockLen);
 
-		while(i < strLen)
+		for(entry = pTable->index[slot]; 0x00u != entry; entry = pTable->index[slot])
 		{
-			pEncryptedString[i] = pubkeyEncrypter(pString[i]);
-			++i;
+			if( (0x00 == memcmp(pTable->pBlocks + ((entry - 0x01u) * blockLen), pBlock, blockLen)) )
+			{ break; }
+			else;
+
+			slot = (slot + 0x01u) & (RSA_BYTE_TABLE_SLOTS - 0x01u);
 		}
+
+		if( (0x00u == entry) )
+		{ return 0x00u; }
+		else;
+
+		pDecryptedString[i] = (uint8_t) (entry - 0x01u);
+	}
+
+	RSA_STATS_ADD(bytesDecrypted, strLen);
+
+	return 0x01u;
+}/* byteTableDecoder */
+
+/**
+ * @brief Private key operation using the chinese remainder theorem,
+ * 				m1 = c^dP mod p, m2 = c^dQ mod q, then garner recombination
+ * 				m = m2 + q * (qInv * (m1 - m2) mod p).
+ * 				Every other prime r of a multi-prime key adds its residue on top,
+ * 				m = m + R * (t * (c^d' mod r - m) mod r) with R the product of the
+ * 				primes before r, RFC 8017 section 5.1.2.
+ * 				All the exponentiations run over moduli and exponents of the size
+ * 				of a single prime.
+ */
+_STATIC_INLINE void
+privkeyOperation(const st_rsa_t * const pCtx, st_rsa_bn_t * const pResult, const st_rsa_bn_t * const pInput)
+{
+	/* Function data types */
+	const struct rsa_crt_parameters * const pCrt = &pCtx->crt_parameters;
+	const struct rsa_crt_prime *pOther = NULL;
+	st_rsa_bn_t m1;
+	st_rsa_bn_t m2;
+	st_rsa_bn_t h;
+	st_rsa_bn_t product;
+	uint32_t register i = 0x00u;
+
+	/* Function body */
+	if( (0x01u == pCtx->math_parameters.n.used) )
+	{
+		bnFromWord(&m1, powMod(bnModWord(pInput, pCrt->p.limbs[0]), pCrt->dP.limbs[0], pCrt->p.limbs[0]));
+		bnFromWord(&m2, powMod(bnModWord(pInput, pCrt->q.limbs[0]), pCrt->dQ.limbs[0], pCrt->q.limbs[0]));
 	}
 	else
 	{
-#if (DEBUGGING_FLAG == DEBUGGING_ACTIVE)
-		win64_dbg_msg("pEncryptedString: NULL");
-#endif
+		bnPowMod(&pCrt->montP, &m1, pInput, &pCrt->dP);
+		bnPowMod(&pCrt->montQ, &m2, pInput, &pCrt->dQ);
 	}
 
-#if (DEBUGGING_FLAG == DEBUGGING_ACTIVE)
-	win64_dbg_msg("Encrypted message: \n");
-	printStrArrHex(pEncryptedString, strLen);
-#endif
+	/* h = qInv * (m1 - m2) mod p, m2 < q may exceed m1 so it is reduced first */
+	bnMod(&h, &m2, &pCrt->p);
+	if( (bnCompare(&m1, &h) < 0) )
+	{ bnAdd(&m1, &m1, &pCrt->p); }
+	else;
+	bnSub(&h, &m1, &h);
+	bnMulMod(&h, &h, &pCrt->qInv, &pCrt->p);
 
-	return pEncryptedString;
-}/* stringEncoder */
+	/* m = m2 + h * q */
+	bnMul(&h, &h, &pCrt->q);
+	bnAdd(pResult, &h, &m2);
 
+	if( (pCrt->numOfPrimes > 0x02u) )
+	{ bnMul(&product, &pCrt->p, &pCrt->q); }
+	else;
+
+	for(i = 0x02u; i < pCrt->numOfPrimes; ++i)
+	{
+		pOther = &pCrt->others[i - 0x02u];
+		if( (0x01u == pCtx->math_parameters.n.used) )
+		{ bnFromWord(&m1, powMod(bnModWord(pInput, pOther->r.limbs[0]), pOther->d.limbs[0], pOther->r.limbs[0])); }
+		else
+		{ bnPowMod(&pOther->montR, &m1, pInput, &pOther->d); }
+
+		/* h = t * (m1 - m) mod r */
+		bnMod(&h, pResult, &pOther->r);
+		if( (bnCompare(&m1, &h) < 0) )
+		{ bnAdd(&m1, &m1, &pOther->r); }
+		else;
+		bnSub(&h, &m1, &h);
+		bnMulMod(&h, &h, &pOther->t, &pOther->r);
+
+		/* m = m + h * R */
+		bnMul(&h, &h, &product);
+		bnAdd(pResult, pResult, &h);
+
+		if( ((i + 0x01u) < pCrt->numOfPrimes) )
+		{ bnMul(&product, &product, &pOther->r); }
+		else;
+	}
+}/* privkeyOperation */
+
+/**
+ * @brief Decrypts a single letter block produced by pubkeyEncrypter().
+ * @return 0 when the block is not below n or doesn't decrypt to a byte.
+ */
 _STATIC_INLINE uint8_t
-pubkeyEncrypter(const uint8_t Letter)
+privkeyDecrypter(const st_rsa_t * const pCtx, const uint8_t * const pCipher, uint8_t * const pLetter)
 {
 	/* Validating */
 #if (FULL_ASSERTION_FLAG == FULL_ASSERTION_ACTIVE)
-	STATIC_ASSERT((Letter > 0), DEFAULT_EXIT_CODE);	
+	STATIC_ASSERT((pCipher != NULL) && (pLetter != NULL), DEFAULT_EXIT_CODE);
 #endif
 
-	uint64_t e = my_rsa_lib.math_parameters.e;
-	uint64_t decrypted = 0x01u;
-	uint64_t n = my_rsa_lib.math_parameters.n;
+	/* Function data types */
+	st_rsa_bn_t encrypted;
+	st_rsa_bn_t decrypted;
+
+	/* Function body */
+	bnFromBytes(&encrypted, pCipher, pCtx->pub.modulusBytes);
+	if( (bnCompare(&encrypted, &pCtx->math_parameters.n) >= 0) )
+	{ return 0x00u; }
+	else;
+
+	privkeyOperation(pCtx, &decrypted, &encrypted);
+	if( (bnBitLength(&decrypted) > 0x08u) )
+	{ return 0x00u; }
+	else;
+
+	bnToBytes(pLetter, 0x01u, &decrypted);
+
+	return 0x01u;
+}/* privkeyDecrypter */
+
+/**
+ * @brief Encrypts one `modulusBytes - 1` bytes big endian block into a
+ * 			  `modulusBytes` bytes ciphertext block.
+ */
+_STATIC_INLINE void
+pubkeyBlockEncrypter(const st_rsa_pub_t * const pPub, const uint8_t * const pBlock, uint8_t * const pCipher)
+{
+	/* Function data types */
+	st_rsa_bn_t message;
+	st_rsa_bn_t encrypted;
+
+	/* Function body */
+	bnFromBytes(&message, pBlock, pPub->modulusBytes - 0x01u);
+
+	if( (0x01u == pPub->montN.n.used) )
+	{ bnFromWord(&encrypted, powMod(message.limbs[0], pPub->e.limbs[0], pPub->montN.n.limbs[0])); }
+	else
+	{ bnPowModPlan(&pPub->montN, &encrypted, &message, &pPub->e, &pPub->ePlan); }
+
+	bnToBytes(pCipher, pPub->modulusBytes, &encrypted);
+}/* pubkeyBlockEncrypter */
+
+/**
+ * @brief Packs the message into blocks of up to k - 3 bytes and encrypts
+ * 			  them, pCipher must hold blockCipherSize() bytes.
+ */
+_STATIC_INLINE void
+blockEncoder(const st_rsa_pub_t * const pPub, const uint8_t * const pMsg,
+             const uint64_t msgLen, uint8_t * const pCipher)
+{
+	/* Function data types */
+	uint8_t block[RSA_MAX_KEY_BITS / 0x08u];
+	uint64_t payloadLen = 0x00u;
+	uint64_t offset = 0x00u;
+	uint8_t *pOut = pCipher;
 
-	while(e--)
+	/* Function body */
+	for(offset = 0x00u; offset < msgLen; offset += payloadLen)
 	{
-		decrypted *= Letter;
-		decrypted %= n;
+		payloadLen = pPub->modulusBytes - RSA_BLOCK_HEADER_BYTES - 0x01u;
+		if( (payloadLen > (msgLen - offset)) )
+		{ payloadLen = msgLen - offset; }
+		else;
+
+		memset(block, 0x00u, pPub->modulusBytes - 0x01u);
+		block[0] = (uint8_t) (payloadLen >> 0x08u);
+		block[1] = (uint8_t) payloadLen;
+		memcpy(block + RSA_BLOCK_HEADER_BYTES, pMsg + offset, payloadLen);
+
+		pubkeyBlockEncrypter(pPub, block, pOut);
+		pOut += pPub->modulusBytes;
 	}
 
-#if (DEBUGGING_FLAG == DEBUGGING_ACTIVE)
-		win64_dbg_msg("Decrypted message letter: %x", decrypted);
+	RSA_TRACE(traceEventBlockEncrypt, msgLen, (uint64_t) (pOut - pCipher) / pPub->modulusBytes);
+	RSA_STATS_ADD(bytesEncrypted, msgLen);
+}/* blockEncoder */
+
+/**
+ * @brief Size in bytes of the block mode ciphertext of a `msgLen` bytes
+ * 			  message, 0 when the key is too small to carry a payload.
+ */
+_STATIC_INLINE uint64_t
+blockCipherSize(const st_rsa_pub_t * const pPub, const uint64_t msgLen)
+{
+	/* Function data types */
+	uint64_t payloadLen = 0x00u;
+
+	/* Function body */
+	if( (pPub->modulusBytes <= (RSA_BLOCK_HEADER_BYTES + 0x01u)) )
+	{ return 0x00u; }
+	else;
+
+	payloadLen = pPub->modulusBytes - RSA_BLOCK_HEADER_BYTES - 0x01u;
+
+	return ((msgLen + payloadLen - 0x01u) / payloadLen) * pPub->modulusBytes;
+}/* blockCipherSize */
+
+/**
+ * @brief Decrypts one ciphertext block into `modulusBytes - 1` bytes.
+ * @return 0 when the block is not below n or doesn't decrypt to a block.
+ */
+_STATIC_INLINE uint8_t
+privkeyBlockDecrypter(const st_rsa_t * const pCtx, const uint8_t * const pCipher, uint8_t * const pBlock)
+{
+	/* Function data types */
+	st_rsa_bn_t encrypted;
+	st_rsa_bn_t decrypted;
+
+	/* Function body */
+	bnFromBytes(&encrypted, pCipher, pCtx->pub.modulusBytes);
+	if( (bnCompare(&encrypted, &pCtx->math_parameters.n) >= 0) )
+	{ return 0x00u; }
+	else;
+
+	privkeyOperation(pCtx, &decrypted, &encrypted);
+	if( (bnBitLength(&decrypted) > ((pCtx->pub.modulusBytes - 0x01u) * 0x08u)) )
+	{ return 0x00u; }
+	else;
+
+	bnToBytes(pBlock, pCtx->pub.modulusBytes - 0x01u, &decrypted);
+
+	return 0x01u;
+}/* privkeyBlockDecrypter */
+
+/**
+ * @brief EMSA-PKCS1-v1_5 encoding of the SHA-256 hash of the message into
+ * 			  `modulusBytes` bytes, 0x00 0x01 0xFF .. 0xFF 0x00 DigestInfo hash.
+ */
+_STATIC_INLINE void
+signatureEncoder(const uint32_t modulusBytes, const uint8_t * const pMsg,
+                 const uint64_t msgLen, uint8_t * const pEncoded)
+{
+	/* Validating */
+#if (FULL_ASSERTION_FLAG == FULL_ASSERTION_ACTIVE)
+	STATIC_ASSERT((modulusBytes >= RSA_SIGNATURE_MIN_BYTES), DEFAULT_EXIT_CODE);
 #endif
+	/* Function data types */
+	const uint32_t tailBytes = RSA_SIGNATURE_DIGEST_INFO_BYTES + RSA_SHA256_DIGEST_BYTES;
 
-	return decrypted;
-}/* pubkeyEncrypter */
+	/* Function body */
+	pEncoded[0] = 0x00u;
+	pEncoded[1] = 0x01u;
+	memset(pEncoded + 0x02u, 0xFFu, modulusBytes - tailBytes - 0x03u);
+	pEncoded[modulusBytes - tailBytes - 0x01u] = 0x00u;
+	memcpy(pEncoded + modulusBytes - tailBytes, signatureDigestInfo, RSA_SIGNATURE_DIGEST_INFO_BYTES);
+	sha256Digest(pMsg, msgLen, pEncoded + modulusBytes - RSA_SHA256_DIGEST_BYTES);
+}/* signatureEncoder */
+
+/**
+ * @brief Compares an opened signature, s^e mod n, with the encoding of the
+ * 			  message, only a single encoding is valid so no parsing is needed.
+ */
+_STATIC_INLINE en_rsa_status_t
+signatureChecker(const st_rsa_pub_t * const pPub, const st_rsa_bn_t * const pOpened,
+                 const uint8_t * const pMsg, const uint64_t msgLen)
+{
+	/* Function data types */
+	uint8_t expected[RSA_MAX_KEY_BITS / 0x08u];
+	uint8_t opened[RSA_MAX_KEY_BITS / 0x08u];
+
+	/* Function body */
+	signatureEncoder(pPub->modulusBytes, pMsg, msgLen, expected);
+	bnToBytes(opened, pPub->modulusBytes, pOpened);
+
+	return (0x00u == memcmp(expected, opened, pPub->modulusBytes)) ? (rsaStatusOk) : (rsaStatusInvalidSignature);
+}/* signatureChecker */
+
+/**
+ * @brief Reads a `modulusBytes` big endian signature.
+ * @return rsaStatusInvalidKeySize for a key too small to sign,
+ * 				 rsaStatusInvalidSignature when the signature is not below n.
+ */
+_STATIC_INLINE en_rsa_status_t
+signatureLoader(const st_rsa_pub_t * const pPub, const uint8_t * const pSig, st_rsa_bn_t * const pSignature)
+{
+	/* Validating */
+	if( (pPub->modulusBytes < RSA_SIGNATURE_MIN_BYTES) )
+	{ return rsaStatusInvalidKeySize; }
+	else;
+
+	/* Function body */
+	bnFromBytes(pSignature, pSig, pPub->modulusBytes);
+
+	return (bnCompare(pSignature, &pPub->montN.n) < 0) ? (rsaStatusOk) : (rsaStatusInvalidSignature);
+}/* signatureLoader */
+
+/**
+ * @brief Verifies a single signature on the scalar engine.
+ */
+_STATIC_INLINE en_rsa_status_t
+pubkeyVerifier(const st_rsa_pub_t * const pPub, const uint8_t * const pMsg,
+               const uint64_t msgLen, const uint8_t * const pSig)
+{
+	/* Function data types */
+	st_rsa_bn_t signature;
+	st_rsa_bn_t opened;
+	en_rsa_status_t status = rsaStatusOk;
+
+	/* Function body */
+	status = signatureLoader(pPub, pSig, &signature);
+	if( (rsaStatusOk != status) )
+	{ return status; }
+	else;
+
+	bnPowModPlan(&pPub->montN, &opened, &signature, &pPub->e, &pPub->ePlan);
+
+	return signatureChecker(pPub, &opened, pMsg, msgLen);
+}/* pubkeyVerifier */
 
 _STATIC_INLINE void
-printStrArrHex(const uint64_t * const pArr, 
+printStrArrHex(const uint8_t * const pArr, 
 							 const uint64_t arrLen)
 {
 	/* Validating */
@@ -399,7 +1878,7 @@ printStrArrHex(const uint64_t * const pArr,
 
 	for(; i < arrLen; ++i)
 	{
-		printf("%x", pArr[i]);
+		printf("%02x", pArr[i]);
 	}
 
 	return;
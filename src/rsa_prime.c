@@ -0,0 +1,508 @@
+/**
+ * @file rsa_prime.c
+ * @author Mohamed ashraf (wx@wx.com)
+ * @brief rsa prime search program file
+ * @version 0.1
+ * @date 2023-01-01
+ *
+ * @copyright Copyright (c) Wx 2023
+ *
+ * @attention
+ *      The sieve only rejects candidates having a small factor, the
+ *      candidates it returns still have to go through a primality test.
+ *      primeSearch() runs independent random streams on several threads,
+ *      every worker owns its sieve and only the found primes are shared.
+ *      On AVX2 and AVX-512 CPUs the sieve survivors are taken by groups, a
+ *      vectorized base 2 round drops the composites of a group at once and
+ *      only the survivors reach the full primality test.
+ *
+ */
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <unistd.h>
+
+#include "rsa_cfg.h"
+#include "rsa_prv.h"
+#include "rsa_bn.h"
+#include "rsa_prime.h"
+#include "rsa_mb.h"
+#include "rsa_int.h"
+#include "rsa_trace.h"
+#include "rsa_stats.h"
+
+/*
+*--------------------------------------------------------------------------------------
+*- Macros
+*--------------------------------------------------------------------------------------
+**/
+
+/** @brief Upper bound of the small primes table, holds more than PRIME_NUMBERS_DB_SIZE odd primes */
+#define PRIME_TABLE_LIMIT 					(0x8000u)
+
+/*
+*--------------------------------------------------------------------------------------
+*- Data types
+*--------------------------------------------------------------------------------------
+**/
+
+/**
+ * @brief State shared by the workers of one primeSearch() call.
+*/
+typedef struct rsa_prime_job
+{
+	st_rsa_bn_t *pPrimes;
+	const uint32_t *pBits;
+	uint32_t numOfPrimes;
+	pf_rsa_prime_test_t pfTest;
+	pthread_mutex_t lock; 					/* Guards found, pPrimes and stats */
+	uint32_t found; 								/* Bit i is set once pPrimes[i] holds a prime */
+	uint32_t done; 									/* Set once every slot is filled, polled by the workers */
+	st_rsa_prime_stats_t stats;
+}st_rsa_prime_job_t;
+
+typedef struct rsa_prime_worker
+{
+	st_rsa_prime_job_t *pJob;
+	uint32_t id;
+}st_rsa_prime_worker_t;
+
+/** @brief First PRIME_NUMBERS_DB_SIZE odd primes, built once by initSmallPrimes() */
+static uint16_t smallPrimes[PRIME_NUMBERS_DB_SIZE];
+static pthread_once_t smallPrimesOnce = PTHREAD_ONCE_INIT;
+
+/*
+*--------------------------------------------------------------------------------------
+*- Private Functions Implementation
+*--------------------------------------------------------------------------------------
+**/
+
+/**
+ * @brief Sieve of eratosthenes over the odd numbers below PRIME_TABLE_LIMIT.
+ */
+static void
+initSmallPrimes(void)
+{
+	/* Function data types */
+	uint8_t isComposite[PRIME_TABLE_LIMIT / 0x02u];
+	uint32_t count = 0x00u;
+	uint32_t register i = 0x00u;
+	uint32_t register j = 0x00u;
+
+	/* Function body */
+	memset(isComposite, 0x00u, sizeof(isComposite));
+
+	/* Index i stands for the odd number 2i + 1 */
+	for(i = 0x01u; (i < (PRIME_TABLE_LIMIT / 0x02u)) && (count < PRIME_NUMBERS_DB_SIZE); ++i)
+	{
+		if( (isComposite[i]) )
+		{ continue; }
+		else;
+
+		const uint32_t prime = (i * 0x02u) + 0x01u;
+		smallPrimes[count++] = (uint16_t) prime;
+
+		for(j = (prime * prime) / 0x02u; j < (PRIME_TABLE_LIMIT / 0x02u); j += prime)
+		{ isComposite[j] = 0x01u; }
+	}
+
+#if (FULL_ASSERTION_FLAG == FULL_ASSERTION_ACTIVE)
+	STATIC_ASSERT((PRIME_NUMBERS_DB_SIZE == count), DEFAULT_EXIT_CODE);
+#endif
+}/* initSmallPrimes */
+
+/**
+ * @brief Computes base mod p for every small prime. The primes are grouped so
+ * 			  their product fits a word, then a single multi-precision reduction
+ * 				per group is followed by cheap word reductions.
+ */
+static void
+computeResidues(st_rsa_prime_sieve_t * const pSieve)
+{
+	/* Function data types */
+	uint32_t register first = 0x00u;
+	uint32_t register last = 0x00u;
+
+	/* Function body */
+	while( (first < pSieve->numOfPrimes) )
+	{
+		uint64_t product = smallPrimes[first];
+
+		for(last = first + 0x01u;
+		    (last < pSieve->numOfPrimes) && (product <= (UINT64_MAX / smallPrimes[last]));
+		    ++last)
+		{ product *= smallPrimes[last]; }
+
+		const uint64_t groupResidue = bnModWord(&pSieve->base, product);
+		for(; first < last; ++first)
+		{ pSieve->residues[first] = (uint16_t) (groupResidue % smallPrimes[first]); }
+	}
+}/* computeResidues */
+
+/**
+ * @brief Marks every window index k where base + 2k is divisible by a small
+ * 			  prime p, the first one solves 2k = -r (mod p).
+ */
+static void
+buildWindow(st_rsa_prime_sieve_t * const pSieve)
+{
+	/* Function data types */
+	uint32_t register i = 0x00u;
+	uint32_t register k = 0x00u;
+
+	/* Function body */
+	memset(pSieve->composite, 0x00u, sizeof(pSieve->composite));
+
+	for(i = 0x00u; i < pSieve->numOfPrimes; ++i)
+	{
+		const uint32_t prime = smallPrimes[i];
+		const uint32_t halfInverse = (prime + 0x01u) / 0x02u;
+
+		k = (((prime - pSieve->residues[i]) % prime) * halfInverse) % prime;
+		for(; k < RSA_PRIME_SIEVE_WINDOW; k += prime)
+		{ pSieve->composite[k] = 0x01u; }
+	}
+
+	pSieve->index = 0x00u;
+	++pSieve->stats.windows;
+}/* buildWindow */
+
+/**
+ * @brief Returns the first slot still missing a prime, starting from `slot`.
+ * @return numOfPrimes once every slot is filled.
+ */
+static uint32_t
+getOpenSlot(st_rsa_prime_job_t * const pJob, const uint32_t slot)
+{
+	/* Function data types */
+	const uint32_t found = __atomic_load_n(&pJob->found, __ATOMIC_ACQUIRE);
+	uint32_t register i = 0x00u;
+
+	/* Function body */
+	for(i = 0x00u; i < pJob->numOfPrimes; ++i)
+	{
+		const uint32_t candidateSlot = (slot + i) % pJob->numOfPrimes;
+		if( (0x00u == (found & (0x01u << candidateSlot))) )
+		{ return candidateSlot; }
+		else;
+	}
+
+	return pJob->numOfPrimes;
+}/* getOpenSlot */
+
+/**
+ * @brief Stores a prime into its slot unless another worker got there first
+ * 			  or the same prime already fills another slot.
+ */
+static void
+publishPrime(st_rsa_prime_job_t * const pJob, const uint32_t slot, const st_rsa_bn_t * const pPrime)
+{
+	/* Function data types */
+	uint8_t isDuplicate = 0x00u;
+	uint32_t register i = 0x00u;
+
+	/* Function body */
+	pthread_mutex_lock(&pJob->lock);
+
+	for(i = 0x00u; i < pJob->numOfPrimes; ++i)
+	{
+		if( (pJob->found & (0x01u << i)) && (0x00u == bnCompare(&pJob->pPrimes[i], pPrime)) )
+		{ isDuplicate = 0x01u; }
+		else;
+	}
+
+	if( (0x00u == (pJob->found & (0x01u << slot))) && (0x00u == isDuplicate) )
+	{
+		bnCopy(&pJob->pPrimes[slot], pPrime);
+		__atomic_store_n(&pJob->found, pJob->found | (0x01u << slot), __ATOMIC_RELEASE);
+
+		if( (pJob->found == ((0x01ull << pJob->numOfPrimes) - 0x01u)) )
+		{ __atomic_store_n(&pJob->done, 0x01u, __ATOMIC_RELEASE); }
+		else;
+	}
+	else;
+
+	pthread_mutex_unlock(&pJob->lock);
+}/* publishPrime */
+
+/**
+ * @brief Fills pCandidates with the next sieve survivors, `lanes` of them
+ * 			  passed through the vectorized base 2 round or a single one when
+ * 				lanes is 0. pPass[i] tells whether candidate i still may be prime.
+ * @return Candidates returned, 0 once the sieve ran out of candidates.
+ */
+static uint32_t
+getCandidates(st_rsa_prime_sieve_t * const pSieve, st_rsa_bn_t * const pCandidates,
+              uint8_t * const pPass, const uint32_t lanes)
+{
+	/* Function data types */
+	uint32_t count = 0x00u;
+
+	/* Function body */
+	if( (0x00u == lanes) )
+	{
+		pPass[0] = 0x01u;
+		return primeSieveNext(pSieve, &pCandidates[0]);
+	}
+	else;
+
+	while( (count < lanes) && (primeSieveNext(pSieve, &pCandidates[count])) )
+	{ ++count; }
+
+	if( (count > 0x00u) )
+	{ mbFermatBase2(pCandidates, pPass, count); }
+	else;
+
+	return count;
+}/* getCandidates */
+
+/**
+ * @brief Worker body, every worker starts on its own slot and moves to the
+ * 			  next open one once its slot is filled, so all the primes are
+ * 				searched concurrently and late slots get every core at the end.
+ */
+static void *
+primeSearchWorker(void *pArg)
+{
+	/* Function data types */
+	st_rsa_prime_worker_t * const pWorker = (st_rsa_prime_worker_t *) pArg;
+	st_rsa_prime_job_t * const pJob = pWorker->pJob;
+	st_rsa_prime_sieve_t sieve;
+	st_rsa_prime_stats_t stats = {0};
+	st_rsa_bn_t candidates[RSA_MB_MAX_PRIME_LANES];
+	uint8_t pass[RSA_MB_MAX_PRIME_LANES];
+	uint32_t slot = pWorker->id % pJob->numOfPrimes;
+	uint32_t lanes = 0x00u;
+	uint32_t count = 0x00u;
+	uint8_t found = 0x00u;
+	uint32_t register i = 0x00u;
+
+	/* Function body */
+	while( (0x00u == __atomic_load_n(&pJob->done, __ATOMIC_ACQUIRE)) )
+	{
+		slot = getOpenSlot(pJob, slot);
+		if( (slot == pJob->numOfPrimes) )
+		{ break; }
+		else;
+
+		/* Searching a fresh random stream, the cancellation is checked between candidates */
+		primeSieveInit(&sieve, pJob->pBits[slot]);
+		lanes = (pJob->pBits[slot] > RSA_BN_LIMB_BITS) ? (mbPrimeLanes()) : (0x00u);
+		found = 0x00u;
+		while( (0x00u == found) && (0x00u == __atomic_load_n(&pJob->done, __ATOMIC_ACQUIRE)) &&
+		       (0x00u == (__atomic_load_n(&pJob->found, __ATOMIC_ACQUIRE) & (0x01u << slot))) &&
+		       ((count = getCandidates(&sieve, candidates, pass, lanes)) > 0x00u) )
+		{
+			for(i = 0x00u; (0x00u == found) && (i < count); ++i)
+			{
+				if( (0x00u == pass[i]) )
+				{
+					RSA_STATS_ADD(fermatRejected, 0x01u);
+					++stats.fermatRejected;
+					continue;
+				}
+				else;
+
+				/* Only the fermat survivors reach the primality test */
+				++stats.mrTested;
+				if( (numberIsPrime == pJob->pfTest(&candidates[i])) )
+				{
+					RSA_TRACE(traceEventPrimeFound, slot, pJob->pBits[slot]);
+					RSA_STATS_ADD(primesFound, 0x01u);
+					publishPrime(pJob, slot, &candidates[i]);
+					found = 0x01u;
+				}
+				else
+				{
+					RSA_TRACE(traceEventPrimeTest, pJob->pBits[slot], 0x00u);
+					RSA_STATS_ADD(mrRejected, 0x01u);
+				}
+			}
+		}
+
+		RSA_STATS_ADD(primeCandidates, sieve.stats.candidates);
+		RSA_STATS_ADD(sieveRejected, sieve.stats.sieved);
+
+		stats.candidates += sieve.stats.candidates;
+		stats.sieved += sieve.stats.sieved;
+		stats.windows += sieve.stats.windows;
+	}
+
+	pthread_mutex_lock(&pJob->lock);
+	pJob->stats.candidates += stats.candidates;
+	pJob->stats.sieved += stats.sieved;
+	pJob->stats.fermatRejected += stats.fermatRejected;
+	pJob->stats.mrTested += stats.mrTested;
+	pJob->stats.windows += stats.windows;
+	pthread_mutex_unlock(&pJob->lock);
+
+	return NULL;
+}/* primeSearchWorker */
+
+/*
+*--------------------------------------------------------------------------------------
+*- Public Functions Implementation
+*--------------------------------------------------------------------------------------
+**/
+
+/**
+ * @brief Starts a new search from a random odd candidate of exactly `bits`
+ * 			  bits with the two top bits set.
+ */
+void
+primeSieveInit(st_rsa_prime_sieve_t * const pSieve, const uint32_t bits)
+{
+	/* Validating */
+#if (FULL_ASSERTION_FLAG == FULL_ASSERTION_ACTIVE)
+	STATIC_ASSERT((pSieve != NULL), DEFAULT_EXIT_CODE);
+	STATIC_ASSERT((bits >= 0x08u), DEFAULT_EXIT_CODE);
+#endif
+	/* Function data types */
+	const uint64_t smallestCandidate = (bits > 63u) ? (UINT64_MAX) : (0x01ull << (bits - 0x01u));
+
+	/* Function body */
+	pthread_once(&smallPrimesOnce, initSmallPrimes);
+
+	memset(&pSieve->stats, 0x00u, sizeof(pSieve->stats));
+	pSieve->bits = bits;
+
+	/* Only the primes below every candidate are usable, a candidate must never be sieved by itself */
+	for(pSieve->numOfPrimes = 0x00u;
+	    (pSieve->numOfPrimes < PRIME_NUMBERS_DB_SIZE) && (smallPrimes[pSieve->numOfPrimes] < smallestCandidate);
+	    ++pSieve->numOfPrimes);
+
+	bnRandom(&pSieve->base, bits, RSA_BN_RAND_TOP_TWO | RSA_BN_RAND_ODD);
+	computeResidues(pSieve);
+	buildWindow(pSieve);
+}/* primeSieveInit */
+
+/**
+ * @brief Returns the next candidate without small factors.
+ * @return 0 once the candidates outgrow `bits`, the sieve must then be
+ * 				 initialized again.
+ */
+uint8_t
+primeSieveNext(st_rsa_prime_sieve_t * const pSieve, st_rsa_bn_t * const pCandidate)
+{
+	/* Function data types */
+	uint32_t register i = 0x00u;
+
+	/* Function body */
+	while(1)
+	{
+		while( (pSieve->index < RSA_PRIME_SIEVE_WINDOW) && (pSieve->composite[pSieve->index]) )
+		{
+			++pSieve->index;
+			++pSieve->stats.sieved;
+			++pSieve->stats.candidates;
+		}
+
+		if( (pSieve->index < RSA_PRIME_SIEVE_WINDOW) )
+		{ break; }
+		else;
+
+		/* Slide to the next window, the residues move by 2 * window */
+		bnAddWord(&pSieve->base, &pSieve->base, 0x02u * RSA_PRIME_SIEVE_WINDOW);
+		for(i = 0x00u; i < pSieve->numOfPrimes; ++i)
+		{
+			pSieve->residues[i] = (uint16_t) ((pSieve->residues[i] +
+			                                   ((0x02u * RSA_PRIME_SIEVE_WINDOW) % smallPrimes[i])) % smallPrimes[i]);
+		}
+		buildWindow(pSieve);
+	}
+
+	bnAddWord(pCandidate, &pSieve->base, 0x02u * (uint64_t) pSieve->index);
+	++pSieve->index;
+	++pSieve->stats.candidates;
+
+	if( (bnBitLength(pCandidate) != pSieve->bits) )
+	{ return 0x00u; }
+	else;
+
+	++pSieve->stats.mrTested;
+	return 0x01u;
+}/* primeSieveNext */
+
+/**
+ * @brief Finds `numOfPrimes` distinct primes, pPrimes[i] having exactly
+ * 			  pBits[i] bits. The search runs on `numOfThreads` workers (0 uses
+ * 				every online core), the calling thread waits for all of them so no
+ * 				worker outlives the call. The counters are added to pStats.
+ */
+void
+primeSearch(st_rsa_bn_t * const pPrimes, const uint32_t * const pBits, const uint32_t numOfPrimes,
+            const uint32_t numOfThreads, const pf_rsa_prime_test_t pfTest,
+            st_rsa_prime_stats_t * const pStats)
+{
+	/* Validating */
+#if (FULL_ASSERTION_FLAG == FULL_ASSERTION_ACTIVE)
+	STATIC_ASSERT((pPrimes != NULL) && (pBits != NULL) && (pfTest != NULL), DEFAULT_EXIT_CODE);
+	STATIC_ASSERT((numOfPrimes > 0x00u) && (numOfPrimes <= RSA_PRIME_MAX_SLOTS), DEFAULT_EXIT_CODE);
+#endif
+	/* Function data types */
+	st_rsa_prime_job_t job;
+	pthread_t threads[RSA_PRIME_MAX_THREADS];
+	st_rsa_prime_worker_t workers[RSA_PRIME_MAX_THREADS];
+	uint32_t threadsCount = numOfThreads;
+	uint32_t started = 0x00u;
+	uint32_t register i = 0x00u;
+
+	/* Function body */
+	if( (0x00u == threadsCount) )
+	{
+		const long onlineCores = sysconf(_SC_NPROCESSORS_ONLN);
+		threadsCount = (onlineCores > 0) ? ((uint32_t) onlineCores) : (0x01u);
+	}
+	else;
+
+	if( (threadsCount > RSA_PRIME_MAX_THREADS) )
+	{ threadsCount = RSA_PRIME_MAX_THREADS; }
+	else;
+
+	memset(&job, 0x00u, sizeof(job));
+	job.pPrimes = pPrimes;
+	job.pBits = pBits;
+	job.numOfPrimes = numOfPrimes;
+	job.pfTest = pfTest;
+	pthread_mutex_init(&job.lock, NULL);
+	pthread_once(&smallPrimesOnce, initSmallPrimes);
+
+	if( (threadsCount > 0x01u) )
+	{
+		for(i = 0x00u; i < threadsCount; ++i)
+		{
+			workers[started].pJob = &job;
+			workers[started].id = started;
+			if( (0x00 == pthread_create(&threads[started], NULL, primeSearchWorker, &workers[started])) )
+			{ ++started; }
+			else;
+		}
+	}
+	else;
+
+	/* No worker could be started, the search runs on the calling thread */
+	if( (0x00u == started) )
+	{
+		workers[0].pJob = &job;
+		workers[0].id = 0x00u;
+		primeSearchWorker(&workers[0]);
+	}
+	else;
+
+	for(i = 0x00u; i < started; ++i)
+	{ pthread_join(threads[i], NULL); }
+
+	pthread_mutex_destroy(&job.lock);
+
+	if( (pStats != NULL) )
+	{
+		pStats->candidates += job.stats.candidates;
+		pStats->sieved += job.stats.sieved;
+		pStats->fermatRejected += job.stats.fermatRejected;
+		pStats->mrTested += job.stats.mrTested;
+		pStats->windows += job.stats.windows;
+	}
+	else;
+}/* primeSearch */
@@ -0,0 +1,579 @@
+/**
+ * @file rsa_prime64.c
+ * @author Mohamed ashraf (wx@wx.com)
+ * @brief rsa single word primality program file
+ * @version 0.1
+ * @date 2023-01-01
+ *
+ * @copyright Copyright (c) Wx 2023
+ *
+ * @attention
+ *      Every test goes through the same three stages:
+ *        - trial division by the primes below 64, using one multiplication
+ *          and one comparison per prime and no branch,
+ *        - a strong probable prime test to base 2, which rejects nearly all
+ *          the composites left,
+ *        - either the remaining bases of the smallest deterministic
+ *          Miller-Rabin set for the number, or a strong Lucas test (Baillie-PSW).
+ *          BPSW has no counterexample below 2^64.
+ *      The batch entry point runs the base 2 stage of RSA_PRIME64_LANES
+ *      candidates in lockstep, so the independent montgomery chains overlap
+ *      in the pipeline.
+ *
+ */
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "rsa_cfg.h"
+#include "rsa_prv.h"
+#include "rsa_mont.h"
+#include "rsa_prime64.h"
+#include "rsa_stats.h"
+
+/*
+*--------------------------------------------------------------------------------------
+*- Private Macros
+*--------------------------------------------------------------------------------------
+**/
+
+/** @brief Bit p is set for every prime p below 64 */
+#define PRIME64_SMALL_PRIMES_MASK 	(0x28208A20A08A28ACull)
+/** @brief 67^2, a number below it without a factor under 64 is prime */
+#define PRIME64_TRIAL_LIMIT 				(4489u)
+#define PRIME64_MAX_BASES 					(0x07u)
+
+/*
+*--------------------------------------------------------------------------------------
+*- Private Data types
+*--------------------------------------------------------------------------------------
+**/
+
+typedef enum en_Prime64Trial
+{
+	prime64TrialComposite = 0x00u,
+	prime64TrialPrime,
+	prime64TrialUndecided
+}en_Prime64Trial_t;
+
+typedef enum en_Prime64Method
+{
+	prime64MethodMillerRabin = 0x00u,
+	prime64MethodBailliePSW
+}en_Prime64Method_t;
+
+/**
+ * @brief p divides n exactly when n * p^-1 mod 2^64 <= (2^64 - 1) / p.
+*/
+typedef struct rsa_prime64_divisor
+{
+	uint64_t inverse; 		/* p^-1 mod 2^64 */
+	uint64_t limit; 			/* (2^64 - 1) / p */
+}st_rsa_prime64_divisor_t;
+
+/**
+ * @brief Miller-Rabin bases that leave no strong pseudoprime below `limit`.
+*/
+typedef struct rsa_prime64_bases
+{
+	uint64_t limit;
+	uint32_t numOfBases;
+	uint32_t bases[PRIME64_MAX_BASES];
+}st_rsa_prime64_bases_t;
+
+/** @brief The odd primes below 64 */
+static const st_rsa_prime64_divisor_t trialDivisors[] =
+{
+	{ 0xAAAAAAAAAAAAAAABull, 0x5555555555555555ull }, /* 3 */
+	{ 0xCCCCCCCCCCCCCCCDull, 0x3333333333333333ull }, /* 5 */
+	{ 0x6DB6DB6DB6DB6DB7ull, 0x2492492492492492ull }, /* 7 */
+	{ 0x2E8BA2E8BA2E8BA3ull, 0x1745D1745D1745D1ull }, /* 11 */
+	{ 0x4EC4EC4EC4EC4EC5ull, 0x13B13B13B13B13B1ull }, /* 13 */
+	{ 0xF0F0F0F0F0F0F0F1ull, 0x0F0F0F0F0F0F0F0Full }, /* 17 */
+	{ 0x86BCA1AF286BCA1Bull, 0x0D79435E50D79435ull }, /* 19 */
+	{ 0xD37A6F4DE9BD37A7ull, 0x0B21642C8590B216ull }, /* 23 */
+	{ 0x34F72C234F72C235ull, 0x08D3DCB08D3DCB08ull }, /* 29 */
+	{ 0xEF7BDEF7BDEF7BDFull, 0x0842108421084210ull }, /* 31 */
+	{ 0x14C1BACF914C1BADull, 0x06EB3E45306EB3E4ull }, /* 37 */
+	{ 0x8F9C18F9C18F9C19ull, 0x063E7063E7063E70ull }, /* 41 */
+	{ 0x82FA0BE82FA0BE83ull, 0x05F417D05F417D05ull }, /* 43 */
+	{ 0x51B3BEA3677D46CFull, 0x0572620AE4C415C9ull }, /* 47 */
+	{ 0x21CFB2B78C13521Dull, 0x04D4873ECADE304Dull }, /* 53 */
+	{ 0xCBEEA4E1A08AD8F3ull, 0x0456C797DD49C341ull }, /* 59 */
+	{ 0x4FBCDA3AC10C9715ull, 0x04325C53EF368EB0ull }  /* 61 */
+};
+
+/**
+ * @brief Smallest known deterministic base sets (Jaeschke and Sinclair), all
+ * 			  starting with base 2 so the first round is shared by every set.
+ * 				The last set covers the whole 64-bit range.
+ */
+static const st_rsa_prime64_bases_t mrBaseSets[] =
+{
+	{ 2047ull, 		 			 0x01u, { 2u } },
+	{ 1373653ull, 			 0x02u, { 2u, 3u } },
+	{ 4759123141ull, 		 0x03u, { 2u, 7u, 61u } },
+	{ 1122004669633ull, 0x04u, { 2u, 13u, 23u, 1662803u } },
+	{ ~0x00ull, 				 0x07u, { 2u, 325u, 9375u, 28178u, 450775u, 9780504u, 1795265022u } }
+};
+
+/*
+*--------------------------------------------------------------------------------------
+*- Private Functions Implementation
+*--------------------------------------------------------------------------------------
+**/
+
+/**
+ * @brief Settles the numbers below PRIME64_TRIAL_LIMIT and the ones with a
+ * 			  factor below 64, the divisibility checks are OR-ed without branching.
+ */
+static en_Prime64Trial_t
+trialDivision(const uint64_t num)
+{
+	/* Function data types */
+	uint64_t divides = ~num & 0x01u;
+	uint32_t register i = 0x00u;
+
+	/* Function body */
+	if( (num < 64u) )
+	{ return ((PRIME64_SMALL_PRIMES_MASK >> num) & 0x01u) ? (prime64TrialPrime) : (prime64TrialComposite); }
+	else;
+
+	for(i = 0x00u; i < (sizeof(trialDivisors) / sizeof(trialDivisors[0])); ++i)
+	{ divides |= (uint64_t) ((num * trialDivisors[i].inverse) <= trialDivisors[i].limit); }
+
+	if( (divides) )
+	{ return prime64TrialComposite; }
+	else if( (num < PRIME64_TRIAL_LIMIT) )
+	{ return prime64TrialPrime; }
+	else
+	{ return prime64TrialUndecided; }
+}/* trialDivision */
+
+/** @brief (a + b) mod n, for a and b below n */
+_STATIC_INLINE uint64_t
+addMod(const uint64_t a, const uint64_t b, const uint64_t n)
+{
+	const uint64_t gap = n - b;
+	return (a >= gap) ? (a - gap) : (a + b);
+}/* addMod */
+
+/** @brief (a - b) mod n, for a and b below n */
+_STATIC_INLINE uint64_t
+subMod(const uint64_t a, const uint64_t b, const uint64_t n)
+{
+	return (a >= b) ? (a - b) : (a + (n - b));
+}/* subMod */
+
+/** @brief a / 2 mod an odd n, an odd a is made even by adding n */
+_STATIC_INLINE uint64_t
+halveMod(const uint64_t a, const uint64_t n)
+{
+	return (a & 0x01u) ? ((a >> 0x01u) + (n >> 0x01u) + 0x01u) : (a >> 0x01u);
+}/* halveMod */
+
+/**
+ * @brief Strong probable prime test to base 2 of `lanes` odd numbers at once.
+ * 			  The loops run over the lanes innermost so the montgomery chains of
+ * 				the different numbers are independent and overlap, and the base
+ * 				being 2 turns every multiplication of the ladder into a doubling.
+ */
+static void
+sprpBase2Lanes(const uint64_t * const pNums, uint8_t * const pPass, const uint32_t lanes)
+{
+	/* Validating */
+#if (FULL_ASSERTION_FLAG == FULL_ASSERTION_ACTIVE)
+	STATIC_ASSERT((lanes <= RSA_PRIME64_LANES), DEFAULT_EXIT_CODE);
+#endif
+	/* Function data types */
+	st_rsa_mont_t mont[RSA_PRIME64_LANES];
+	uint64_t exp[RSA_PRIME64_LANES];
+	uint64_t x[RSA_PRIME64_LANES];
+	uint64_t minusOne[RSA_PRIME64_LANES];
+	uint32_t s[RSA_PRIME64_LANES];
+	uint64_t doubled = 0x00u;
+	uint32_t maxBits = 0x00u;
+	uint32_t maxS = 0x00u;
+	uint32_t register bit = 0x00u;
+	uint32_t register l = 0x00u;
+
+	/* Function body */
+	for(l = 0x00u; l < lanes; ++l)
+	{
+		montInit(&mont[l], pNums[l]);
+		s[l] = (uint32_t) __builtin_ctzll(pNums[l] - 0x01u);
+		exp[l] = (pNums[l] - 0x01u) >> s[l];
+		x[l] = mont[l].r;
+		minusOne[l] = pNums[l] - mont[l].r;
+
+		maxBits = (maxBits > (64u - (uint32_t) __builtin_clzll(exp[l]))) ?
+		          (maxBits) : (64u - (uint32_t) __builtin_clzll(exp[l]));
+		maxS = (maxS > s[l]) ? (maxS) : (s[l]);
+	}
+
+	/* 2^exp, the lanes with a shorter exponent square their montgomery 1 */
+	for(bit = maxBits; bit-- > 0x00u;)
+	{
+		for(l = 0x00u; l < lanes; ++l)
+		{
+			x[l] = montSqr(&mont[l], x[l]);
+			doubled = addMod(x[l], x[l], pNums[l]);
+			x[l] = ((exp[l] >> bit) & 0x01u) ? (doubled) : (x[l]);
+		}
+	}
+
+	for(l = 0x00u; l < lanes; ++l)
+	{ pPass[l] = (uint8_t) ((x[l] == mont[l].r) | (x[l] == minusOne[l])); }
+
+	for(bit = 0x01u; bit < maxS; ++bit)
+	{
+		for(l = 0x00u; l < lanes; ++l)
+		{
+			x[l] = montSqr(&mont[l], x[l]);
+			pPass[l] |= (uint8_t) ((bit < s[l]) & (x[l] == minusOne[l]));
+		}
+	}
+
+	RSA_STATS_ADD(mrRounds, lanes);
+}/* sprpBase2Lanes */
+
+/**
+ * @brief Strong probable prime test of an odd num - 1 = exp * 2^s to `base`.
+ */
+static uint8_t
+sprpBase(const st_rsa_mont_t * const pMont, const uint64_t base, const uint64_t exp, const uint32_t s)
+{
+	/* Function data types */
+	const uint64_t minusOne = pMont->n - pMont->r;
+	uint64_t x = montPow(pMont, montToForm(pMont, base), exp);
+	uint32_t register i = 0x00u;
+
+	/* Function body */
+	RSA_STATS_ADD(mrRounds, 0x01u);
+
+	if( (x == pMont->r) || (x == minusOne) )
+	{ return 0x01u; }
+	else;
+
+	for(i = 0x01u; i < s; ++i)
+	{
+		x = montSqr(pMont, x);
+		if( (x == minusOne) )
+		{ return 0x01u; }
+		else;
+	}
+
+	return 0x00u;
+}/* sprpBase */
+
+/**
+ * @brief Remaining Miller-Rabin rounds of a number that passed base 2.
+ */
+static en_PrimeNumbersStatus_t
+millerRabinRounds(const uint64_t num)
+{
+	/* Function data types */
+	const uint32_t s = (uint32_t) __builtin_ctzll(num - 0x01u);
+	const uint64_t exp = (num - 0x01u) >> s;
+	const st_rsa_prime64_bases_t *pSet = &mrBaseSets[0];
+	st_rsa_mont_t mont;
+	uint32_t register i = 0x00u;
+
+	/* Function body */
+	while( (num >= pSet->limit) )
+	{ ++pSet; }
+
+	montInit(&mont, num);
+	for(i = 0x01u; i < pSet->numOfBases; ++i)
+	{
+		if( (0x00u == sprpBase(&mont, pSet->bases[i], exp, s)) )
+		{ return numberNotPrime; }
+		else;
+	}
+
+	return numberIsPrime;
+}/* millerRabinRounds */
+
+/**
+ * @brief Jacobi symbol (a / n) for an odd n, by the binary reciprocity algorithm.
+ */
+static int32_t
+getJacobi(uint64_t a, uint64_t n)
+{
+	/* Function data types */
+	int32_t res = 0x01;
+	uint64_t tempVar = 0x00u;
+	uint32_t twos = 0x00u;
+
+	/* Function body */
+	a %= n;
+	while( (a) )
+	{
+		twos = (uint32_t) __builtin_ctzll(a);
+		a >>= twos;
+		/* (2 / n) = -1 for n = 3, 5 mod 8 */
+		if( (twos & 0x01u) && ((0x03u == (n & 0x07u)) || (0x05u == (n & 0x07u))) )
+		{ res = -res; }
+		else;
+
+		if( (0x03u == (a & 0x03u)) && (0x03u == (n & 0x03u)) )
+		{ res = -res; }
+		else;
+
+		tempVar = a;
+		a = n % a;
+		n = tempVar;
+	}
+
+	return (0x01u == n) ? (res) : (0x00);
+}/* getJacobi */
+
+/** @brief A perfect square has no Selfridge D, it must be caught beforehand */
+static uint8_t
+isPerfectSquare(const uint64_t num)
+{
+	/* Function data types */
+	uint64_t root = 0x01ull << ((64u - (uint32_t) __builtin_clzll(num) + 0x01u) / 0x02u);
+	uint64_t next = 0x00u;
+
+	/* Function body */
+	/* Newton iterations from above decrease until they reach floor(sqrt(num)) */
+	while( ((next = (root + (num / root)) >> 0x01u) < root) )
+	{ root = next; }
+
+	return (uint8_t) ((uint128_t) root * root == num);
+}/* isPerfectSquare */
+
+/**
+ * @brief Strong Lucas probable prime test with the Selfridge parameters:
+ * 			  D is the first of 5, -7, 9, -11, ... with (D / n) = -1, P = 1 and
+ * 				Q = (1 - D) / 4. With n + 1 = exp * 2^s, n passes when U(exp) = 0 or
+ * 				V(exp * 2^r) = 0 for some r < s. Runs in the montgomery domain,
+ * 				which keeps the additions, subtractions and halvings unchanged.
+ */
+static en_PrimeNumbersStatus_t
+lucasStrong(const uint64_t num)
+{
+	/* Function data types */
+	st_rsa_mont_t mont;
+	int64_t d = 0x05;
+	uint64_t dMod = 0x00u;
+	uint64_t qMod = 0x00u;
+	uint64_t exp = 0x00u;
+	uint64_t u = 0x00u, v = 0x00u, qk = 0x00u, q = 0x00u, dm = 0x00u, tempVar = 0x00u;
+	int32_t jacobi = 0x00;
+	uint32_t s = 0x00u;
+	int32_t register bit = 0x00;
+	uint32_t register i = 0x00u;
+
+	/* Function body */
+	if( (isPerfectSquare(num)) )
+	{ return numberNotPrime; }
+	else;
+
+	dMod = (uint64_t) d;
+	while( (-0x01 != (jacobi = getJacobi(dMod, num))) )
+	{
+		/* D shares a factor with n (D stays far below the trial division survivors) */
+		if( (0x00 == jacobi) )
+		{ return numberNotPrime; }
+		else;
+
+		d = (d > 0x00) ? (-(d + 0x02)) : (-d + 0x02);
+		dMod = (d > 0x00) ? ((uint64_t) d % num) : (num - ((uint64_t) -d % num));
+	}
+
+	q = (uint64_t) (((0x01 - d) / 0x04 >= 0x00) ? ((0x01 - d) / 0x04) : (-((0x01 - d) / 0x04)));
+	qMod = ((0x01 - d) / 0x04 >= 0x00) ? (q % num) : (num - (q % num));
+
+	/* num + 1 can't overflow, 2^64 - 1 is a multiple of 3 */
+	s = (uint32_t) __builtin_ctzll(num + 0x01u);
+	exp = (num + 0x01u) >> s;
+
+	montInit(&mont, num);
+	dm = montToForm(&mont, dMod);
+	q = montToForm(&mont, qMod);
+
+	/* k = 1: U = 1, V = P = 1, Q^k = Q */
+	u = mont.r;
+	v = mont.r;
+	qk = q;
+	for(bit = 62 - __builtin_clzll(exp); bit >= 0x00; --bit)
+	{
+		/* k -> 2k */
+		u = montMul(&mont, u, v);
+		v = subMod(montSqr(&mont, v), addMod(qk, qk, num), num);
+		qk = montSqr(&mont, qk);
+
+		/* k -> k + 1: U = (U + V) / 2, V = (D * U + V) / 2 */
+		if( ((exp >> bit) & 0x01u) )
+		{
+			tempVar = halveMod(addMod(u, v, num), num);
+			v = halveMod(addMod(montMul(&mont, dm, u), v, num), num);
+			u = tempVar;
+			qk = montMul(&mont, qk, q);
+		}
+		else;
+	}
+
+	if( (0x00u == u) )
+	{ return numberIsPrime; }
+	else;
+
+	for(i = 0x00u; i < s; ++i)
+	{
+		if( (0x00u == v) )
+		{ return numberIsPrime; }
+		else;
+
+		v = subMod(montSqr(&mont, v), addMod(qk, qk, num), num);
+		qk = montSqr(&mont, qk);
+	}
+
+	return numberNotPrime;
+}/* lucasStrong */
+
+/**
+ * @brief Last stage of a number that passed the trial division and base 2.
+ */
+static en_PrimeNumbersStatus_t
+finishTest(const uint64_t num, const en_Prime64Method_t method)
+{
+	if( (prime64MethodBailliePSW == method) )
+	{ return lucasStrong(num); }
+	else
+	{ return millerRabinRounds(num); }
+}/* finishTest */
+
+static en_PrimeNumbersStatus_t
+testWord(const uint64_t num, const en_Prime64Method_t method)
+{
+	/* Function data types */
+	const en_Prime64Trial_t trial = trialDivision(num);
+	uint8_t pass = 0x00u;
+
+	/* Function body */
+	if( (prime64TrialUndecided != trial) )
+	{ return (prime64TrialPrime == trial) ? (numberIsPrime) : (numberNotPrime); }
+	else;
+
+	sprpBase2Lanes(&num, &pass, 0x01u);
+
+	return (pass) ? (finishTest(num, method)) : (numberNotPrime);
+}/* testWord */
+
+/**
+ * @brief Base 2 stage of the batched candidates, then the last stage of the
+ * 			  few that pass it.
+ */
+static uint32_t
+flushLanes(const uint64_t * const pNums, en_PrimeNumbersStatus_t * const pStatus,
+           const uint32_t * const pIndex, const uint32_t lanes)
+{
+	/* Function data types */
+	uint64_t nums[RSA_PRIME64_LANES];
+	uint8_t pass[RSA_PRIME64_LANES];
+	uint32_t primes = 0x00u;
+	uint32_t register l = 0x00u;
+
+	/* Function body */
+	for(l = 0x00u; l < lanes; ++l)
+	{ nums[l] = pNums[pIndex[l]]; }
+
+	sprpBase2Lanes(nums, pass, lanes);
+
+	for(l = 0x00u; l < lanes; ++l)
+	{
+#if (PRIME64_TEST_FLAG == PRIME64_TEST_BAILLIE_PSW)
+		pStatus[pIndex[l]] = (pass[l]) ? (finishTest(nums[l], prime64MethodBailliePSW)) : (numberNotPrime);
+#else
+		pStatus[pIndex[l]] = (pass[l]) ? (finishTest(nums[l], prime64MethodMillerRabin)) : (numberNotPrime);
+#endif
+		primes += (numberIsPrime == pStatus[pIndex[l]]);
+	}
+
+	return primes;
+}/* flushLanes */
+
+/*
+*--------------------------------------------------------------------------------------
+*- Public Functions Implementation
+*--------------------------------------------------------------------------------------
+**/
+
+en_PrimeNumbersStatus_t
+prime64Test(const uint64_t num)
+{
+#if (PRIME64_TEST_FLAG == PRIME64_TEST_BAILLIE_PSW)
+	return testWord(num, prime64MethodBailliePSW);
+#else
+	return testWord(num, prime64MethodMillerRabin);
+#endif
+}/* prime64Test */
+
+/**
+ * @brief Deterministic Miller-Rabin, 1 to 7 rounds depending on the size of num.
+ */
+en_PrimeNumbersStatus_t
+prime64MillerRabin(const uint64_t num)
+{
+	return testWord(num, prime64MethodMillerRabin);
+}/* prime64MillerRabin */
+
+/**
+ * @brief Baillie-PSW, one base 2 round and one strong Lucas test.
+ */
+en_PrimeNumbersStatus_t
+prime64BailliePSW(const uint64_t num)
+{
+	return testWord(num, prime64MethodBailliePSW);
+}/* prime64BailliePSW */
+
+/**
+ * @brief Tests `count` numbers with the method of prime64Test(), pStatus[i]
+ * 			  receives the status of pNums[i].
+ * @return The number of primes found.
+ */
+uint32_t
+prime64TestBatch(const uint64_t * const pNums, en_PrimeNumbersStatus_t * const pStatus,
+                 const uint32_t count)
+{
+	/* Validating */
+#if (FULL_ASSERTION_FLAG == FULL_ASSERTION_ACTIVE)
+	STATIC_ASSERT((NULL != pNums), DEFAULT_EXIT_CODE);
+	STATIC_ASSERT((NULL != pStatus), DEFAULT_EXIT_CODE);
+#endif
+	/* Function data types */
+	uint32_t pending[RSA_PRIME64_LANES];
+	uint32_t numOfPending = 0x00u;
+	uint32_t primes = 0x00u;
+	en_Prime64Trial_t trial = prime64TrialUndecided;
+	uint32_t register i = 0x00u;
+
+	/* Function body */
+	for(i = 0x00u; i < count; ++i)
+	{
+		trial = trialDivision(pNums[i]);
+		if( (prime64TrialUndecided != trial) )
+		{
+			pStatus[i] = (prime64TrialPrime == trial) ? (numberIsPrime) : (numberNotPrime);
+			primes += (prime64TrialPrime == trial);
+			continue;
+		}
+		else;
+
+		pending[numOfPending++] = i;
+		if( (RSA_PRIME64_LANES == numOfPending) )
+		{
+			primes += flushLanes(pNums, pStatus, pending, numOfPending);
+			numOfPending = 0x00u;
+		}
+		else;
+	}
+
+	if( (numOfPending) )
+	{ primes += flushLanes(pNums, pStatus, pending, numOfPending); }
+	else;
+
+	return primes;
+}/* prime64TestBatch */
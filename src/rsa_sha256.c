@@ -0,0 +1,237 @@
+/**
+ * @file rsa_sha256.c
+ * @author Mohamed ashraf (wx@wx.com)
+ * @brief rsa SHA-256 message digest program file
+ * @version 0.1
+ * @date 2023-01-01
+ *
+ * @copyright Copyright (c) Wx 2023
+ *
+ * @attention
+ *      Whole blocks of the input are compressed straight from the caller
+ *      buffer, only the bytes left over are copied to the context.
+ *
+ */
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "rsa_cfg.h"
+#include "rsa_prv.h"
+#include "rsa_sha256.h"
+
+/*
+*--------------------------------------------------------------------------------------
+*- Macros
+*--------------------------------------------------------------------------------------
+**/
+
+#define SHA256_ROTR(_X, _N) 			(((_X) >> (_N)) | ((_X) << (32u - (_N))))
+#define SHA256_CH(_X, _Y, _Z) 		(((_X) & (_Y)) ^ (~(_X) & (_Z)))
+#define SHA256_MAJ(_X, _Y, _Z) 		(((_X) & (_Y)) ^ ((_X) & (_Z)) ^ ((_Y) & (_Z)))
+#define SHA256_SIGMA0(_X) 				(SHA256_ROTR((_X), 2u) ^ SHA256_ROTR((_X), 13u) ^ SHA256_ROTR((_X), 22u))
+#define SHA256_SIGMA1(_X) 				(SHA256_ROTR((_X), 6u) ^ SHA256_ROTR((_X), 11u) ^ SHA256_ROTR((_X), 25u))
+#define SHA256_GAMMA0(_X) 				(SHA256_ROTR((_X), 7u) ^ SHA256_ROTR((_X), 18u) ^ ((_X) >> 3u))
+#define SHA256_GAMMA1(_X) 				(SHA256_ROTR((_X), 17u) ^ SHA256_ROTR((_X), 19u) ^ ((_X) >> 10u))
+
+/*
+*--------------------------------------------------------------------------------------
+*- Private Data
+*--------------------------------------------------------------------------------------
+**/
+
+static const uint32_t sha256RoundConstants[0x40u] =
+{
+	0x428a2f98u, 0x71374491u, 0xb5c0fbcfu, 0xe9b5dba5u, 0x3956c25bu, 0x59f111f1u, 0x923f82a4u, 0xab1c5ed5u,
+	0xd807aa98u, 0x12835b01u, 0x243185beu, 0x550c7dc3u, 0x72be5d74u, 0x80deb1feu, 0x9bdc06a7u, 0xc19bf174u,
+	0xe49b69c1u, 0xefbe4786u, 0x0fc19dc6u, 0x240ca1ccu, 0x2de92c6fu, 0x4a7484aau, 0x5cb0a9dcu, 0x76f988dau,
+	0x983e5152u, 0xa831c66du, 0xb00327c8u, 0xbf597fc7u, 0xc6e00bf3u, 0xd5a79147u, 0x06ca6351u, 0x14292967u,
+	0x27b70a85u, 0x2e1b2138u, 0x4d2c6dfcu, 0x53380d13u, 0x650a7354u, 0x766a0abbu, 0x81c2c92eu, 0x92722c85u,
+	0xa2bfe8a1u, 0xa81a664bu, 0xc24b8b70u, 0xc76c51a3u, 0xd192e819u, 0xd6990624u, 0xf40e3585u, 0x106aa070u,
+	0x19a4c116u, 0x1e376c08u, 0x2748774cu, 0x34b0bcb5u, 0x391c0cb3u, 0x4ed8aa4au, 0x5b9cca4fu, 0x682e6ff3u,
+	0x748f82eeu, 0x78a5636fu, 0x84c87814u, 0x8cc70208u, 0x90befffau, 0xa4506cebu, 0xbef9a3f7u, 0xc67178f2u
+};
+
+/*
+*--------------------------------------------------------------------------------------
+*- Private Functions Implementation
+*--------------------------------------------------------------------------------------
+**/
+
+/**
+ * @brief Compresses one 64 bytes block into the state.
+ */
+static void
+sha256Compress(uint32_t * const pState, const uint8_t * const pBlock)
+{
+	/* Function data types */
+	uint32_t w[0x40u];
+	uint32_t a = pState[0], b = pState[1], c = pState[2], d = pState[3];
+	uint32_t e = pState[4], f = pState[5], g = pState[6], h = pState[7];
+	uint32_t t1 = 0x00u, t2 = 0x00u;
+	uint32_t register i = 0x00u;
+
+	/* Function body */
+	for(i = 0x00u; i < 0x10u; ++i)
+	{
+		w[i] = ((uint32_t) pBlock[(i * 0x04u)] << 24u) | ((uint32_t) pBlock[(i * 0x04u) + 0x01u] << 16u) |
+		       ((uint32_t) pBlock[(i * 0x04u) + 0x02u] << 8u) | (uint32_t) pBlock[(i * 0x04u) + 0x03u];
+	}
+
+	for(i = 0x10u; i < 0x40u; ++i)
+	{ w[i] = SHA256_GAMMA1(w[i - 0x02u]) + w[i - 0x07u] + SHA256_GAMMA0(w[i - 0x0Fu]) + w[i - 0x10u]; }
+
+	for(i = 0x00u; i < 0x40u; ++i)
+	{
+		t1 = h + SHA256_SIGMA1(e) + SHA256_CH(e, f, g) + sha256RoundConstants[i] + w[i];
+		t2 = SHA256_SIGMA0(a) + SHA256_MAJ(a, b, c);
+		h = g;
+		g = f;
+		f = e;
+		e = d + t1;
+		d = c;
+		c = b;
+		b = a;
+		a = t1 + t2;
+	}
+
+	pState[0] += a;
+	pState[1] += b;
+	pState[2] += c;
+	pState[3] += d;
+	pState[4] += e;
+	pState[5] += f;
+	pState[6] += g;
+	pState[7] += h;
+}/* sha256Compress */
+
+/*
+*--------------------------------------------------------------------------------------
+*- Public Functions Implementation
+*--------------------------------------------------------------------------------------
+**/
+
+void
+sha256Init(st_rsa_sha256_t * const pSha)
+{
+	/* Validating */
+#if (FULL_ASSERTION_FLAG == FULL_ASSERTION_ACTIVE)
+	STATIC_ASSERT((pSha != NULL), DEFAULT_EXIT_CODE);
+#endif
+
+	/* Function body */
+	pSha->state[0] = 0x6a09e667u;
+	pSha->state[1] = 0xbb67ae85u;
+	pSha->state[2] = 0x3c6ef372u;
+	pSha->state[3] = 0xa54ff53au;
+	pSha->state[4] = 0x510e527fu;
+	pSha->state[5] = 0x9b05688cu;
+	pSha->state[6] = 0x1f83d9abu;
+	pSha->state[7] = 0x5be0cd19u;
+	pSha->length = 0x00u;
+	pSha->blockLen = 0x00u;
+}/* sha256Init */
+
+void
+sha256Update(st_rsa_sha256_t * const pSha, const uint8_t * const pData, const uint64_t len)
+{
+	/* Validating */
+#if (FULL_ASSERTION_FLAG == FULL_ASSERTION_ACTIVE)
+	STATIC_ASSERT((pSha != NULL) && ((pData != NULL) || (0x00u == len)), DEFAULT_EXIT_CODE);
+#endif
+	/* Function data types */
+	uint64_t offset = 0x00u;
+	uint64_t take = 0x00u;
+
+	/* Function body */
+	pSha->length += len;
+
+	/* Completing the pending block first */
+	if( (pSha->blockLen > 0x00u) )
+	{
+		take = RSA_SHA256_BLOCK_BYTES - pSha->blockLen;
+		if( (take > len) )
+		{ take = len; }
+		else;
+
+		memcpy(pSha->block + pSha->blockLen, pData, take);
+		pSha->blockLen += (uint32_t) take;
+		offset = take;
+
+		if( (RSA_SHA256_BLOCK_BYTES == pSha->blockLen) )
+		{
+			sha256Compress(pSha->state, pSha->block);
+			pSha->blockLen = 0x00u;
+		}
+		else;
+	}
+	else;
+
+	for(; (len - offset) >= RSA_SHA256_BLOCK_BYTES; offset += RSA_SHA256_BLOCK_BYTES)
+	{ sha256Compress(pSha->state, pData + offset); }
+
+	if( (offset < len) )
+	{
+		memcpy(pSha->block, pData + offset, len - offset);
+		pSha->blockLen = (uint32_t) (len - offset);
+	}
+	else;
+}/* sha256Update */
+
+/**
+ * @brief Pads the message, writes the 32 bytes digest and wipes the context.
+ */
+void
+sha256Final(st_rsa_sha256_t * const pSha, uint8_t * const pDigest)
+{
+	/* Validating */
+#if (FULL_ASSERTION_FLAG == FULL_ASSERTION_ACTIVE)
+	STATIC_ASSERT((pSha != NULL) && (pDigest != NULL), DEFAULT_EXIT_CODE);
+#endif
+	/* Function data types */
+	const uint64_t bitLength = pSha->length * 0x08u;
+	uint32_t register i = 0x00u;
+
+	/* Function body */
+	pSha->block[pSha->blockLen++] = 0x80u;
+
+	/* The length needs the last 8 bytes of a block */
+	if( (pSha->blockLen > (RSA_SHA256_BLOCK_BYTES - 0x08u)) )
+	{
+		memset(pSha->block + pSha->blockLen, 0x00u, RSA_SHA256_BLOCK_BYTES - pSha->blockLen);
+		sha256Compress(pSha->state, pSha->block);
+		pSha->blockLen = 0x00u;
+	}
+	else;
+
+	memset(pSha->block + pSha->blockLen, 0x00u, RSA_SHA256_BLOCK_BYTES - 0x08u - pSha->blockLen);
+	for(i = 0x00u; i < 0x08u; ++i)
+	{ pSha->block[RSA_SHA256_BLOCK_BYTES - 0x01u - i] = (uint8_t) (bitLength >> (i * 0x08u)); }
+	sha256Compress(pSha->state, pSha->block);
+
+	for(i = 0x00u; i < 0x08u; ++i)
+	{
+		pDigest[(i * 0x04u)] = (uint8_t) (pSha->state[i] >> 24u);
+		pDigest[(i * 0x04u) + 0x01u] = (uint8_t) (pSha->state[i] >> 16u);
+		pDigest[(i * 0x04u) + 0x02u] = (uint8_t) (pSha->state[i] >> 8u);
+		pDigest[(i * 0x04u) + 0x03u] = (uint8_t) pSha->state[i];
+	}
+
+	memset(pSha, 0x00u, sizeof(*pSha));
+}/* sha256Final */
+
+/**
+ * @brief One shot digest of a buffer.
+ */
+void
+sha256Digest(const uint8_t * const pData, const uint64_t len, uint8_t * const pDigest)
+{
+	/* Function data types */
+	st_rsa_sha256_t sha;
+
+	/* Function body */
+	sha256Init(&sha);
+	sha256Update(&sha, pData, len);
+	sha256Final(&sha, pDigest);
+}/* sha256Digest */
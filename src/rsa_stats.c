@@ -0,0 +1,258 @@
+/**
+ * @file rsa_stats.c
+ * @author Mohamed ashraf (wx@wx.com)
+ * @brief rsa performance counters program file
+ * @version 0.1
+ * @date 2023-01-01
+ *
+ * @copyright Copyright (c) Wx 2023
+ *
+ * @attention
+ *      A thread claims a counters block on its first count and gives it back
+ *      when it exits, a thread specific key destructor folds its counts into
+ *      the retired totals and frees the slot for the next thread. Only the
+ *      threads past RSA_STATS_MAX_THREADS alive at the same time fall back
+ *      to the shared block.
+ *      A block has a single writer, rsa_get_stats() reads them with relaxed
+ *      loads. rsa_reset_stats() doesn't touch the blocks, it records the
+ *      current sums as the baseline subtracted by the next reads.
+ *
+ */
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <time.h>
+
+#include "rsa_cfg.h"
+#include "rsa_prv.h"
+#include "rsa_int.h"
+#include "rsa_stats.h"
+
+/*
+*--------------------------------------------------------------------------------------
+*- Macros
+*--------------------------------------------------------------------------------------
+**/
+
+/** @brief The counters are all 64-bit words and are summed as an array */
+#define RSA_STATS_NUM_OF_WORDS 				(sizeof(rsa_stats_t) / sizeof(uint64_t))
+
+/*
+*--------------------------------------------------------------------------------------
+*- Private Data
+*--------------------------------------------------------------------------------------
+**/
+
+#if (STATS_FLAG == STATS_ACTIVE)
+__thread st_rsa_stats_block_t *statsBlock = NULL;
+
+st_rsa_stats_block_t statsSharedBlock;
+
+static st_rsa_stats_block_t statsBlocks[RSA_STATS_MAX_THREADS];
+/** @brief Set while the block is owned by a live thread, guarded by statsLock */
+static uint8_t statsBlocksOwned[RSA_STATS_MAX_THREADS];
+/** @brief Counts of the exited threads, guarded by statsLock */
+static rsa_stats_t statsRetired;
+/** @brief Sums at the last rsa_reset_stats(), guarded by statsLock */
+static rsa_stats_t statsBaseline;
+static pthread_mutex_t statsLock = PTHREAD_MUTEX_INITIALIZER;
+/** @brief Releases the block of an exiting thread */
+static pthread_key_t statsKey;
+static pthread_once_t statsKeyOnce = PTHREAD_ONCE_INIT;
+#endif
+
+/*
+*--------------------------------------------------------------------------------------
+*- Private Functions Implementation
+*--------------------------------------------------------------------------------------
+**/
+
+#if (STATS_FLAG == STATS_ACTIVE)
+/**
+ * @brief Thread specific key destructor, folds the counts of the exiting
+ * 			  thread into the retired totals and frees its block.
+ */
+static void
+statsReleaseBlock(void *pArg)
+{
+	/* Function data types */
+	st_rsa_stats_block_t * const pBlock = (st_rsa_stats_block_t *) pArg;
+	uint64_t * const pRetiredWords = (uint64_t *) &statsRetired;
+	uint64_t * const pBlockWords = (uint64_t *) &pBlock->counters;
+	uint32_t register j = 0x00u;
+
+	/* Function body */
+	pthread_mutex_lock(&statsLock);
+	for(j = 0x00u; j < RSA_STATS_NUM_OF_WORDS; ++j)
+	{
+		pRetiredWords[j] += pBlockWords[j];
+		__atomic_store_n(&pBlockWords[j], 0x00u, __ATOMIC_RELAXED);
+	}
+	statsBlocksOwned[pBlock - statsBlocks] = 0x00u;
+	pthread_mutex_unlock(&statsLock);
+
+	/* A count from a later destructor claims a block again */
+	statsBlock = NULL;
+}/* statsReleaseBlock */
+
+static void
+statsCreateKey(void)
+{
+	(void) pthread_key_create(&statsKey, statsReleaseBlock);
+}/* statsCreateKey */
+
+/**
+ * @brief Hands the calling thread a free block, or the shared one while
+ * 			  RSA_STATS_MAX_THREADS other threads hold theirs.
+ */
+st_rsa_stats_block_t *
+statsClaimBlock(void)
+{
+	/* Function data types */
+	uint32_t register i = 0x00u;
+
+	/* Function body */
+	(void) pthread_once(&statsKeyOnce, statsCreateKey);
+
+	statsBlock = &statsSharedBlock;
+
+	pthread_mutex_lock(&statsLock);
+	for(i = 0x00u; i < RSA_STATS_MAX_THREADS; ++i)
+	{
+		if( (0x00u == statsBlocksOwned[i]) )
+		{
+			statsBlocksOwned[i] = 0x01u;
+			statsBlock = &statsBlocks[i];
+			break;
+		}
+		else;
+	}
+	pthread_mutex_unlock(&statsLock);
+
+	if( (&statsSharedBlock != statsBlock) )
+	{ (void) pthread_setspecific(statsKey, statsBlock); }
+	else;
+
+	return statsBlock;
+}/* statsClaimBlock */
+
+uint64_t
+statsGetTimeNs(void)
+{
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return ((uint64_t) now.tv_sec * 1000000000ull) + (uint64_t) now.tv_nsec;
+}/* statsGetTimeNs */
+
+/**
+ * @brief Sums the retired totals and every block into pSum, statsLock must
+ * 			  be held so no block is folded meanwhile.
+ */
+static void
+statsSum(rsa_stats_t * const pSum)
+{
+	/* Function data types */
+	uint64_t * const pWords = (uint64_t *) pSum;
+	const uint64_t * const pSharedWords = (const uint64_t *) &statsSharedBlock.counters;
+	const uint64_t *pBlockWords = NULL;
+	uint32_t register i = 0x00u;
+	uint32_t register j = 0x00u;
+
+	/* Function body */
+	*pSum = statsRetired;
+
+	/* Free blocks are zero */
+	for(i = 0x00u; i < RSA_STATS_MAX_THREADS; ++i)
+	{
+		pBlockWords = (const uint64_t *) &statsBlocks[i].counters;
+		for(j = 0x00u; j < RSA_STATS_NUM_OF_WORDS; ++j)
+		{ pWords[j] += __atomic_load_n(&pBlockWords[j], __ATOMIC_RELAXED); }
+	}
+
+	for(j = 0x00u; j < RSA_STATS_NUM_OF_WORDS; ++j)
+	{ pWords[j] += __atomic_load_n(&pSharedWords[j], __ATOMIC_RELAXED); }
+}/* statsSum */
+#endif
+
+/**
+ * @brief Adds a key generation started at `startNs` to the latency histogram,
+ * 			  bucket i counts the latencies below 2^i ms not counted by bucket i - 1.
+ */
+void
+statsRecordKeygen(const uint64_t startNs)
+{
+#if (STATS_FLAG == STATS_ACTIVE)
+	/* Function data types */
+	const uint64_t elapsedNs = statsGetTimeNs() - startNs;
+	uint64_t elapsedMs = elapsedNs / 1000000u;
+	uint32_t bucket = 0x00u;
+
+	/* Function body */
+	while( (elapsedMs) && (bucket < (RSA_STATS_KEYGEN_BUCKETS - 0x01u)) )
+	{
+		elapsedMs >>= 0x01u;
+		++bucket;
+	}
+
+	RSA_STATS_ADD(keygens, 0x01u);
+	RSA_STATS_ADD(keygenTotalNs, elapsedNs);
+	RSA_STATS_ADD(keygenHistogram[bucket], 0x01u);
+#else
+	(void) startNs;
+#endif
+}/* statsRecordKeygen */
+
+/*
+*--------------------------------------------------------------------------------------
+*- Public Functions Implementation
+*--------------------------------------------------------------------------------------
+**/
+
+/**
+ * @brief Counters of every thread since the last rsa_reset_stats(), all
+ * 			  zero when the counters aren't compiled in.
+ */
+void
+rsa_get_stats(rsa_stats_t * const pStats)
+{
+#if (STATS_FLAG == STATS_ACTIVE)
+	/* Function data types */
+	uint64_t * const pWords = (uint64_t *) pStats;
+	const uint64_t * const pBaseline = (const uint64_t *) &statsBaseline;
+	uint32_t register i = 0x00u;
+#endif
+
+	/* Validating */
+	if( (NULL == pStats) )
+	{ return; }
+	else;
+
+	/* Function body */
+#if (STATS_FLAG == STATS_ACTIVE)
+	/* Summing under the lock orders the reads after the last reset */
+	pthread_mutex_lock(&statsLock);
+	statsSum(pStats);
+	for(i = 0x00u; i < RSA_STATS_NUM_OF_WORDS; ++i)
+	{ pWords[i] -= pBaseline[i]; }
+	pthread_mutex_unlock(&statsLock);
+#else
+	memset(pStats, 0x00u, sizeof(rsa_stats_t));
+#endif
+}/* rsa_get_stats */
+
+void
+rsa_reset_stats(void)
+{
+#if (STATS_FLAG == STATS_ACTIVE)
+	/* Function data types */
+	rsa_stats_t sum;
+
+	/* Function body */
+	pthread_mutex_lock(&statsLock);
+	statsSum(&sum);
+	statsBaseline = sum;
+	pthread_mutex_unlock(&statsLock);
+#endif
+}/* rsa_reset_stats */
@@ -0,0 +1,420 @@
+/**
+ * @file rsa_store.c
+ * @author Mohamed ashraf (wx@wx.com)
+ * @brief rsa binary key store program file
+ * @version 0.1
+ * @date 2023-01-01
+ *
+ * @copyright Copyright (c) Wx 2023
+ *
+ * @attention
+ *      File layout, in native byte order:
+ *        - a 64 bytes header (magic, version, record size and the offsets),
+ *        - an open addressing index of `indexSlots` (id, record + 1) entries,
+ *          a power of two at least twice the number of keys, 0 marks a free slot,
+ *        - page aligned records, every record is the whole st_rsa_t of a key
+ *          with its montgomery, CRT and multi-buffer precomputation.
+ *      The records hold no pointer (the allocator and the byte table are
+ *      cleared when written), so rsa_store_open() maps the file and the keys
+ *      are used in place. A file is only accepted by a library built with the
+ *      same record size and RSA_MAX_KEY_BITS.
+ *      The records carry the private keys in clear, the file is created
+ *      readable by its owner only.
+ *
+ */
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "rsa_cfg.h"
+#include "rsa_prv.h"
+#include "rsa_int.h"
+
+/*
+*--------------------------------------------------------------------------------------
+*- Macros
+*--------------------------------------------------------------------------------------
+**/
+
+#define RSA_STORE_MAGIC 						"RSASTORE"
+#define RSA_STORE_MAGIC_BYTES 			(0x08u)
+#define RSA_STORE_VERSION 					(0x04u)
+/** @brief Alignment of the records section inside the file */
+#define RSA_STORE_PAGE 							(0x1000u)
+/** @brief Multiplier of the id hash (2^64 / golden ratio) */
+#define RSA_STORE_HASH_MULTIPLIER 	(0x9E3779B97F4A7C15ull)
+
+/*
+*--------------------------------------------------------------------------------------
+*- Data types
+*--------------------------------------------------------------------------------------
+**/
+
+typedef struct rsa_store_header
+{
+	char magic[RSA_STORE_MAGIC_BYTES];
+	uint32_t version;
+	uint32_t maxKeyBits; 					/* RSA_MAX_KEY_BITS of the writer */
+	uint64_t recordSize; 					/* sizeof(st_rsa_t) of the writer */
+	uint64_t numOfKeys;
+	uint64_t indexSlots;
+	uint64_t indexOffset;
+	uint64_t recordsOffset;
+	uint64_t reserved;
+}st_rsa_store_header_t;
+
+typedef struct rsa_store_entry
+{
+	uint64_t id;
+	uint64_t record; 							/* Record index + 1, 0 for a free slot */
+}st_rsa_store_entry_t;
+
+typedef struct rsa_store
+{
+	const uint8_t *pMap;
+	size_t mapLen;
+	const st_rsa_store_entry_t *pIndex;
+	const uint8_t *pRecords;
+	uint64_t numOfKeys;
+	uint64_t slotMask; 						/* indexSlots - 1 */
+}st_rsa_store_t;
+
+/*
+*--------------------------------------------------------------------------------------
+*- Private Functions Implementation
+*--------------------------------------------------------------------------------------
+**/
+
+/** @brief Home slot of an id, the high bits of the product are folded in */
+_STATIC_INLINE uint64_t
+storeSlot(const uint64_t id, const uint64_t slotMask)
+{
+	const uint64_t hash = id * RSA_STORE_HASH_MULTIPLIER;
+	return (hash ^ (hash >> 32)) & slotMask;
+}/* storeSlot */
+
+/**
+ * @brief Builds the index of `numOfKeys` ids, linear probing from the home slot.
+ * @return 0 when an id is repeated.
+ */
+static uint8_t
+storeBuildIndex(st_rsa_store_entry_t * const pIndex, const uint64_t slotMask,
+                const uint64_t * const pIds, const uint64_t numOfKeys)
+{
+	/* Function data types */
+	uint64_t slot = 0x00u;
+	uint64_t register i = 0x00u;
+
+	/* Function body */
+	memset(pIndex, 0x00u, (slotMask + 0x01u) * sizeof(st_rsa_store_entry_t));
+
+	for(i = 0x00u; i < numOfKeys; ++i)
+	{
+		slot = storeSlot(pIds[i], slotMask);
+		while( (0x00u != pIndex[slot].record) )
+		{
+			if( (pIds[i] == pIndex[slot].id) )
+			{ return 0x00u; }
+			else;
+
+			slot = (slot + 0x01u) & slotMask;
+		}
+
+		pIndex[slot].id = pIds[i];
+		pIndex[slot].record = i + 0x01u;
+	}
+
+	return 0x01u;
+}/* storeBuildIndex */
+
+/**
+ * @brief Checks that a mapped file is a store of this build and that every
+ * 			  section lies inside the file.
+ */
+static uint8_t
+storeValidate(const st_rsa_store_header_t * const pHeader, const size_t fileLen)
+{
+	/* Function data types */
+	const uint64_t indexLen = pHeader->indexSlots * sizeof(st_rsa_store_entry_t);
+
+	/* Function body */
+	return (uint8_t) ( (0x00 == memcmp(pHeader->magic, RSA_STORE_MAGIC, RSA_STORE_MAGIC_BYTES)) &&
+	                   (RSA_STORE_VERSION == pHeader->version) &&
+	                   (RSA_MAX_KEY_BITS == pHeader->maxKeyBits) &&
+	                   (sizeof(st_rsa_t) == pHeader->recordSize) &&
+	                   (0x00u != pHeader->indexSlots) &&
+	                   (0x00u == (pHeader->indexSlots & (pHeader->indexSlots - 0x01u))) &&
+	                   (pHeader->numOfKeys < pHeader->indexSlots) &&
+	                   (pHeader->indexOffset >= sizeof(st_rsa_store_header_t)) &&
+	                   (pHeader->indexSlots <= (fileLen / sizeof(st_rsa_store_entry_t))) &&
+	                   ((pHeader->indexOffset + indexLen) <= fileLen) &&
+	                   (0x00u == (pHeader->recordsOffset % RSA_STORE_PAGE)) &&
+	                   (pHeader->recordsOffset <= fileLen) &&
+	                   (pHeader->numOfKeys <= ((fileLen - pHeader->recordsOffset) / sizeof(st_rsa_t))) );
+}/* storeValidate */
+
+/*
+*--------------------------------------------------------------------------------------
+*- Public Functions Implementation
+*--------------------------------------------------------------------------------------
+**/
+
+/**
+ * @brief Writes `numOfKeys` keys with their precomputation to a key store,
+ * 			  ppCtxs[i] is stored under pIds[i]. The file is removed on failure.
+ * @return rsaStatusInvalidArgument on a repeated id, rsaStatusNoKey when a
+ * 				 context holds no key.
+ */
+en_rsa_status_t
+rsa_store_write(const char * const pPath, const rsa_ctx_t * const * const ppCtxs,
+                const uint64_t * const pIds, const uint64_t numOfKeys)
+{
+	/* Function data types */
+	const rsa_allocator_t allocator = rsa_allocator_default();
+	st_rsa_store_header_t header;
+	st_rsa_store_entry_t *pIndex = NULL;
+	st_rsa_t *pRecord = NULL;
+	uint8_t padding[RSA_STORE_PAGE];
+	uint64_t indexSlots = 0x02u;
+	uint64_t paddingLen = 0x00u;
+	en_rsa_status_t status = rsaStatusOk;
+	FILE *pFile = NULL;
+	int fd = -1;
+	uint64_t register i = 0x00u;
+
+	/* Validating */
+	if( (NULL == pPath) || ((0x00u != numOfKeys) && ((NULL == ppCtxs) || (NULL == pIds))) )
+	{ return rsaStatusNullArgument; }
+	else;
+
+	for(i = 0x00u; i < numOfKeys; ++i)
+	{
+		if( (NULL == ppCtxs[i]) )
+		{ return rsaStatusNullArgument; }
+		else if( (0x00u == ppCtxs[i]->keyReady) )
+		{ return rsaStatusNoKey; }
+		else;
+	}
+
+	/* Function body */
+	while( (indexSlots < (numOfKeys * 0x02u)) )
+	{ indexSlots <<= 0x01u; }
+
+	memset(&header, 0x00u, sizeof(header));
+	memcpy(header.magic, RSA_STORE_MAGIC, RSA_STORE_MAGIC_BYTES);
+	header.version = RSA_STORE_VERSION;
+	header.maxKeyBits = RSA_MAX_KEY_BITS;
+	header.recordSize = sizeof(st_rsa_t);
+	header.numOfKeys = numOfKeys;
+	header.indexSlots = indexSlots;
+	header.indexOffset = sizeof(st_rsa_store_header_t);
+	header.recordsOffset = (header.indexOffset + (indexSlots * sizeof(st_rsa_store_entry_t)) + RSA_STORE_PAGE - 0x01u) &
+	                       ~((uint64_t) RSA_STORE_PAGE - 0x01u);
+	paddingLen = header.recordsOffset - header.indexOffset - (indexSlots * sizeof(st_rsa_store_entry_t));
+
+	pIndex = (st_rsa_store_entry_t *) allocator.pfAlloc(allocator.pUser, indexSlots * sizeof(st_rsa_store_entry_t),
+	                                                    __alignof__(st_rsa_store_entry_t));
+	pRecord = (st_rsa_t *) allocator.pfAlloc(allocator.pUser, sizeof(st_rsa_t), __alignof__(st_rsa_t));
+	if( (NULL == pIndex) || (NULL == pRecord) )
+	{ status = rsaStatusNoMemory; }
+	else if( (0x00u == storeBuildIndex(pIndex, indexSlots - 0x01u, pIds, numOfKeys)) )
+	{ status = rsaStatusInvalidArgument; }
+	else
+	{
+		fd = open(pPath, O_WRONLY | O_CREAT | O_TRUNC, 0600);
+		pFile = (fd >= 0) ? (fdopen(fd, "wb")) : (NULL);
+		if( (NULL == pFile) )
+		{
+			status = rsaStatusIoError;
+			if( (fd >= 0) )
+			{ close(fd); }
+			else;
+		}
+		else;
+	}
+
+	if( (rsaStatusOk == status) )
+	{
+		memset(padding, 0x00u, sizeof(padding));
+		if( (0x01u != fwrite(&header, sizeof(header), 0x01u, pFile)) ||
+		    (indexSlots != fwrite(pIndex, sizeof(st_rsa_store_entry_t), indexSlots, pFile)) ||
+		    (paddingLen != fwrite(padding, 0x01u, paddingLen, pFile)) )
+		{ status = rsaStatusIoError; }
+		else;
+
+		for(i = 0x00u; (rsaStatusOk == status) && (i < numOfKeys); ++i)
+		{
+			*pRecord = *((const st_rsa_t *) ppCtxs[i]);
+			memset(&pRecord->allocator, 0x00u, sizeof(pRecord->allocator));
+			pRecord->pByteTable = NULL;
+			if( (0x01u != fwrite(pRecord, sizeof(st_rsa_t), 0x01u, pFile)) )
+			{ status = rsaStatusIoError; }
+			else;
+		}
+
+		if( (0x00 != fclose(pFile)) && (rsaStatusOk == status) )
+		{ status = rsaStatusIoError; }
+		else;
+
+		if( (rsaStatusOk != status) )
+		{ remove(pPath); }
+		else;
+	}
+	else;
+
+	if( (NULL != pRecord) )
+	{
+		memset(pRecord, 0x00u, sizeof(st_rsa_t));
+		allocator.pfFree(allocator.pUser, pRecord);
+	}
+	else;
+
+	if( (NULL != pIndex) )
+	{ allocator.pfFree(allocator.pUser, pIndex); }
+	else;
+
+	return status;
+}/* rsa_store_write */
+
+/**
+ * @brief Maps a key store written by rsa_store_write(), nothing is read
+ * 			  until a key is looked up so opening is independent of the number
+ * 				of keys.
+ */
+en_rsa_status_t
+rsa_store_open(rsa_store_t ** const ppStore, const char * const pPath)
+{
+	/* Function data types */
+	const rsa_allocator_t allocator = rsa_allocator_default();
+	const st_rsa_store_header_t *pHeader = NULL;
+	st_rsa_store_t *pStore = NULL;
+	struct stat fileStat;
+	void *pMap = MAP_FAILED;
+	int fd = -1;
+
+	/* Validating */
+	if( (NULL == ppStore) || (NULL == pPath) )
+	{ return rsaStatusNullArgument; }
+	else;
+
+	/* Function body */
+	*ppStore = NULL;
+
+	fd = open(pPath, O_RDONLY);
+	if( (fd < 0) )
+	{ return rsaStatusIoError; }
+	else;
+
+	if( (0x00 == fstat(fd, &fileStat)) && ((size_t) fileStat.st_size >= sizeof(st_rsa_store_header_t)) )
+	{ pMap = mmap(NULL, (size_t) fileStat.st_size, PROT_READ, MAP_SHARED, fd, 0x00); }
+	else;
+	close(fd);
+
+	if( (MAP_FAILED == pMap) )
+	{ return rsaStatusInvalidKeyFile; }
+	else;
+
+	pHeader = (const st_rsa_store_header_t *) pMap;
+	if( (0x00u == storeValidate(pHeader, (size_t) fileStat.st_size)) )
+	{
+		munmap(pMap, (size_t) fileStat.st_size);
+		return rsaStatusInvalidKeyFile;
+	}
+	else;
+
+	pStore = (st_rsa_store_t *) allocator.pfAlloc(allocator.pUser, sizeof(st_rsa_store_t), __alignof__(st_rsa_store_t));
+	if( (NULL == pStore) )
+	{
+		munmap(pMap, (size_t) fileStat.st_size);
+		return rsaStatusNoMemory;
+	}
+	else;
+
+	/* Lookups touch one index line and one record, read ahead would be wasted */
+	madvise(pMap, (size_t) fileStat.st_size, MADV_RANDOM);
+
+	pStore->pMap = (const uint8_t *) pMap;
+	pStore->mapLen = (size_t) fileStat.st_size;
+	pStore->pIndex = (const st_rsa_store_entry_t *) (pStore->pMap + pHeader->indexOffset);
+	pStore->pRecords = pStore->pMap + pHeader->recordsOffset;
+	pStore->numOfKeys = pHeader->numOfKeys;
+	pStore->slotMask = pHeader->indexSlots - 0x01u;
+	*ppStore = (rsa_store_t *) pStore;
+
+	return rsaStatusOk;
+}/* rsa_store_open */
+
+/**
+ * @brief Unmaps the store, the contexts found in it are no longer valid.
+ */
+void
+rsa_store_close(rsa_store_t * const pStore)
+{
+	/* Function data types */
+	const rsa_allocator_t allocator = rsa_allocator_default();
+	st_rsa_store_t * const pState = (st_rsa_store_t *) pStore;
+
+	/* Function body */
+	if( (NULL == pState) )
+	{ return; }
+	else;
+
+	munmap((void *) pState->pMap, pState->mapLen);
+	allocator.pfFree(allocator.pUser, pState);
+}/* rsa_store_close */
+
+/**
+ * @brief Key stored under `id`, used in place from the mapping. The context
+ * 			  is read only and must not be destroyed.
+ * @return NULL when the id isn't in the store or its record is corrupted.
+ */
+const rsa_ctx_t *
+rsa_store_find(const rsa_store_t * const pStore, const uint64_t id)
+{
+	/* Function data types */
+	const st_rsa_store_t * const pState = (const st_rsa_store_t *) pStore;
+	const st_rsa_t *pRecord = NULL;
+	uint64_t slot = 0x00u;
+	uint64_t probes = 0x00u;
+
+	/* Validating */
+	if( (NULL == pState) )
+	{ return NULL; }
+	else;
+
+	/* Function body */
+	slot = storeSlot(id, pState->slotMask);
+	while( (0x00u != pState->pIndex[slot].record) && (probes++ <= pState->slotMask) )
+	{
+		if( (id == pState->pIndex[slot].id) )
+		{
+			/* A record outside the file means a corrupted index */
+			if( (pState->pIndex[slot].record > pState->numOfKeys) )
+			{ return NULL; }
+			else;
+
+			/* The CRT loop trusts numOfPrimes, a corrupted record must not reach it */
+			pRecord = (const st_rsa_t *) (pState->pRecords + ((pState->pIndex[slot].record - 0x01u) * sizeof(st_rsa_t)));
+			return ( (0x01u == pRecord->keyReady) && (pRecord->crt_parameters.numOfPrimes >= 0x02u) &&
+			         (pRecord->crt_parameters.numOfPrimes <= RSA_MAX_PRIMES) ) ?
+			       ((const rsa_ctx_t *) pRecord) :
+			       (NULL);
+		}
+		else;
+
+		slot = (slot + 0x01u) & pState->slotMask;
+	}
+
+	return NULL;
+}/* rsa_store_find */
+
+uint64_t
+rsa_store_count(const rsa_store_t * const pStore)
+{
+	return (NULL != pStore) ? (((const st_rsa_store_t *) pStore)->numOfKeys) : (0x00u);
+}/* rsa_store_count */
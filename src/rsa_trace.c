@@ -0,0 +1,356 @@
+/**
+ * @file rsa_trace.c
+ * @author Mohamed ashraf (wx@wx.com)
+ * @brief rsa tracing program file
+ * @version 0.1
+ * @date 2023-01-01
+ *
+ * @copyright Copyright (c) Wx 2023
+ *
+ * @attention
+ *      Every thread claims a free ring on its first record and gives it back
+ *      when it exits through a thread specific key destructor. The ring keeps
+ *      its records, the next owner appends after them, so the records of
+ *      exited workers can still be saved until the ring wraps. Only the
+ *      threads past RSA_TRACE_MAX_THREADS alive at the same time are not
+ *      traced. A ring has a single writer, the head is published with
+ *      release ordering and old records are overwritten once the ring wraps.
+ *      rsa_trace_save() reads the rings without stopping the writers, it is
+ *      meant to run once the traced work has finished.
+ *
+ */
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <time.h>
+
+#include "rsa_cfg.h"
+#include "rsa_prv.h"
+#include "rsa_int.h"
+#include "rsa_trace.h"
+
+/*
+*--------------------------------------------------------------------------------------
+*- Macros
+*--------------------------------------------------------------------------------------
+**/
+
+#define RSA_TRACE_RING_MASK 					(RSA_TRACE_RING_EVENTS - 0x01u)
+/** @brief First bytes of a trace file */
+#define RSA_TRACE_FILE_MAGIC 					"RSATRC01"
+#define RSA_TRACE_FILE_MAGIC_BYTES 		(0x08u)
+
+/*
+*--------------------------------------------------------------------------------------
+*- Data types
+*--------------------------------------------------------------------------------------
+**/
+
+/**
+ * @brief Per-thread ring, the head counts every record ever written.
+*/
+typedef struct rsa_trace_ring
+{
+	uint64_t head;
+	st_rsa_trace_record_t records[RSA_TRACE_RING_EVENTS];
+}__attribute__((aligned(64))) st_rsa_trace_ring_t;
+
+/*
+*--------------------------------------------------------------------------------------
+*- Private Data
+*--------------------------------------------------------------------------------------
+**/
+
+#if (TRACING_FLAG == TRACING_ACTIVE)
+uint8_t traceEnabled = 0x00u;
+
+static st_rsa_trace_ring_t traceRings[RSA_TRACE_MAX_THREADS];
+/** @brief Set while the ring is owned by a live thread, guarded by traceLock */
+static uint8_t traceRingsOwned[RSA_TRACE_MAX_THREADS];
+/** @brief Rings no live thread owns, read without the lock to skip a hopeless claim */
+static uint32_t traceRingsFree = RSA_TRACE_MAX_THREADS;
+/** @brief Threads that recorded so far, numbers the records of every thread */
+static uint32_t traceThreadsSeen = 0x00u;
+static pthread_mutex_t traceLock = PTHREAD_MUTEX_INITIALIZER;
+/** @brief Releases the ring of an exiting thread */
+static pthread_key_t traceKey;
+static pthread_once_t traceKeyOnce = PTHREAD_ONCE_INIT;
+/** @brief Ring of the calling thread, NULL until it records */
+static __thread st_rsa_trace_ring_t *traceRing = NULL;
+/** @brief Serial number of the calling thread plus one, 0 until it records */
+static __thread uint32_t traceThread = 0x00u;
+#endif
+
+static const char * const traceEventNames[traceEventCount] =
+{
+	"none",
+	"prime-test",
+	"prime-test-64",
+	"prime-found",
+	"gcd",
+	"encrypt-letter",
+	"encrypt",
+	"block-encrypt",
+	"block-decrypt",
+	"pipe-chunk",
+	"pool-take",
+	"job-done"
+};
+
+/*
+*--------------------------------------------------------------------------------------
+*- Private Functions Implementation
+*--------------------------------------------------------------------------------------
+**/
+
+#if (TRACING_FLAG == TRACING_ACTIVE)
+/**
+ * @brief Thread specific key destructor, frees the ring of the exiting
+ * 			  thread for the next one.
+ */
+static void
+traceReleaseRing(void *pArg)
+{
+	/* Function data types */
+	const st_rsa_trace_ring_t * const pRing = (const st_rsa_trace_ring_t *) pArg;
+
+	/* Function body */
+	pthread_mutex_lock(&traceLock);
+	traceRingsOwned[pRing - traceRings] = 0x00u;
+	__atomic_store_n(&traceRingsFree, traceRingsFree + 0x01u, __ATOMIC_RELAXED);
+	pthread_mutex_unlock(&traceLock);
+
+	/* A record from a later destructor claims a ring again */
+	traceRing = NULL;
+}/* traceReleaseRing */
+
+static void
+traceCreateKey(void)
+{
+	(void) pthread_key_create(&traceKey, traceReleaseRing);
+}/* traceCreateKey */
+
+/**
+ * @brief Hands the calling thread a free ring, NULL while
+ * 			  RSA_TRACE_MAX_THREADS other threads hold theirs.
+ */
+static st_rsa_trace_ring_t *
+traceClaimRing(void)
+{
+	/* Function data types */
+	uint32_t register i = 0x00u;
+
+	/* Function body */
+	if( (0x00u == __atomic_load_n(&traceRingsFree, __ATOMIC_RELAXED)) )
+	{ return NULL; }
+	else;
+
+	(void) pthread_once(&traceKeyOnce, traceCreateKey);
+
+	pthread_mutex_lock(&traceLock);
+	for(i = 0x00u; i < RSA_TRACE_MAX_THREADS; ++i)
+	{
+		if( (0x00u == traceRingsOwned[i]) )
+		{
+			traceRingsOwned[i] = 0x01u;
+			__atomic_store_n(&traceRingsFree, traceRingsFree - 0x01u, __ATOMIC_RELAXED);
+			traceRing = &traceRings[i];
+			break;
+		}
+		else;
+	}
+	pthread_mutex_unlock(&traceLock);
+
+	if( (NULL != traceRing) )
+	{ (void) pthread_setspecific(traceKey, traceRing); }
+	else;
+
+	return traceRing;
+}/* traceClaimRing */
+
+/**
+ * @brief Appends a record to the ring of the calling thread, threads finding
+ * 			  no free ring are not traced.
+ */
+void
+traceRecord(const en_rsa_trace_event_t event, const uint64_t argA, const uint64_t argB)
+{
+	/* Function data types */
+	st_rsa_trace_ring_t *pRing = NULL;
+	st_rsa_trace_record_t *pRecord = NULL;
+	struct timespec now;
+	uint64_t head = 0x00u;
+
+	/* Function body */
+	if( (0x00u == traceThread) )
+	{ traceThread = __atomic_fetch_add(&traceThreadsSeen, 0x01u, __ATOMIC_RELAXED) + 0x01u; }
+	else;
+
+	pRing = (NULL != traceRing) ? (traceRing) : (traceClaimRing());
+	if( (NULL == pRing) )
+	{ return; }
+	else;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+
+	head = __atomic_load_n(&pRing->head, __ATOMIC_RELAXED);
+	pRecord = &pRing->records[head & RSA_TRACE_RING_MASK];
+
+	pRecord->time = ((uint64_t) now.tv_sec * 1000000000ull) + (uint64_t) now.tv_nsec;
+	pRecord->argA = argA;
+	pRecord->argB = argB;
+	pRecord->event = (uint32_t) event;
+	pRecord->thread = traceThread - 0x01u;
+
+	__atomic_store_n(&pRing->head, head + 0x01u, __ATOMIC_RELEASE);
+}/* traceRecord */
+#endif
+
+static int
+compareRecords(const void *pA, const void *pB)
+{
+	/* Function data types */
+	const st_rsa_trace_record_t * const pRecordA = (const st_rsa_trace_record_t *) pA;
+	const st_rsa_trace_record_t * const pRecordB = (const st_rsa_trace_record_t *) pB;
+
+	/* Function body */
+	if( (pRecordA->time != pRecordB->time) )
+	{ return (pRecordA->time < pRecordB->time) ? (-1) : (1); }
+	else
+	{ return (int) pRecordA->thread - (int) pRecordB->thread; }
+}/* compareRecords */
+
+/*
+*--------------------------------------------------------------------------------------
+*- Public Functions Implementation
+*--------------------------------------------------------------------------------------
+**/
+
+/**
+ * @brief Turns the recording on or off for every thread, has no effect when
+ * 			  the tracing isn't compiled in.
+ */
+void
+rsa_trace_enable(const uint8_t enable)
+{
+#if (TRACING_FLAG == TRACING_ACTIVE)
+	__atomic_store_n(&traceEnabled, (enable) ? (0x01u) : (0x00u), __ATOMIC_RELAXED);
+#else
+	(void) enable;
+#endif
+}/* rsa_trace_enable */
+
+/**
+ * @brief Writes the records still held by every ring to pPath.
+ */
+en_rsa_status_t
+rsa_trace_save(const char * const pPath)
+{
+	/* Function data types */
+	FILE *pFile = NULL;
+	uint8_t failed = 0x00u;
+#if (TRACING_FLAG == TRACING_ACTIVE)
+	uint64_t head = 0x00u;
+	uint64_t first = 0x00u;
+	uint64_t register j = 0x00u;
+	uint32_t register i = 0x00u;
+#endif
+
+	/* Validating */
+	if( (NULL == pPath) )
+	{ return rsaStatusNullArgument; }
+	else;
+
+	/* Function body */
+	pFile = fopen(pPath, "wb");
+	if( (NULL == pFile) )
+	{ return rsaStatusIoError; }
+	else;
+
+	failed = (RSA_TRACE_FILE_MAGIC_BYTES != fwrite(RSA_TRACE_FILE_MAGIC, 0x01u, RSA_TRACE_FILE_MAGIC_BYTES, pFile));
+
+#if (TRACING_FLAG == TRACING_ACTIVE)
+	for(i = 0x00u; (0x00u == failed) && (i < RSA_TRACE_MAX_THREADS); ++i)
+	{
+		head = __atomic_load_n(&traceRings[i].head, __ATOMIC_ACQUIRE);
+		first = (head > RSA_TRACE_RING_EVENTS) ? (head - RSA_TRACE_RING_EVENTS) : (0x00u);
+
+		for(j = first; (0x00u == failed) && (j < head); ++j)
+		{
+			failed = (0x01u != fwrite(&traceRings[i].records[j & RSA_TRACE_RING_MASK],
+			                          sizeof(st_rsa_trace_record_t), 0x01u, pFile));
+		}
+	}
+#endif
+
+	if( (0x00 != fclose(pFile)) || (failed) )
+	{ return rsaStatusIoError; }
+	else;
+
+	return rsaStatusOk;
+}/* rsa_trace_save */
+
+/**
+ * @brief Offline dumper, prints the records of a file written by
+ * 			  rsa_trace_save() to stdout in time order.
+ */
+en_rsa_status_t
+rsa_trace_dump(const char * const pPath)
+{
+	/* Function data types */
+	char magic[RSA_TRACE_FILE_MAGIC_BYTES];
+	st_rsa_trace_record_t *pRecords = NULL;
+	FILE *pFile = NULL;
+	long fileLen = 0x00;
+	size_t numOfRecords = 0x00u;
+	size_t register i = 0x00u;
+
+	/* Validating */
+	if( (NULL == pPath) )
+	{ return rsaStatusNullArgument; }
+	else;
+
+	/* Function body */
+	pFile = fopen(pPath, "rb");
+	if( (NULL == pFile) )
+	{ return rsaStatusIoError; }
+	else;
+
+	if( (0x00 != fseek(pFile, 0x00, SEEK_END)) || ((fileLen = ftell(pFile)) < RSA_TRACE_FILE_MAGIC_BYTES) ||
+	    (0x00 != fseek(pFile, 0x00, SEEK_SET)) ||
+	    (RSA_TRACE_FILE_MAGIC_BYTES != fread(magic, 0x01u, RSA_TRACE_FILE_MAGIC_BYTES, pFile)) ||
+	    (0x00 != memcmp(magic, RSA_TRACE_FILE_MAGIC, RSA_TRACE_FILE_MAGIC_BYTES)) )
+	{
+		fclose(pFile);
+		return rsaStatusIoError;
+	}
+	else;
+
+	numOfRecords = ((size_t) fileLen - RSA_TRACE_FILE_MAGIC_BYTES) / sizeof(st_rsa_trace_record_t);
+	pRecords = (st_rsa_trace_record_t *) malloc((numOfRecords > 0x00u) ? (numOfRecords * sizeof(st_rsa_trace_record_t)) : (0x01u));
+	if( (NULL == pRecords) || (numOfRecords != fread(pRecords, sizeof(st_rsa_trace_record_t), numOfRecords, pFile)) )
+	{
+		free(pRecords);
+		fclose(pFile);
+		return (NULL == pRecords) ? (rsaStatusNoMemory) : (rsaStatusIoError);
+	}
+	else;
+	fclose(pFile);
+
+	qsort(pRecords, numOfRecords, sizeof(st_rsa_trace_record_t), compareRecords);
+
+	printf("%-14s %-6s %-16s %-20s %s\n", "time_us", "thread", "event", "arg_a", "arg_b");
+	for(i = 0x00u; i < numOfRecords; ++i)
+	{
+		printf("%14.3f %-6u %-16s %-20llu %llu\n",
+		       (double) (pRecords[i].time - pRecords[0].time) / 1000.0, pRecords[i].thread,
+		       (pRecords[i].event < traceEventCount) ? (traceEventNames[pRecords[i].event]) : ("unknown"),
+		       (unsigned long long) pRecords[i].argA, (unsigned long long) pRecords[i].argB);
+	}
+
+	free(pRecords);
+
+	return rsaStatusOk;
+}/* rsa_trace_dump */